@@ -10,3 +10,7 @@ void bimodal::last_branch_result(champsim::address ip, champsim::address branch_
 {
   bimodal_table[hash(ip)] += taken ? 1 : -1;
 }
+
+void bimodal::save_checkpoint(champsim::checkpoint_writer& writer) const { writer.write(bimodal_table); }
+
+void bimodal::load_checkpoint(champsim::checkpoint_reader& reader) { reader.read(bimodal_table); }
@@ -23,6 +23,9 @@ public:
   // void initialize_branch_predictor();
   bool predict_branch(champsim::address ip);
   void last_branch_result(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type);
+
+  void save_checkpoint(champsim::checkpoint_writer& writer) const;
+  void load_checkpoint(champsim::checkpoint_reader& reader);
 };
 
 #endif
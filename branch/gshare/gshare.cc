@@ -29,3 +29,15 @@ void gshare::last_branch_result(champsim::address ip, champsim::address branch_t
   branch_history_vector <<= 1;
   branch_history_vector[0] = taken;
 }
+
+void gshare::save_checkpoint(champsim::checkpoint_writer& writer) const
+{
+  writer.write(branch_history_vector);
+  writer.write(gs_history_table);
+}
+
+void gshare::load_checkpoint(champsim::checkpoint_reader& reader)
+{
+  reader.read(branch_history_vector);
+  reader.read(gs_history_table);
+}
@@ -86,3 +86,19 @@ void perceptron::last_branch_result(champsim::address ip, champsim::address bran
     perceptrons[index].update(taken, history);
   }
 }
+
+void perceptron::save_checkpoint(champsim::checkpoint_writer& writer) const
+{
+  writer.write(perceptrons);
+  writer.write(perceptron_state_buf);
+  writer.write(spec_global_history);
+  writer.write(global_history);
+}
+
+void perceptron::load_checkpoint(champsim::checkpoint_reader& reader)
+{
+  reader.read(perceptrons);
+  reader.read(perceptron_state_buf);
+  reader.read(spec_global_history);
+  reader.read(global_history);
+}
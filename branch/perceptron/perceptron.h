@@ -49,6 +49,9 @@ struct perceptron : champsim::modules::branch_predictor {
 
   bool predict_branch(champsim::address ip);
   void last_branch_result(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type);
+
+  void save_checkpoint(champsim::checkpoint_writer& writer) const;
+  void load_checkpoint(champsim::checkpoint_reader& reader);
 };
 
 template <std::size_t HISTLEN, std::size_t BITS>
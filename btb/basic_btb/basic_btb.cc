@@ -46,3 +46,21 @@ void basic_btb::update_btb(champsim::address ip, champsim::address branch_target
 
   direct.update(ip, branch_target, branch_type);
 }
+
+void basic_btb::save_checkpoint(champsim::checkpoint_writer& writer) const
+{
+  writer.write(ras.stack);
+  writer.write(ras.call_size_trackers);
+  writer.write(indirect.predictor);
+  writer.write(indirect.conditional_history);
+  writer.write(direct.BTB);
+}
+
+void basic_btb::load_checkpoint(champsim::checkpoint_reader& reader)
+{
+  reader.read(ras.stack);
+  reader.read(ras.call_size_trackers);
+  reader.read(indirect.predictor);
+  reader.read(indirect.conditional_history);
+  reader.read(direct.BTB);
+}
@@ -20,6 +20,9 @@ public:
   // void initialize_btb();
   std::pair<champsim::address, bool> btb_prediction(champsim::address ip);
   void update_btb(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type);
+
+  void save_checkpoint(champsim::checkpoint_writer& writer) const;
+  void load_checkpoint(champsim::checkpoint_reader& reader);
 };
 
 #endif
@@ -54,6 +54,8 @@ if __name__ == '__main__':
             help='A directory to search for prefetchers')
     search_group.add_argument('--replacement-dir', action='append', default=[], metavar='DIR',
             help='A directory to search for replacement policies')
+    search_group.add_argument('--dram-scheduler-dir', action='append', default=[], metavar='DIR',
+            help='A directory to search for DRAM schedulers')
 
     parser.add_argument('--no-compile-all-modules', action='store_false', dest='compile_all_modules',
             help='Do not compile all modules in the search path')
@@ -90,6 +92,7 @@ if __name__ == '__main__':
         'btb_dir': args.btb_dir,
         'pref_dir': args.prefetcher_dir,
         'repl_dir': args.replacement_dir,
+        'dram_scheduler_dir': args.dram_scheduler_dir,
         'compile_all_modules': args.compile_all_modules,
         'verbose': args.verbose
     }
@@ -23,6 +23,7 @@ import pathlib
 from .makefile import get_makefile_lines
 from .instantiation_file import get_instantiation_lines
 from .instantiation_file import get_instantiation_header
+from .instantiation_file import get_memory_nodes
 from . import util
 
 warning_text = (
@@ -164,7 +165,7 @@ class Fragment:
 
         fileparts = [
             # Instantiation file
-            (os.path.join(objdir_name, 'core_inst.inc'), cxx_file(get_instantiation_header(len(elements['cores']), config_file, build_id=build_id))),
+            (os.path.join(objdir_name, 'core_inst.inc'), cxx_file(get_instantiation_header(len(elements['cores']), config_file, build_id=build_id, dram_names=[n['name'] for n in get_memory_nodes(elements['pmem'], elements['far_pmem'])]))),
             (os.path.join(objdir_name, 'core_inst.cc.inc'), cxx_file(get_instantiation_lines(build_id=build_id, **elements))),
 
             # Makefile generation
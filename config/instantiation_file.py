@@ -22,7 +22,7 @@ import multiprocessing as mp
 from . import util
 from . import cxx
 
-pmem_fmtstr = 'champsim::chrono::picoseconds{{{clock_period_dbus}}}, champsim::chrono::picoseconds{{{clock_period_mc}}}, std::size_t{{{_tRP}}}, std::size_t{{{_tRCD}}}, std::size_t{{{_tCAS}}}, std::size_t{{{_tRAS}}}, champsim::chrono::microseconds{{{_refresh_period}}}, {{{_ulptr}}}, {rq_size}, {wq_size}, {channels}, champsim::data::bytes{{{channel_width}}}, {_bank_rows}, {_bank_columns}, {ranks}, {bankgroups}, {banks}, {_refreshes_per_period}'
+pmem_fmtstr = 'champsim::chrono::picoseconds{{{clock_period_dbus}}}, champsim::chrono::picoseconds{{{clock_period_mc}}}, std::size_t{{{_tRP}}}, std::size_t{{{_tRCD}}}, std::size_t{{{_tCAS}}}, std::size_t{{{_tRAS}}}, champsim::chrono::microseconds{{{_refresh_period}}}, {{{_ulptr}}}, {rq_size}, {wq_size}, {channels}, champsim::data::bytes{{{channel_width}}}, {_bank_rows}, {_bank_columns}, {ranks}, {bankgroups}, {banks}, {_refreshes_per_period}, dram_power_parameters{{{VDD}, {IDD0}, {IDD2N}, {IDD3N}, {IDD4R}, {IDD4W}, {IDD5B}, {device_width}}}, dram_page_policy{{dram_page_policy::mode::{_page_policy}, {page_timeout}}}, dram_address_layout{{{{{_address_order}}}, {_address_swizzle}}}, dram_node{{"{_node_label}", champsim::address{{{_node_base}ull}}, champsim::address{{{_node_last}ull}}, {_node_index}, {_node_count}, {extra_latency}}}, dram_refresh_policy{{dram_refresh_policy::mode::{_refresh_mode}, {refresh_max_postponed}, {refresh_max_pulled_in}, {_tRFCpb}}}, champsim::dram_scheduler_module_type_holder<{_scheduler_classes}>{{}}'
 vmem_fmtstr = 'champsim::data::bytes{{{pte_page_size}}}, {num_levels}, champsim::chrono::picoseconds{{{clock_period}*{minor_fault_penalty}}}, {dram_name}, {_randomization}'
 
 queue_fmtstr = '{rq_size}, {pq_size}, {wq_size}, champsim::data::bits{{{_offset_bits}}}, {_queue_check_full_addr:b}'
@@ -53,6 +53,7 @@ core_builder_parts = {
     'dib_window': '  .dib_window({dib_window})',
     'dib_inorder_width': '  .dib_inorder_width(champsim::bandwidth::maximum_type{{{inorder_width}}})',
     'dib_hit_buffer_size': '  .dib_hit_buffer_size({DIB[inorder_width]})',
+    'ftq_size': '.ftq_size({ftq_size})',
     'L1I': ['.l1i(&{^l1i_ptr})', '.l1i_bandwidth({^l1i_ptr}.MAX_TAG)', '.fetch_queues(&{^fetch_queues})'],
     'L1D': ['.l1d_bandwidth({^l1d_ptr}.MAX_TAG)', '.data_queues(&{^data_queues})'],
     '_branch_predictor_data': '.branch_predictor<{^branch_predictor_string}>()',
@@ -109,6 +110,72 @@ def vector_string(iterable):
         return hoisted[0]
     return '{'+', '.join(hoisted)+'}'
 
+def dram_address_order(mapping, interleave='striped'):
+    '''
+    Produce the fields of a DRAM address layout, from the least significant to the most significant.
+    The mapping lists the fields from the most significant, either as a list or separated by colons.
+    If the mapping does not place the controller, it is placed just above the channel for striped interleaving, or above every other field otherwise.
+    '''
+    fields = ('channel', 'bankgroup', 'bank', 'column', 'rank', 'row')
+    order = mapping.split(':') if isinstance(mapping, str) else list(mapping)
+    if 'controller' not in order and 'channel' in order:
+        order.insert(order.index('channel') if interleave == 'striped' else 0, 'controller')
+    if sorted(order) != sorted((*fields, 'controller')):
+        raise ValueError(f'DRAM address mapping "{mapping}" must name each of {", ".join(fields)} exactly once')
+    return ', '.join(f'dram_address_layout::field::{f}' for f in reversed(order))
+
+def dram_size(pmem):
+    ''' The capacity of one memory controller, in bytes '''
+    columns = pmem['columns']*8 if 'columns' in pmem else pmem['bank_columns']
+    return int(pmem['channels'] * pmem['ranks'] * pmem['bankgroups'] * pmem['banks'] * pmem['bank_rows'] * columns * pmem['channel_width'])
+
+def get_memory_nodes(pmem, far_pmem=None):
+    '''
+    Produce one element for each memory controller.
+    The controllers of the physical memory share the lowest range of physical addresses, and those of the far memory, if any, share the next.
+    Each range is aligned to its size, so that the controllers can decode their addresses without removing the base.
+    '''
+    tiers = [pmem, *((far_pmem,) if far_pmem is not None else ())]
+    for tier in tiers:
+        if tier['controllers'] < 1 or (tier['controllers'] & (tier['controllers'] - 1)) != 0:
+            raise ValueError(f'The number of controllers of {tier["name"]} must be a power of two')
+        if tier['interleave'] not in ('striped', 'node'):
+            raise ValueError(f'The interleaving of {tier["name"]} must be one of striped or node')
+
+    bases = []
+    end = 0
+    for tier in tiers:
+        span = dram_size(tier) * tier['controllers']
+        bases.append(-(-end // span) * span)
+        end = bases[-1] + span
+    lasts = [b - 1 for b in bases[1:]] + [(1 << 64) - 1]
+
+    nodes = []
+    for tier, base, last in zip(tiers, bases, lasts):
+        count = int(tier['controllers'])
+        for i in range(count):
+            nodes.append({
+                **tier,
+                'name': tier['name'] if i == 0 else f'{tier["name"]}_{i}',
+                '_node_index': i,
+                '_node_count': count,
+                '_node_base': base,
+                '_node_last': last
+            })
+    return nodes
+
+def dram_page_policy(policy):
+    ''' Check that a DRAM page policy is one the controller knows '''
+    if policy not in ('open', 'close', 'adaptive'):
+        raise ValueError(f'DRAM page policy "{policy}" must be one of open, close, or adaptive')
+    return policy
+
+def dram_refresh_mode(mode):
+    ''' Check that a DRAM refresh mode is one the controller knows '''
+    if mode not in ('all_bank', 'per_bank', 'same_bank'):
+        raise ValueError(f'DRAM refresh mode "{mode}" must be one of all_bank, per_bank, or same_bank')
+    return mode
+
 def get_cpu_builder(cpu, caches, ul_pairs):
     '''
     Generate a champsim::core_builder
@@ -134,10 +201,23 @@ def get_cpu_builder(cpu, caches, ul_pairs):
         ('champsim::core_builder{{ champsim::defaults::default_core }}',),
         required_parts,
         *(util.wrap_list(v) for k,v in core_builder_parts.items() if k in cpu),
-        (v for k,v in dib_builder_parts.items() if k in cpu.get('DIB',{}))
+        (v for k,v in dib_builder_parts.items() if k in cpu.get('DIB',{})),
+        functional_unit_parts(cpu.get('functional_units',{}))
     ), indent=1, line_end=''))
     yield from (part.format(**cpu, **local_params) for part in builder_parts)
 
+def functional_unit_parts(units):
+    '''
+    Generate the per-class latencies and functional units of a core
+
+    :param units: a dictionary from op class names to their latency, count, and whether they are pipelined
+    '''
+    for op_class, unit in units.items():
+        if 'latency' in unit:
+            yield f'.execute_latency(champsim::op_class::{op_class}, {unit["latency"]})'
+        if 'count' in unit:
+            yield f'.functional_units(champsim::op_class::{op_class}, {unit["count"]}, {str(unit.get("pipelined", True)).lower()})'
+
 def get_cache_builder(elem, ul_pairs):
     '''
     Generate a champsim::cache_builder
@@ -316,7 +396,7 @@ def decorate_queues(caches, ptws, pmem):
 def get_queue_info(ul_pairs, decoration):
     return [decoration.get(ll) for ll,_ in ul_pairs]
 
-def get_instantiation_lines(cores, caches, ptws, pmem, vmem, build_id):
+def get_instantiation_lines(cores, caches, ptws, pmem, vmem, build_id, far_pmem=None):
     '''
     Generate the lines for a C++ file that instantiates a configuration.
     '''
@@ -328,38 +408,49 @@ def get_instantiation_lines(cores, caches, ptws, pmem, vmem, build_id):
         *(c['_branch_predictor_data'] for c in cores),
         *(c['_btb_data'] for c in cores),
         *(c['_prefetcher_data'] for c in caches),
-        *(c['_replacement_data'] for c in caches)
+        *(c['_replacement_data'] for c in caches),
+        pmem['_dram_scheduler_data'],
+        *((far_pmem['_dram_scheduler_data'],) if far_pmem is not None else ())
     ))
     yield from module_include_files(datas)
 
+    nodes = get_memory_nodes(pmem, far_pmem)
+
     # Get fastest clock period in picoseconds
-    global_clock_period = int(1000000/max(x['frequency'] for x in itertools.chain(cores, caches, ptws, (pmem,))))
+    global_clock_period = int(1000000/max(x['frequency'] for x in itertools.chain(cores, caches, ptws, nodes)))
 
     channels_head, channels_tail = util.cut((f'champsim::channel{{{queue_fmtstr.format(**v)}}}' for v in queues), n=-1)
     channel_instantiation_body = ('channels{', *(v+',' for v in channels_head), *channels_tail, '},')
 
-    pmem_instantiation_body = (
-        'DRAM{',
+    pmem_instantiation_body = itertools.chain.from_iterable((
+        f'{node["name"]}{{',
         pmem_fmtstr.format(
-            clock_period_dbus=int(1000000/pmem['data_rate']),
-            clock_period_mc=int(1000000/pmem['frequency']),
-            _tRP=int(pmem['tRP']),
-            _tRCD=int(pmem['tRCD']),
-            _tCAS=int(pmem['tCAS']),
-            _tRAS=int(pmem['tRAS']),
-            _bank_rows=int(pmem['bank_rows']), #added for supporting old configs, mainly column size change
-            _bank_columns=int(pmem['columns']*8 if 'columns' in pmem else pmem['bank_columns']),
-            _refresh_period=int(1000*pmem['refresh_period']),
-            _refreshes_per_period=int(pmem['refreshes_per_period']),
+            clock_period_dbus=int(1000000/node['data_rate']),
+            clock_period_mc=int(1000000/node['frequency']),
+            _tRP=int(node['tRP']),
+            _tRCD=int(node['tRCD']),
+            _tCAS=int(node['tCAS']),
+            _tRAS=int(node['tRAS']),
+            _tRFCpb=int(node['tRFCpb']),
+            _bank_rows=int(node['bank_rows']), #added for supporting old configs, mainly column size change
+            _bank_columns=int(node['columns']*8 if 'columns' in node else node['bank_columns']),
+            _refresh_period=int(1000*node['refresh_period']),
+            _refreshes_per_period=int(node['refreshes_per_period']),
+            _scheduler_classes=', '.join(m['class'] for m in node['_dram_scheduler_data']),
+            _address_order=dram_address_order(node['address_mapping'], node['interleave']),
+            _page_policy=dram_page_policy(node['page_policy']),
+            _refresh_mode=dram_refresh_mode(node['refresh_mode']),
+            _address_swizzle=str(bool(node['address_swizzle'])).lower(),
             _ulptr=vector_string(f'&channels.at({ul_pairs.index(v)})' for v in ul_pairs if v[0] == pmem['name']),
-            **pmem),
+            _node_label=node['name'] if len(nodes) > 1 else '',
+            **node),
         '},'
-    )
+    ) for node in nodes)
 
     vmem_instantiation_body = (
         'vmem{',
         vmem_fmtstr.format(
-            dram_name=pmem['name'], 
+            dram_name=nodes[0]['name'] if len(nodes) == 1 else f'std::vector<std::reference_wrapper<MEMORY_CONTROLLER>>{{{", ".join(n["name"] for n in nodes)}}}',
             clock_period=global_clock_period,
             _randomization= '{}' if (isinstance(vmem['randomization'],bool) and vmem['randomization'] == False) else int(vmem['randomization']),
             **vmem),
@@ -413,15 +504,15 @@ def get_instantiation_lines(cores, caches, ptws, pmem, vmem, build_id):
         'std::transform(std::begin(cores), std::end(cores), std::back_inserter(retval), make_ref);',
         'std::transform(std::begin(caches), std::end(caches), std::back_inserter(retval), make_ref);',
         'std::transform(std::begin(ptws), std::end(ptws), std::back_inserter(retval), make_ref);',
-        'retval.push_back(std::ref<champsim::operable>(DRAM));',
+        *(f'retval.push_back(std::ref<champsim::operable>({n["name"]}));' for n in nodes),
         'return retval;'
     ), rtype='std::vector<std::reference_wrapper<champsim::operable>>')
     yield ''
 
-    yield from cxx.function(f'{classname}::dram_view', [f'return {pmem["name"]};'], rtype='MEMORY_CONTROLLER&')
+    yield from cxx.function(f'{classname}::dram_view', [f'return {{{", ".join(n["name"] for n in nodes)}}};'], rtype='std::vector<std::reference_wrapper<MEMORY_CONTROLLER>>')
     yield ''
 
-def get_instantiation_header(num_cpus, env, build_id):
+def get_instantiation_header(num_cpus, env, build_id, dram_names=('DRAM',)):
     yield '#include "environment.h"'
     yield '#include "vmem.h"'
     yield '#include <vector>'
@@ -429,7 +520,7 @@ def get_instantiation_header(num_cpus, env, build_id):
     struct_body = (
         'private:',
         'std::vector<champsim::channel> channels;',
-        'MEMORY_CONTROLLER DRAM;',
+        *(f'MEMORY_CONTROLLER {name};' for name in dram_names),
         'VirtualMemory vmem;',
         'std::vector<PageTableWalker> ptws;',
         'std::vector<CACHE> caches;',
@@ -444,7 +535,7 @@ def get_instantiation_header(num_cpus, env, build_id):
         'std::vector<std::reference_wrapper<O3_CPU>> cpu_view() final;',
         'std::vector<std::reference_wrapper<CACHE>> cache_view() final;',
         'std::vector<std::reference_wrapper<PageTableWalker>> ptw_view() final;',
-        'MEMORY_CONTROLLER& dram_view() final;',
+        'std::vector<std::reference_wrapper<MEMORY_CONTROLLER>> dram_view() final;',
         'std::vector<std::reference_wrapper<operable>> operable_view() final;'
     )
     struct_name = f'champsim::configured::generated_environment<0x{build_id}> final'
@@ -234,7 +234,7 @@ class NormalizedConfiguration:
                 'frequency', 'ifetch_buffer_size', 'decode_buffer_size', 'dispatch_buffer_size', 'register_file_size', 'rob_size', 'lq_size',
                 'sq_size', 'fetch_width', 'decode_width', 'dispatch_width', 'execute_width', 'lq_width', 'sq_width',
                 'retire_width', 'mispredict_penalty', 'scheduler_size', 'decode_latency', 'dispatch_latency',
-                'schedule_latency', 'execute_latency', 'branch_predictor', 'btb', 'DIB'
+                'schedule_latency', 'execute_latency', 'functional_units', 'ftq_size', 'branch_predictor', 'btb', 'DIB'
             )
         )
         self.cores = [util.chain(cpu, core_from_config, {'name': f'cpu{i}'}) for i,cpu in enumerate(self.cores)]
@@ -276,16 +276,19 @@ class NormalizedConfiguration:
         self.caches = {k:v for k,v in self.caches.items() if k != 'DRAM'}
 
         self.pmem = config_file.get('physical_memory', {})
-        
+        self.far_pmem = config_file.get('far_memory', {})
+
         #this allows frequency to be specified instead of data rate or vice-versa for DRAM
-        if('frequency' in self.pmem.keys()):
-            self.pmem['data_rate'] = self.pmem['frequency']
-            self.pmem['frequency'] = self.pmem['frequency']/2
-        elif('data_rate' in self.pmem.keys()):
-            self.pmem['frequency'] = self.pmem['data_rate']/2
+        for mem in (self.pmem, self.far_pmem):
+            if('frequency' in mem.keys()):
+                mem['data_rate'] = mem['frequency']
+                mem['frequency'] = mem['frequency']/2
+            elif('data_rate' in mem.keys()):
+                mem['frequency'] = mem['data_rate']/2
 
         if verbose:
             print('P: pmem', list(self.pmem.keys()))
+            print('P: far pmem', list(self.far_pmem.keys()))
 
         self.vmem = config_file.get('virtual_memory', {})
 
@@ -302,10 +305,11 @@ class NormalizedConfiguration:
         self.caches = util.chain(self.caches, rhs.caches)
         self.ptws = util.chain(self.ptws, rhs.ptws)
         self.pmem = util.chain(self.pmem, rhs.pmem)
+        self.far_pmem = util.chain(self.far_pmem, rhs.far_pmem)
         self.vmem = util.chain(self.vmem, rhs.vmem)
         self.root = util.chain(self.root, rhs.root)
 
-    def apply_defaults_in(self, branch_context, btb_context, prefetcher_context, replacement_context, verbose=False):
+    def apply_defaults_in(self, branch_context, btb_context, prefetcher_context, replacement_context, dram_scheduler_context, verbose=False):
         ''' Apply defaults and produce a result suitible for writing the generated files. '''
         if verbose:
             print('D: keys in root', list(self.root.keys()))
@@ -331,9 +335,19 @@ class NormalizedConfiguration:
         pmem = util.chain(self.pmem, {
             'name': 'DRAM', 'data_rate': 3200, 'frequency': 1600, 'channels': 1, 'ranks': 1, 'bankgroups': 8, 'banks': 4, 'bank_rows': 65536, 'bank_columns': 1024,
             'channel_width': 8, 'wq_size': 64, 'rq_size': 64, 'tRP': 24, 'tRCD': 24, 'tCAS': 24, 'tRAS' : 52,
-            'refresh_period': 32, 'refreshes_per_period': 8192
+            'refresh_period': 32, 'refreshes_per_period': 8192,
+            'VDD': 1.2, 'IDD0': 57, 'IDD2N': 37, 'IDD3N': 52, 'IDD4R': 168, 'IDD4W': 150, 'IDD5B': 250, 'device_width': 8,
+            'page_policy': 'open', 'page_timeout': 64, 'address_mapping': 'row:rank:column:bank:bankgroup:channel', 'address_swizzle': True,
+            'controllers': 1, 'interleave': 'striped', 'extra_latency': 0,
+            'refresh_mode': 'all_bank', 'refresh_max_postponed': 0, 'refresh_max_pulled_in': 0, 'tRFCpb': 0
         })
         pmem = util.chain(pmem,(do_deprecation(pmem, pmem_deprecation_keys,pmem_deprecation_warnings)))
+
+        # A far memory tier takes any parameters it does not give from the physical memory
+        far_pmem = None
+        if self.far_pmem:
+            far_pmem = util.chain(self.far_pmem, { 'name': 'FAR_DRAM', 'controllers': 1 }, pmem)
+            far_pmem = util.chain(far_pmem,(do_deprecation(far_pmem, pmem_deprecation_keys,pmem_deprecation_warnings)))
         
         #convert vmem boolean to string
         vmem = util.chain(
@@ -360,6 +374,7 @@ class NormalizedConfiguration:
         branch_parse = functools.partial(module_parse, context=branch_context)
         btb_parse = functools.partial(module_parse, context=btb_context)
         replacement_parse = functools.partial(module_parse, context=replacement_context)
+        dram_scheduler_parse = functools.partial(module_parse, context=dram_scheduler_context)
         def prefetcher_parse(mod_name, cache):
             return {
                 '_is_instruction_prefetcher': cache.get('_is_instruction_cache', False),
@@ -429,18 +444,29 @@ class NormalizedConfiguration:
             ).values()
         )
 
+        pmem = util.chain({
+            '_dram_scheduler_data': [*map(dram_scheduler_parse, util.wrap_list(pmem.get('scheduler', 'fr_fcfs')))]
+        }, pmem)
+        if far_pmem is not None:
+            far_pmem = util.chain({
+                '_dram_scheduler_data': [*map(dram_scheduler_parse, util.wrap_list(far_pmem.get('scheduler', 'fr_fcfs')))]
+            }, far_pmem)
+
         elements = {
             'cores': cores,
             'caches': tuple(caches.values()),
             'ptws': tuple(ptws.values()),
             'pmem': pmem,
+            'far_pmem': far_pmem,
             'vmem': vmem
         }
         module_info = {
             'repl': util.combine_named(*(c['_replacement_data'] for c in caches.values()), replacement_context.find_all()),
             'pref': util.combine_named(*(c['_prefetcher_data'] for c in caches.values()), prefetcher_context.find_all()),
             'branch': util.combine_named(*(c['_branch_predictor_data'] for c in cores), branch_context.find_all()),
-            'btb': util.combine_named(*(c['_btb_data'] for c in cores), btb_context.find_all())
+            'btb': util.combine_named(*(c['_btb_data'] for c in cores), btb_context.find_all()),
+            'dram_scheduler': util.combine_named(pmem['_dram_scheduler_data'], *((far_pmem['_dram_scheduler_data'],) if far_pmem is not None else ()),
+                                                 dram_scheduler_context.find_all())
         }
 
         config_extern = {
@@ -450,7 +476,7 @@ class NormalizedConfiguration:
 
         return elements, module_info, config_extern
 
-def parse_config(*configs, module_dir=None, branch_dir=None, btb_dir=None, pref_dir=None, repl_dir=None, compile_all_modules=False, verbose=False): # pylint: disable=line-too-long,
+def parse_config(*configs, module_dir=None, branch_dir=None, btb_dir=None, pref_dir=None, repl_dir=None, dram_scheduler_dir=None, compile_all_modules=False, verbose=False): # pylint: disable=line-too-long,
     '''
     This is the main parsing dispatch function. Programmatic use of the configuration system should use this as an entry point.
 
@@ -460,6 +486,7 @@ def parse_config(*configs, module_dir=None, branch_dir=None, btb_dir=None, pref_
     :param btb_dir: A directory to search for branch target predictors
     :param pref_dir: A directory to search for prefetchers
     :param repl_dir: A directory to search for replacement policies
+    :param dram_scheduler_dir: A directory to search for DRAM schedulers
     :param compile_all_modules: If true, all modules in the given directories will be compiled. If false, only the module in the configuration will be compiled.
     :param verbose: Print extra verbose output
     '''
@@ -479,7 +506,8 @@ def parse_config(*configs, module_dir=None, branch_dir=None, btb_dir=None, pref_
         branch_context = modules.ModuleSearchContext(list_dirs('branch', branch_dir or []), verbose=verbose),
         btb_context = modules.ModuleSearchContext(list_dirs('btb', btb_dir or []), verbose=verbose),
         replacement_context = modules.ModuleSearchContext(list_dirs('replacement', repl_dir or []), verbose=verbose),
-        prefetcher_context = modules.ModuleSearchContext(list_dirs('prefetcher', pref_dir or []), verbose=verbose)
+        prefetcher_context = modules.ModuleSearchContext(list_dirs('prefetcher', pref_dir or []), verbose=verbose),
+        dram_scheduler_context = modules.ModuleSearchContext(list_dirs('dram_scheduler', dram_scheduler_dir or []), verbose=verbose)
     )
     if verbose:
         for k,v in contexts.items():
@@ -493,7 +521,9 @@ def parse_config(*configs, module_dir=None, branch_dir=None, btb_dir=None, pref_
             *(c['_replacement_data'] for c in elements['caches']),
             *(c['_prefetcher_data'] for c in elements['caches']),
             *(c['_branch_predictor_data'] for c in elements['cores']),
-            *(c['_btb_data'] for c in elements['cores'])
+            *(c['_btb_data'] for c in elements['cores']),
+            elements['pmem']['_dram_scheduler_data'],
+            *((elements['far_pmem']['_dram_scheduler_data'],) if elements['far_pmem'] is not None else ())
         ))]
 
     return executable_name(*configs), elements, modules_to_compile, module_info, config_file
@@ -0,0 +1,74 @@
+#include "bliss.h"
+
+#include <optional>
+#include <tuple>
+#include <fmt/core.h>
+
+DRAM_CHANNEL::queue_type::iterator bliss::select_request()
+{
+  if (intern_->current_time >= next_clear) {
+    blacklist.clear();
+    next_clear = intern_->current_time + clearing_interval * intern_->clock_period;
+  }
+
+  auto& queue = intern_->write_mode ? intern_->WQ : intern_->RQ;
+
+  // Each free bank offers its oldest ready request and its oldest ready row hit. Rank these: not blacklisted, then row hit, then oldest
+  using rank_type = std::tuple<bool, bool, DRAM_CHANNEL::bucket_entry_type>;
+  auto better = [](const rank_type& lhs, const rank_type& rhs) {
+    if (std::get<0>(lhs) != std::get<0>(rhs)) {
+      return std::get<0>(lhs);
+    }
+    if (std::get<1>(lhs) != std::get<1>(rhs)) {
+      return std::get<1>(lhs);
+    }
+    return DRAM_CHANNEL::bucket_order{}(std::get<2>(lhs), std::get<2>(rhs));
+  };
+
+  std::optional<rank_type> next_schedule;
+  auto consider = [&](bool row_hit, const DRAM_CHANNEL::bucket_entry_type& entry) {
+    rank_type candidate{!is_blacklisted(queue.at(entry.second)->cpu), row_hit, entry};
+    if (!next_schedule.has_value() || better(candidate, *next_schedule)) {
+      next_schedule = candidate;
+    }
+  };
+
+  for (std::size_t i = 0; i < std::size(intern_->bank_request); ++i) {
+    const auto& bank = intern_->bank_request[i];
+    if (bank.valid || bank.under_refresh) {
+      continue;
+    }
+
+    auto oldest = intern_->oldest_ready_request(i);
+    auto hit = intern_->oldest_ready_row_hit(i);
+    if (oldest.has_value()) {
+      consider(hit == oldest, *oldest);
+    }
+    if (hit.has_value() && hit != oldest) {
+      consider(true, *hit);
+    }
+  }
+
+  if (!next_schedule.has_value()) {
+    return std::end(queue);
+  }
+  return std::next(std::begin(queue), static_cast<DRAM_CHANNEL::queue_type::difference_type>(std::get<2>(*next_schedule).second));
+}
+
+void bliss::request_scheduled(const DRAM_CHANNEL::request_type& req)
+{
+  if (req.cpu == last_cpu) {
+    ++streak;
+  } else {
+    last_cpu = req.cpu;
+    streak = 1;
+  }
+
+  if (streak >= blacklisting_threshold && blacklist.insert(req.cpu).second) {
+    ++blacklistings;
+  }
+}
+
+bool bliss::is_blacklisted(uint32_t cpu) const { return blacklist.count(cpu) > 0; }
+
+void bliss::dram_scheduler_final_stats() { fmt::print("BLISS blacklistings: {}\n", blacklistings); }
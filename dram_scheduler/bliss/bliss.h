@@ -0,0 +1,41 @@
+#ifndef DRAM_SCHEDULER_BLISS_H
+#define DRAM_SCHEDULER_BLISS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <set>
+
+#include "chrono.h"
+#include "dram_controller.h"
+#include "modules.h"
+
+/**
+ * The Blacklisting memory scheduler (Subramanian et al., ICCD 2014).
+ *
+ * A core whose requests are scheduled several times in a row is blacklisted until the blacklist is next cleared.
+ * Among the oldest ready request and the oldest ready row hit of each free bank, requests from cores that are not blacklisted
+ * come first, then row hits, then the oldest. The channel decides when to drain writes.
+ */
+class bliss : public champsim::modules::dram_scheduler
+{
+  uint32_t last_cpu = std::numeric_limits<uint32_t>::max();
+  std::size_t streak = 0;
+  std::set<uint32_t> blacklist{};
+  champsim::chrono::clock::time_point next_clear{};
+  uint64_t blacklistings = 0;
+
+public:
+  constexpr static std::size_t blacklisting_threshold = 4;
+  constexpr static long clearing_interval = 10000; // in cycles of the channel
+
+  using dram_scheduler::dram_scheduler;
+
+  DRAM_CHANNEL::queue_type::iterator select_request();
+  void request_scheduled(const DRAM_CHANNEL::request_type& req);
+  void dram_scheduler_final_stats();
+
+  [[nodiscard]] bool is_blacklisted(uint32_t cpu) const;
+};
+
+#endif
@@ -0,0 +1,36 @@
+#include "fr_fcfs.h"
+
+#include <optional>
+#include <utility>
+
+DRAM_CHANNEL::queue_type::iterator fr_fcfs::select_request()
+{
+  auto& queue = intern_->write_mode ? intern_->WQ : intern_->RQ;
+
+  // Each free bank offers its oldest ready row hit, or else its oldest ready request. Rank these: row hit, then oldest
+  std::optional<std::pair<bool, DRAM_CHANNEL::bucket_entry_type>> next_schedule;
+  for (std::size_t i = 0; i < std::size(intern_->bank_request); ++i) {
+    const auto& bank = intern_->bank_request[i];
+    if (bank.valid || bank.under_refresh) {
+      continue;
+    }
+
+    std::optional<std::pair<bool, DRAM_CHANNEL::bucket_entry_type>> candidate;
+    if (auto hit = intern_->oldest_ready_row_hit(i); hit.has_value()) {
+      candidate = std::pair{true, *hit};
+    } else if (auto oldest = intern_->oldest_ready_request(i); oldest.has_value()) {
+      candidate = std::pair{false, *oldest};
+    }
+
+    if (candidate.has_value()
+        && (!next_schedule.has_value() || (candidate->first && !next_schedule->first)
+            || (candidate->first == next_schedule->first && DRAM_CHANNEL::bucket_order{}(candidate->second, next_schedule->second)))) {
+      next_schedule = candidate;
+    }
+  }
+
+  if (!next_schedule.has_value()) {
+    return std::end(queue);
+  }
+  return std::next(std::begin(queue), static_cast<DRAM_CHANNEL::queue_type::difference_type>(next_schedule->second.second));
+}
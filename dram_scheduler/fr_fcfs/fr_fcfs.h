@@ -0,0 +1,23 @@
+#ifndef DRAM_SCHEDULER_FR_FCFS_H
+#define DRAM_SCHEDULER_FR_FCFS_H
+
+#include "dram_controller.h"
+#include "modules.h"
+
+/**
+ * First-ready, first-come-first-served.
+ *
+ * Among the ready requests to free banks, those that hit in the open row come first, then the oldest. The channel decides
+ * when to drain writes.
+ */
+struct fr_fcfs : public champsim::modules::dram_scheduler {
+  using dram_scheduler::dram_scheduler;
+
+  DRAM_CHANNEL::queue_type::iterator select_request();
+
+  // void initialize_dram_scheduler();
+  // void request_scheduled(const DRAM_CHANNEL::request_type& req);
+  // void dram_scheduler_final_stats();
+};
+
+#endif
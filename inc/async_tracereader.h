@@ -0,0 +1,166 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ASYNC_TRACEREADER_H
+#define ASYNC_TRACEREADER_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "instruction.h"
+#include "util/detect.h"
+
+namespace champsim
+{
+/**
+ * Decodes a trace on a background thread.
+ *
+ * The wrapped reader is called only from the background thread, which fills chunks of instructions ahead of the simulation.
+ * At most ``max_chunks`` chunks are held at once, so the decoder runs at most that far ahead. The instructions are returned in the same
+ * order as the wrapped reader would return them, and since instruction IDs are assigned by the tracereader, the simulation is unchanged.
+ */
+template <typename R>
+class async_tracereader
+{
+  template <typename U>
+  using has_eof = decltype(std::declval<U>().eof());
+
+  struct shared_state {
+    R reader;
+    std::size_t chunk_size;
+    std::size_t max_chunks;
+
+    std::mutex mutex{};
+    std::condition_variable not_empty{};
+    std::condition_variable not_full{};
+    std::deque<std::vector<ooo_model_instr>> ready{};
+    std::exception_ptr error{};
+    bool done = false;
+    bool stopping = false;
+
+    std::thread decoder{};
+
+    shared_state(R&& r, std::size_t chunk, std::size_t chunks) : reader(std::move(r)), chunk_size(chunk), max_chunks(chunks) {}
+
+    [[nodiscard]] bool reader_eof()
+    {
+      if constexpr (champsim::is_detected_v<has_eof, R>) {
+        return reader.eof();
+      }
+      return false;
+    }
+
+    void decode()
+    {
+      try {
+        while (!reader_eof()) {
+          std::vector<ooo_model_instr> chunk;
+          chunk.reserve(chunk_size);
+          while (std::size(chunk) < chunk_size && !reader_eof()) {
+            chunk.push_back(reader());
+          }
+
+          std::unique_lock lock{mutex};
+          not_full.wait(lock, [this] { return stopping || std::size(ready) < max_chunks; });
+          if (stopping) {
+            return;
+          }
+          ready.push_back(std::move(chunk));
+          not_empty.notify_one();
+        }
+      } catch (...) {
+        std::lock_guard lock{mutex};
+        error = std::current_exception();
+      }
+
+      std::lock_guard lock{mutex};
+      done = true;
+      not_empty.notify_one();
+    }
+  };
+
+  std::unique_ptr<shared_state> state;
+  mutable std::vector<ooo_model_instr> current{};
+  mutable std::size_t current_idx = 0;
+
+  // Block until the current chunk has an instruction or the trace has ended
+  void refill() const
+  {
+    if (current_idx < std::size(current)) {
+      return;
+    }
+
+    std::unique_lock lock{state->mutex};
+    state->not_empty.wait(lock, [this] { return state->done || !std::empty(state->ready); });
+    if (state->error) {
+      std::rethrow_exception(std::exchange(state->error, nullptr));
+    }
+    if (!std::empty(state->ready)) {
+      current = std::move(state->ready.front());
+      current_idx = 0;
+      state->ready.pop_front();
+      state->not_full.notify_one();
+    }
+  }
+
+public:
+  constexpr static std::size_t default_chunk_size = 4096;
+  constexpr static std::size_t default_max_chunks = 2;
+
+  explicit async_tracereader(R&& reader, std::size_t chunk_size = default_chunk_size, std::size_t max_chunks = default_max_chunks)
+      : state(std::make_unique<shared_state>(std::move(reader), std::max<std::size_t>(chunk_size, 1), std::max<std::size_t>(max_chunks, 1)))
+  {
+    state->decoder = std::thread{[s = state.get()] { s->decode(); }};
+  }
+
+  async_tracereader(async_tracereader&&) noexcept = default;
+  async_tracereader& operator=(async_tracereader&&) = delete;
+
+  ~async_tracereader()
+  {
+    if (state) {
+      {
+        std::lock_guard lock{state->mutex};
+        state->stopping = true;
+      }
+      state->not_full.notify_one();
+      state->decoder.join();
+    }
+  }
+
+  ooo_model_instr operator()()
+  {
+    refill();
+    return std::move(current.at(current_idx++));
+  }
+
+  [[nodiscard]] bool eof() const
+  {
+    refill();
+    return current_idx >= std::size(current);
+  }
+};
+} // namespace champsim
+
+#endif
@@ -32,6 +32,8 @@
 #include <stdexcept>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "address.h"
@@ -41,9 +43,11 @@
 #include "cache_stats.h"
 #include "champsim.h"
 #include "channel.h"
+#include "checkpoint.h"
 #include "chrono.h"
 #include "modules.h"
 #include "operable.h"
+#include "tag_array.h"
 #include "util/to_underlying.h" // for to_underlying
 #include "waitable.h"
 
@@ -122,6 +126,9 @@ private:
 
   void issue_translation(tag_lookup_type& q_entry) const;
 
+  response_type functional_lookup(tag_lookup_type handle_pkt, const champsim::functional_access& lower);
+  void functional_fill(const fill_type& fill, const champsim::functional_access& lower);
+
 public:
   using BLOCK = champsim::cache_block;
 
@@ -132,6 +139,7 @@ private:
   std::pair<set_type::iterator, set_type::iterator> get_set_span(champsim::address address);
   [[nodiscard]] std::pair<set_type::const_iterator, set_type::const_iterator> get_set_span(champsim::address address) const;
   [[nodiscard]] long get_set_index(champsim::address address) const;
+  void update_tags(set_type::const_iterator way);
 
   template <typename T>
   bool should_activate_prefetcher(const T& pkt) const;
@@ -145,6 +153,22 @@ private:
   auto matches_address(champsim::address address) const;
   std::pair<fill_type, request_type> mshr_and_forward_packet(const tag_lookup_type& handle_pkt);
 
+  /**
+   * Locates the entries of the MSHR and the inflight fills by block address, so that they need not be searched linearly.
+   * Each block maps to the position of its oldest entry in the queue, counted from the first entry ever pushed, and to the number of entries it has there.
+   */
+  struct fill_index_type {
+    std::unordered_map<uint64_t, std::pair<uint64_t, std::size_t>> entries{};
+    uint64_t head_position = 0;
+  };
+  fill_index_type mshr_index{};
+  fill_index_type inflight_fills_index{};
+
+  [[nodiscard]] uint64_t block_key(champsim::address address) const;
+  std::deque<fill_type>::iterator find_fill(std::deque<fill_type>& queue, const fill_index_type& index, champsim::address address) const;
+  void index_push_back(fill_index_type& index, const std::deque<fill_type>& queue) const;
+  void index_pop_front(fill_index_type& index, const std::deque<fill_type>& queue) const;
+
   std::deque<tag_lookup_type> internal_PQ{};
   std::deque<tag_lookup_type> inflight_tag_check{};
   std::deque<tag_lookup_type> translation_stash{};
@@ -162,6 +186,12 @@ public:
   champsim::chrono::clock::duration FILL_LATENCY;
   champsim::data::bits OFFSET_BITS;
   set_type block{static_cast<typename set_type::size_type>(NUM_SET * NUM_WAY)};
+
+private:
+  // The tags and valid bits of the blocks, searched in place of block itself. Every change to a block's address or validity is copied here.
+  champsim::tag_array block_tags{NUM_SET, NUM_WAY};
+
+public:
   champsim::bandwidth::maximum_type MAX_TAG, MAX_FILL;
   bool prefetch_as_load;
   bool match_offset_bits;
@@ -179,6 +209,8 @@ public:
   void initialize() final;
   void begin_phase() final;
   void end_phase(unsigned cpu) final;
+  [[nodiscard]] champsim::chrono::clock::time_point next_event() const final;
+  void skip_cycles(long count) final;
 
   [[deprecated]] std::size_t get_occupancy(uint8_t queue_type, champsim::address address) const;
   [[deprecated]] std::size_t get_size(uint8_t queue_type, champsim::address address) const;
@@ -210,6 +242,13 @@ public:
   [[deprecated("This function should not be used to access the blocks directly.")]] [[nodiscard]] uint64_t get_way(uint64_t address, uint64_t set) const;
 
   long invalidate_entry(champsim::address inval_addr);
+
+  /**
+   * Perform the access at once, updating the tags, replacement state, and prefetcher, with no queue or bandwidth modeling.
+   * Misses, translations, writebacks, and prefetches are served through the given function.
+   */
+  response_type functional_access(const request_type& packet, const champsim::functional_access& lower);
+
   bool prefetch_line(champsim::address pf_addr, bool fill_this_level, uint32_t prefetch_metadata);
 
   [[deprecated]] bool prefetch_line(uint64_t pf_addr, bool fill_this_level, uint32_t prefetch_metadata);
@@ -219,6 +258,13 @@ public:
 
   void print_deadlock() final;
 
+  /**
+   * Throw a checkpoint_error if the prefetcher or replacement policy cannot be checkpointed.
+   */
+  void check_checkpoint_support() const;
+  void save_checkpoint(champsim::checkpoint_writer& writer) const;
+  void load_checkpoint(champsim::checkpoint_reader& reader);
+
 #include "module_decl.inc"
 
   struct prefetcher_module_concept {
@@ -232,8 +278,12 @@ public:
     virtual uint32_t impl_prefetcher_cache_fill(champsim::address addr, long set, long way, bool prefetch, champsim::address evicted_addr,
                                                 uint32_t metadata_in) = 0;
     virtual void impl_prefetcher_cycle_operate() = 0;
+    [[nodiscard]] virtual bool impl_prefetcher_has_cycle_operate() const = 0;
     virtual void impl_prefetcher_final_stats() = 0;
     virtual void impl_prefetcher_branch_operate(champsim::address ip, uint8_t branch_type, champsim::address branch_target) = 0;
+    [[nodiscard]] virtual bool impl_prefetcher_has_checkpoint() const = 0;
+    virtual void impl_prefetcher_save_checkpoint(champsim::checkpoint_writer& writer) const = 0;
+    virtual void impl_prefetcher_load_checkpoint(champsim::checkpoint_reader& reader) = 0;
   };
 
   struct replacement_module_concept {
@@ -249,6 +299,9 @@ public:
     virtual void impl_replacement_cache_fill(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip,
                                              champsim::address victim_addr, access_type type) = 0;
     virtual void impl_replacement_final_stats() = 0;
+    [[nodiscard]] virtual bool impl_replacement_has_checkpoint() const = 0;
+    virtual void impl_replacement_save_checkpoint(champsim::checkpoint_writer& writer) const = 0;
+    virtual void impl_replacement_load_checkpoint(champsim::checkpoint_reader& reader) = 0;
   };
 
   template <typename... Ps>
@@ -266,8 +319,12 @@ public:
     [[nodiscard]] uint32_t impl_prefetcher_cache_fill(champsim::address addr, long set, long way, bool prefetch, champsim::address evicted_addr,
                                                       uint32_t metadata_in) final;
     void impl_prefetcher_cycle_operate() final;
+    [[nodiscard]] bool impl_prefetcher_has_cycle_operate() const final;
     void impl_prefetcher_final_stats() final;
     void impl_prefetcher_branch_operate(champsim::address ip, uint8_t branch_type, champsim::address branch_target) final;
+    [[nodiscard]] bool impl_prefetcher_has_checkpoint() const final;
+    void impl_prefetcher_save_checkpoint(champsim::checkpoint_writer& writer) const final;
+    void impl_prefetcher_load_checkpoint(champsim::checkpoint_reader& reader) final;
   };
 
   template <typename... Rs>
@@ -290,6 +347,9 @@ public:
     void impl_replacement_cache_fill(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip,
                                      champsim::address victim_addr, access_type type) final;
     void impl_replacement_final_stats() final;
+    [[nodiscard]] bool impl_replacement_has_checkpoint() const final;
+    void impl_replacement_save_checkpoint(champsim::checkpoint_writer& writer) const final;
+    void impl_replacement_load_checkpoint(champsim::checkpoint_reader& reader) final;
   };
 
   std::unique_ptr<prefetcher_module_concept> pref_module_pimpl;
@@ -397,6 +457,13 @@ void CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_cycle_operate()
   std::apply([&](auto&... p) { (..., process_one(p)); }, intern_);
 }
 
+template <typename... Ps>
+bool CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_has_cycle_operate() const
+{
+  using namespace champsim::modules;
+  return (false || ... || prefetcher::has_cycle_operate<Ps>);
+}
+
 template <typename... Ps>
 void CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_final_stats()
 {
@@ -423,6 +490,34 @@ void CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_branch_operate(champ
   std::apply([&](auto&... p) { (..., process_one(p)); }, intern_);
 }
 
+template <typename... Ps>
+bool CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_has_checkpoint() const
+{
+  return (true && ... && champsim::is_checkpointable_v<Ps>);
+}
+
+template <typename... Ps>
+void CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_save_checkpoint(champsim::checkpoint_writer& writer) const
+{
+  [[maybe_unused]] auto process_one = [&](const auto& p) {
+    if constexpr (champsim::is_checkpointable_v<std::decay_t<decltype(p)>>)
+      writer.write(p);
+  };
+
+  std::apply([&](const auto&... p) { (..., process_one(p)); }, intern_);
+}
+
+template <typename... Ps>
+void CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_load_checkpoint(champsim::checkpoint_reader& reader)
+{
+  [[maybe_unused]] auto process_one = [&](auto& p) {
+    if constexpr (champsim::is_checkpointable_v<std::decay_t<decltype(p)>>)
+      reader.read(p);
+  };
+
+  std::apply([&](auto&... p) { (..., process_one(p)); }, intern_);
+}
+
 template <typename... Rs>
 void CACHE::replacement_module_model<Rs...>::impl_initialize_replacement()
 {
@@ -530,6 +625,34 @@ void CACHE::replacement_module_model<Rs...>::impl_replacement_final_stats()
   std::apply([&](auto&... r) { (..., process_one(r)); }, intern_);
 }
 
+template <typename... Rs>
+bool CACHE::replacement_module_model<Rs...>::impl_replacement_has_checkpoint() const
+{
+  return (true && ... && champsim::is_checkpointable_v<Rs>);
+}
+
+template <typename... Rs>
+void CACHE::replacement_module_model<Rs...>::impl_replacement_save_checkpoint(champsim::checkpoint_writer& writer) const
+{
+  [[maybe_unused]] auto process_one = [&](const auto& r) {
+    if constexpr (champsim::is_checkpointable_v<std::decay_t<decltype(r)>>)
+      writer.write(r);
+  };
+
+  std::apply([&](const auto&... r) { (..., process_one(r)); }, intern_);
+}
+
+template <typename... Rs>
+void CACHE::replacement_module_model<Rs...>::impl_replacement_load_checkpoint(champsim::checkpoint_reader& reader)
+{
+  [[maybe_unused]] auto process_one = [&](auto& r) {
+    if constexpr (champsim::is_checkpointable_v<std::decay_t<decltype(r)>>)
+      reader.read(r);
+  };
+
+  std::apply([&](auto&... r) { (..., process_one(r)); }, intern_);
+}
+
 #ifdef SET_ASIDE_CHAMPSIM_MODULE
 #undef SET_ASIDE_CHAMPSIM_MODULE
 #define CHAMPSIM_MODULE
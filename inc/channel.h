@@ -20,6 +20,7 @@
 #include <array>
 #include <cstdint>
 #include <deque>
+#include <functional>
 #include <limits>
 #include <string_view>
 #include <vector>
@@ -112,6 +113,12 @@ public:
   [[nodiscard]] std::size_t wq_size() const;
   [[nodiscard]] std::size_t pq_size() const;
 };
+
+/**
+ * Serves a request immediately, as the level below the channel would, without modeling any queues or latency.
+ * This is used in functional warmup.
+ */
+using functional_access = std::function<channel::response_type(channel*, const channel::request_type&)>;
 } // namespace champsim
 
 #endif
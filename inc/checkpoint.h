@@ -0,0 +1,260 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <istream>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "chrono.h"
+#include "util/detect.h"
+#include "util/type_traits.h"
+
+namespace champsim
+{
+struct environment;
+
+/**
+ * Thrown when a checkpoint cannot be written or restored.
+ */
+struct checkpoint_error : public std::runtime_error {
+  using std::runtime_error::runtime_error;
+};
+
+class checkpoint_writer;
+class checkpoint_reader;
+
+namespace detail
+{
+template <typename T>
+using has_save_checkpoint = decltype(std::declval<const T&>().save_checkpoint(std::declval<checkpoint_writer&>()));
+
+template <typename T>
+using has_load_checkpoint = decltype(std::declval<T&>().load_checkpoint(std::declval<checkpoint_reader&>()));
+
+template <typename T>
+struct is_std_array : std::false_type {
+};
+
+template <typename T, std::size_t N>
+struct is_std_array<std::array<T, N>> : std::true_type {
+};
+
+// Vectors whose elements can be copied as one block of bytes
+template <typename T>
+struct is_bulk_vector : std::false_type {
+};
+
+template <typename T>
+struct is_bulk_vector<std::vector<T>>
+    : std::bool_constant<std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T> && !std::is_same_v<T, bool>
+                         && !champsim::is_detected_v<has_save_checkpoint, T> && !champsim::is_specialization_v<T, std::pair>
+                         && !champsim::is_specialization_v<T, std::tuple>> {
+};
+} // namespace detail
+
+/**
+ * True if the type can both save itself to and restore itself from a checkpoint.
+ */
+template <typename T>
+constexpr inline bool is_checkpointable_v =
+    champsim::is_detected_v<detail::has_save_checkpoint, T> && champsim::is_detected_v<detail::has_load_checkpoint, T>;
+
+/**
+ * Serializes simulator state to a binary stream.
+ *
+ * Values are written with write(). Types with a member ``save_checkpoint(checkpoint_writer&) const`` serialize themselves, pairs, tuples, and the standard
+ * containers are written element by element, and other trivially copyable types are written as raw bytes. The format is not portable between hosts or builds.
+ */
+class checkpoint_writer
+{
+  std::ostream& stream;
+
+  void write_bytes(const void* data, std::size_t size);
+
+public:
+  explicit checkpoint_writer(std::ostream& out);
+
+  /**
+   * Mark the start of a named section. The reader must expect the same name, which catches checkpoints taken with a different configuration.
+   */
+  void begin_section(std::string_view name);
+
+  template <typename T>
+  void write(const T& value);
+};
+
+/**
+ * Restores simulator state written by a checkpoint_writer. Every value must be read into an object of the same type it was written from.
+ */
+class checkpoint_reader
+{
+  std::istream& stream;
+
+  void read_bytes(void* data, std::size_t size);
+
+public:
+  explicit checkpoint_reader(std::istream& in);
+
+  /**
+   * Consume the start of a named section, throwing a checkpoint_error if the name does not match.
+   */
+  void begin_section(std::string_view name);
+
+  template <typename T>
+  void read(T& value);
+
+  /**
+   * Read a value and throw a checkpoint_error if it differs from the expected one. This is used to check the geometry of tables.
+   */
+  template <typename T>
+  void expect(const T& expected, std::string_view what);
+};
+
+/**
+ * Throw a checkpoint_error naming the first component whose modules cannot be checkpointed.
+ * This allows a run that will save a checkpoint to fail before it simulates anything.
+ */
+void check_checkpoint_support(environment& env);
+
+/**
+ * Write the warm state of the environment: the contents of the caches, the state of the branch predictors, BTBs, prefetchers, and replacement policies,
+ * the page table walker caches and virtual memory mappings, the open DRAM rows, and the number of instructions each core has retired.
+ * Instructions in flight are not saved.
+ */
+void save_checkpoint(std::ostream& out, environment& env, const champsim::chrono::clock& global_clock);
+
+/**
+ * Restore the state saved by save_checkpoint() into an environment of the same configuration, which must already be initialized.
+ * The global clock must not have been advanced.
+ */
+void load_checkpoint(std::istream& in, environment& env, champsim::chrono::clock& global_clock);
+
+template <typename T>
+void checkpoint_writer::write(const T& value)
+{
+  if constexpr (champsim::is_detected_v<detail::has_save_checkpoint, T>) {
+    value.save_checkpoint(*this);
+  } else if constexpr (champsim::is_specialization_v<T, std::pair> || champsim::is_specialization_v<T, std::tuple>) {
+    std::apply([this](const auto&... elems) { (..., write(elems)); }, value);
+  } else if constexpr (std::is_trivially_copyable_v<T>) {
+    write_bytes(&value, sizeof(T));
+  } else if constexpr (detail::is_std_array<T>::value) {
+    for (const auto& elem : value) {
+      write(elem);
+    }
+  } else if constexpr (detail::is_bulk_vector<T>::value) {
+    write(static_cast<uint64_t>(std::size(value)));
+    write_bytes(std::data(value), std::size(value) * sizeof(typename T::value_type));
+  } else if constexpr (champsim::is_specialization_v<T, std::vector> || champsim::is_specialization_v<T, std::deque>
+                       || champsim::is_specialization_v<T, std::map> || std::is_same_v<T, std::string>) {
+    write(static_cast<uint64_t>(std::size(value)));
+    for (const auto& elem : value) {
+      write(elem);
+    }
+  } else if constexpr (champsim::is_specialization_v<T, std::optional>) {
+    write(value.has_value());
+    if (value.has_value()) {
+      write(*value);
+    }
+  } else {
+    static_assert(!std::is_same_v<T, T>, "This type cannot be written to a checkpoint");
+  }
+}
+
+template <typename T>
+void checkpoint_reader::read(T& value)
+{
+  if constexpr (champsim::is_detected_v<detail::has_load_checkpoint, T>) {
+    value.load_checkpoint(*this);
+  } else if constexpr (champsim::is_specialization_v<T, std::pair> || champsim::is_specialization_v<T, std::tuple>) {
+    std::apply([this](auto&... elems) { (..., read(elems)); }, value);
+  } else if constexpr (std::is_trivially_copyable_v<T>) {
+    read_bytes(&value, sizeof(T));
+  } else if constexpr (detail::is_std_array<T>::value) {
+    for (auto& elem : value) {
+      read(elem);
+    }
+  } else if constexpr (detail::is_bulk_vector<T>::value) {
+    uint64_t size{};
+    read(size);
+    value.resize(size);
+    read_bytes(std::data(value), size * sizeof(typename T::value_type));
+  } else if constexpr (champsim::is_specialization_v<T, std::vector> || champsim::is_specialization_v<T, std::deque> || std::is_same_v<T, std::string>) {
+    uint64_t size{};
+    read(size);
+    if constexpr (std::is_default_constructible_v<typename T::value_type>) {
+      value.clear();
+      for (uint64_t i = 0; i < size; ++i) {
+        typename T::value_type elem{};
+        read(elem);
+        value.push_back(std::move(elem));
+      }
+    } else {
+      // Elements that need constructor arguments are restored in place, so the container must already have its final size
+      if (size != std::size(value)) {
+        throw checkpoint_error{"The checkpoint does not match this configuration: a table size differs"};
+      }
+      for (auto& elem : value) {
+        read(elem);
+      }
+    }
+  } else if constexpr (champsim::is_specialization_v<T, std::map>) {
+    uint64_t size{};
+    read(size);
+    value.clear();
+    for (uint64_t i = 0; i < size; ++i) {
+      std::pair<typename T::key_type, typename T::mapped_type> elem{};
+      read(elem);
+      value.insert(std::move(elem));
+    }
+  } else if constexpr (champsim::is_specialization_v<T, std::optional>) {
+    bool engaged{};
+    read(engaged);
+    value.reset();
+    if (engaged) {
+      read(value.emplace());
+    }
+  } else {
+    static_assert(!std::is_same_v<T, T>, "This type cannot be read from a checkpoint");
+  }
+}
+
+template <typename T>
+void checkpoint_reader::expect(const T& expected, std::string_view what)
+{
+  T found{};
+  read(found);
+  if (found != expected) {
+    throw checkpoint_error{"The checkpoint does not match this configuration: " + std::string{what} + " differs"};
+  }
+}
+} // namespace champsim
+
+#endif
@@ -17,10 +17,13 @@
 #ifndef CORE_BUILDER_H
 #define CORE_BUILDER_H
 
+#include <array>
 #include <cstdint>
 #include <limits>
+#include <optional>
 
 #include "chrono.h"
+#include "trace_instruction.h"
 
 class CACHE;
 class O3_CPU;
@@ -44,6 +47,7 @@ struct core_builder_base {
   std::size_t m_dispatch_buffer_size{1};
 
   std::size_t m_dib_hit_buffer_size{1};
+  std::size_t m_ftq_size{0};
 
   std::size_t m_register_file_size{1};
   std::size_t m_rob_size{1};
@@ -68,6 +72,13 @@ struct core_builder_base {
   unsigned m_schedule_latency{};
   unsigned m_execute_latency{};
 
+  struct functional_unit_spec {
+    std::size_t count{0}; // zero if the class is limited only by the execute width
+    bool pipelined{true};
+    std::optional<unsigned> latency{};
+  };
+  std::array<functional_unit_spec, champsim::NUM_OP_CLASSES> m_functional_units{};
+
   CACHE* m_l1i{};
   champsim::bandwidth::maximum_type m_l1i_bw{1};
   champsim::bandwidth::maximum_type m_l1d_bw{1};
@@ -133,6 +144,11 @@ public:
    */
   self_type& dib_hit_buffer_size(std::size_t dib_hit_buffer_size_);
 
+  /**
+   * Specify the number of fetch blocks the fetch target queue can hold. If this is zero, the branch predictor and fetch operate in lockstep.
+   */
+  self_type& ftq_size(std::size_t ftq_size_);
+
   /**
    * Specify the maximum size of the physical register file.
    */
@@ -225,6 +241,18 @@ public:
    */
   self_type& execute_latency(unsigned execute_latency_);
 
+  /**
+   * Specify the latency of execution for one class of instruction. Classes without their own latency use the latency above.
+   */
+  self_type& execute_latency(champsim::op_class op_class_, unsigned execute_latency_);
+
+  /**
+   * Specify the number of functional units that execute one class of instruction.
+   * A pipelined unit can begin an instruction every cycle, while an unpipelined one is occupied for the whole latency of the instruction.
+   * Classes without functional units are limited only by the execute width.
+   */
+  self_type& functional_units(champsim::op_class op_class_, std::size_t count_, bool pipelined_ = true);
+
   /**
    * Specify the latency of execution.
    */
@@ -346,6 +374,13 @@ auto champsim::core_builder<B, T>::dib_hit_buffer_size(std::size_t dib_hit_buffe
   return *this;
 }
 
+template <typename B, typename T>
+auto champsim::core_builder<B, T>::ftq_size(std::size_t ftq_size_) -> self_type&
+{
+  m_ftq_size = ftq_size_;
+  return *this;
+}
+
 template <typename B, typename T>
 auto champsim::core_builder<B, T>::lq_size(std::size_t lq_size_) -> self_type&
 {
@@ -465,6 +500,21 @@ auto champsim::core_builder<B, T>::execute_latency(unsigned execute_latency_) ->
   return *this;
 }
 
+template <typename B, typename T>
+auto champsim::core_builder<B, T>::execute_latency(champsim::op_class op_class_, unsigned execute_latency_) -> self_type&
+{
+  m_functional_units.at(static_cast<std::size_t>(op_class_)).latency = execute_latency_;
+  return *this;
+}
+
+template <typename B, typename T>
+auto champsim::core_builder<B, T>::functional_units(champsim::op_class op_class_, std::size_t count_, bool pipelined_) -> self_type&
+{
+  m_functional_units.at(static_cast<std::size_t>(op_class_)).count = count_;
+  m_functional_units.at(static_cast<std::size_t>(op_class_)).pipelined = pipelined_;
+  return *this;
+}
+
 template <typename B, typename T>
 auto champsim::core_builder<B, T>::l1i(CACHE* l1i_) -> self_type&
 {
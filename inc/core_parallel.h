@@ -0,0 +1,110 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CORE_PARALLEL_H
+#define CORE_PARALLEL_H
+
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "chrono.h"
+#include "instruction.h"
+#include "operable.h"
+
+class O3_CPU;
+
+namespace champsim
+{
+struct environment;
+class tracereader;
+
+/**
+ * Runs each core, together with the caches that only it can reach, on its own host thread.
+ *
+ * Operables are partitioned by walking the channel graph down from each core's L1I and L1D buses.
+ * A cache reachable from exactly one core is private to that core. Everything else (shared caches,
+ * the page table walkers, which share the VirtualMemory, and the memory controller) is run serially
+ * on the calling thread.
+ *
+ * With a quantum of one, each cycle is executed in the same order as the serial do_cycle(), except
+ * that runs of consecutive private operables are spread over the workers. Since private operables
+ * belonging to different cores share no channels, the result is bit-identical to a serial run.
+ *
+ * With a larger quantum, every core group runs for the whole quantum before the shared operables catch
+ * up. Traffic between a core group and the shared hierarchy is then delayed by up to one quantum. The
+ * result is still deterministic, because each channel has exactly one producer on either side of the
+ * synchronization point.
+ */
+class core_parallel_engine
+{
+  struct group_type {
+    O3_CPU* cpu;
+    std::vector<operable*> members{};
+    std::vector<operable*> order{};
+    std::deque<ooo_model_instr> pending{};
+  };
+
+  struct entry_type {
+    operable* op;
+    std::size_t owner;
+  };
+
+  constexpr static std::size_t shared_owner = std::numeric_limits<std::size_t>::max();
+
+  class worker_pool;
+
+  std::vector<entry_type> m_operables;
+  std::vector<entry_type> m_schedule;
+  std::vector<operable*> m_shared;
+  std::vector<operable*> m_shared_order;
+  std::vector<group_type> m_groups;
+  std::size_t m_num_workers;
+  long m_quantum;
+  std::unique_ptr<worker_pool> m_pool;
+
+  long do_exact_cycle(const champsim::chrono::clock& global_clock);
+  long do_relaxed_quantum(std::vector<tracereader>& traces, const std::vector<std::size_t>& trace_index, const champsim::chrono::clock& global_clock,
+                          champsim::chrono::clock::duration time_quantum);
+
+public:
+  /**
+   * :param env: The environment to partition. Its operables must outlive the engine.
+   * :param num_threads: The number of host threads to use, including the calling thread.
+   * :param quantum: The number of global clock ticks each core group may run ahead of the shared operables.
+   */
+  core_parallel_engine(environment& env, std::size_t num_threads, long quantum);
+  ~core_parallel_engine();
+
+  core_parallel_engine(const core_parallel_engine&) = delete;
+  core_parallel_engine& operator=(const core_parallel_engine&) = delete;
+
+  [[nodiscard]] long quantum() const;
+  [[nodiscard]] std::size_t num_workers() const;
+  [[nodiscard]] bool is_private(const operable& op) const;
+
+  /**
+   * Advance every operable to the global clock, which must have been advanced by quantum() ticks of time_quantum since the last call,
+   * and refill the input queues of the cores from the traces.
+   */
+  long do_quantum(std::vector<tracereader>& traces, const std::vector<std::size_t>& trace_index, const champsim::chrono::clock& global_clock,
+                  champsim::chrono::clock::duration time_quantum);
+};
+} // namespace champsim
+
+#endif
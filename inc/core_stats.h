@@ -14,6 +14,9 @@ struct cpu_stats {
   long long end_instrs = 0;
   long long end_cycles = 0;
   uint64_t total_rob_occupancy_at_branch_mispredict = 0;
+  uint64_t total_ftq_occupancy = 0;    // the number of fetch blocks in the fetch target queue, summed over every cycle
+  uint64_t front_end_stall_cycles = 0; // cycles in which the ROB had room but no instruction was waiting to dispatch
+  uint64_t wrong_path_instrs = 0;      // instructions fetched down the wrong path after a misprediction
 
   champsim::stats::event_counter<branch_type> total_branch_types = {};
   champsim::stats::event_counter<branch_type> branch_type_misses = {};
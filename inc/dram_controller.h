@@ -24,16 +24,87 @@
 #include <deque>    // for deque
 #include <iterator> // for end
 #include <limits>
+#include <memory>
 #include <optional>
+#include <set>
 #include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "address.h"
 #include "channel.h"
+#include "checkpoint.h"
 #include "chrono.h"
 #include "dram_stats.h"
 #include "extent_set.h"
+#include "modules.h"
 #include "operable.h"
 
+namespace champsim
+{
+/**
+ * Names the scheduler modules of a memory controller or DRAM channel, for use as a constructor argument.
+ */
+template <typename... Ss>
+struct dram_scheduler_module_type_holder {
+};
+} // namespace champsim
+
+/**
+ * The placement of the fields of a DRAM address above the block offset, listed from the least significant to the most significant.
+ * If swizzle is set, the channel, bankgroup, and bank indices are hashed with the row, as described in DRAM_ADDRESS_MAPPING::swizzle_bits().
+ * The controller field selects among memory controllers that share an address range. By default it is the most significant, so each controller
+ * serves a contiguous part of the range.
+ */
+struct dram_address_layout {
+  enum class field { channel, bankgroup, bank, column, rank, row, controller };
+  std::array<field, 7> order = {field::channel, field::bankgroup, field::bank, field::column, field::rank, field::row, field::controller};
+  bool swizzle = true;
+};
+
+/**
+ * When a bank closes its row after an access.
+ * An open page stays open until another row is needed, a closed page is precharged as soon as the access completes,
+ * and an adaptive page is precharged once the bank has been idle for the timeout, in cycles of the channel.
+ */
+struct dram_page_policy {
+  enum class mode { open, close, adaptive };
+  mode type = mode::open;
+  std::size_t timeout = 0;
+};
+
+/**
+ * How the banks of a channel are refreshed.
+ * An all-bank refresh blocks every bank of the channel each refresh interval. A per-bank refresh blocks one bank of each rank at a time, and a same-bank
+ * refresh blocks the bank with the same index in every bankgroup. Those refresh more often, so that each bank is still refreshed once per interval.
+ * Each of those takes per_bank_duration cycles of the channel (tRFCpb). If that is zero, the default, each takes half as long as an all-bank refresh.
+ * A refresh may be postponed while its bank has requests waiting, and a bank that is idle may pull in later refreshes, up to the given numbers of refreshes.
+ */
+struct dram_refresh_policy {
+  enum class mode { all_bank, per_bank, same_bank };
+  mode type = mode::all_bank;
+  std::size_t max_postponed = 0;
+  std::size_t max_pulled_in = 0;
+  std::size_t per_bank_duration = 0;
+};
+
+/**
+ * The part of the physical address space served by one memory controller, when the system has several.
+ * The controllers of a tier share the range from base to last, and each serves the addresses whose controller field equals its index.
+ * The controllers of a slower tier may add a fixed latency, in their own cycles, to each request.
+ * A controller with a name prefixes the names of its channels with it in the statistics.
+ */
+struct dram_node {
+  std::string name{};
+  champsim::address base{};
+  champsim::address last{std::numeric_limits<uint64_t>::max()};
+  std::size_t index = 0;
+  std::size_t count = 1;
+  std::size_t extra_latency = 0;
+};
+
 struct DRAM_ADDRESS_MAPPING {
   constexpr static std::size_t SLICER_OFFSET_IDX = 0;
   constexpr static std::size_t SLICER_CHANNEL_IDX = 1;
@@ -42,17 +113,19 @@ struct DRAM_ADDRESS_MAPPING {
   constexpr static std::size_t SLICER_COLUMN_IDX = 4;
   constexpr static std::size_t SLICER_RANK_IDX = 5;
   constexpr static std::size_t SLICER_ROW_IDX = 6;
+  constexpr static std::size_t SLICER_CONTROLLER_IDX = 7;
 
   using slicer_type = champsim::extent_set<champsim::dynamic_extent, champsim::dynamic_extent, champsim::dynamic_extent, champsim::dynamic_extent,
-                                           champsim::dynamic_extent, champsim::dynamic_extent, champsim::dynamic_extent>;
+                                           champsim::dynamic_extent, champsim::dynamic_extent, champsim::dynamic_extent, champsim::dynamic_extent>;
   const slicer_type address_slicer;
 
   const std::size_t prefetch_size;
+  const bool swizzle;
 
   DRAM_ADDRESS_MAPPING(champsim::data::bytes channel_width, std::size_t pref_size, std::size_t channels, std::size_t bankgroups, std::size_t banks,
-                       std::size_t columns, std::size_t ranks, std::size_t rows);
+                       std::size_t columns, std::size_t ranks, std::size_t rows, dram_address_layout layout = {}, std::size_t controllers = 1);
   static slicer_type make_slicer(champsim::data::bytes channel_width, std::size_t pref_size, std::size_t channels, std::size_t bankgroups, std::size_t banks,
-                                 std::size_t columns, std::size_t ranks, std::size_t rows);
+                                 std::size_t columns, std::size_t ranks, std::size_t rows, dram_address_layout layout = {}, std::size_t controllers = 1);
 
   unsigned long get_channel(champsim::address address) const;
   unsigned long get_rank(champsim::address address) const;
@@ -60,6 +133,7 @@ struct DRAM_ADDRESS_MAPPING {
   unsigned long get_bank(champsim::address address) const;
   unsigned long get_row(champsim::address address) const;
   unsigned long get_column(champsim::address address) const;
+  unsigned long get_controller(champsim::address address) const;
 
   /**
    * Perform the hashing operations for indexing our channels, banks, and bankgroups.
@@ -82,12 +156,33 @@ struct DRAM_ADDRESS_MAPPING {
 
   bool is_collision(champsim::address a, champsim::address b) const;
 
+  /**
+   * A value that is equal for two addresses exactly when is_collision() is true for them.
+   */
+  uint64_t collision_key(champsim::address address) const;
+
   std::size_t rows() const;
   std::size_t columns() const;
   std::size_t ranks() const;
   std::size_t bankgroups() const;
   std::size_t banks() const;
   std::size_t channels() const;
+  std::size_t controllers() const;
+};
+
+/**
+ * The supply voltage and currents of the DRAM devices, as given in their datasheet, from which the energy of each command is estimated.
+ * Currents are in milliamps and the voltage is in volts. The defaults describe an 8Gb x8 DDR4-3200 device.
+ */
+struct dram_power_parameters {
+  double VDD = 1.2;
+  double IDD0 = 57;   // one bank activating and precharging
+  double IDD2N = 37;  // precharge standby
+  double IDD3N = 52;  // active standby
+  double IDD4R = 168; // burst read
+  double IDD4W = 150; // burst write
+  double IDD5B = 250; // burst refresh
+  std::size_t device_width = 8;
 };
 
 struct DRAM_CHANNEL final : public champsim::operable {
@@ -102,12 +197,18 @@ struct DRAM_CHANNEL final : public champsim::operable {
     uint8_t asid[2] = {std::numeric_limits<uint8_t>::max(), std::numeric_limits<uint8_t>::max()};
 
     uint32_t pf_metadata = 0;
+    uint32_t cpu = std::numeric_limits<uint32_t>::max();
 
     champsim::address address{};
     champsim::address v_address{};
     champsim::address data{};
     champsim::chrono::clock::time_point ready_time = champsim::chrono::clock::time_point::max();
 
+    // The location of the address in the channel, decoded once when the request is first checked for collisions
+    std::size_t bank_index = 0;
+    std::size_t bankgroup_index = 0;
+    unsigned long row = 0;
+
     std::vector<uint64_t> instr_depend_on_me{};
     std::vector<std::deque<response_type>*> to_return{};
 
@@ -119,18 +220,27 @@ struct DRAM_CHANNEL final : public champsim::operable {
   queue_type RQ;
 
   /*
-   * | row address | rank index | column address | bank index | channel | block
-   * offset |
+   * By default, an address is laid out as
+   * | row address | rank index | column address | bank index | bankgroup index | channel | block offset |
    */
 
   struct BANK_REQUEST {
-    bool valid = false, row_buffer_hit = false, need_refresh = false, under_refresh = false;
+    bool valid = false, row_buffer_hit = false, under_refresh = false;
+
+    // The refreshes due to this bank that have not been issued. This is negative if refreshes have been pulled in.
+    long refresh_debt = 0;
 
     std::optional<std::size_t> open_row{};
 
     champsim::chrono::clock::time_point ready_time{};
 
     queue_type::iterator pkt;
+
+    // When the open row is closed, if the bank is still idle
+    champsim::chrono::clock::time_point close_time = champsim::chrono::clock::time_point::max();
+
+    // When the precharge of a row closed by the page policy completes
+    champsim::chrono::clock::time_point precharge_done{};
   };
 
   const champsim::data::bytes channel_width;
@@ -146,29 +256,169 @@ struct DRAM_CHANNEL final : public champsim::operable {
   std::size_t bank_request_index(champsim::address addr) const;
   std::size_t bankgroup_request_index(champsim::address addr) const;
 
+  /*
+   * The unscheduled requests in each queue, bucketed by bank. Each bucket holds the queue slots of its requests, ordered by the time they become ready.
+   * Among requests that become ready at the same time, the one in the later slot comes first.
+   */
+  using bucket_entry_type = std::pair<champsim::chrono::clock::time_point, std::size_t>;
+  struct bucket_order {
+    bool operator()(const bucket_entry_type& lhs, const bucket_entry_type& rhs) const
+    {
+      return lhs.first < rhs.first || (lhs.first == rhs.first && lhs.second > rhs.second);
+    }
+  };
+  using bucket_type = std::set<bucket_entry_type, bucket_order>;
+  std::vector<bucket_type> RQ_buckets{};
+  std::vector<bucket_type> WQ_buckets{};
+
+  /*
+   * The same requests, also bucketed by the row they access within each bank, so that a scheduler finds a row hit with one lookup.
+   */
+  using row_bucket_type = std::unordered_map<std::size_t, bucket_type>;
+  std::vector<row_bucket_type> RQ_row_buckets{};
+  std::vector<row_bucket_type> WQ_row_buckets{};
+
+  // The oldest ready request to the bank in the queue being drained, and the oldest one that hits in the bank's open row
+  [[nodiscard]] std::optional<bucket_entry_type> oldest_ready_request(std::size_t bank) const;
+  [[nodiscard]] std::optional<bucket_entry_type> oldest_ready_row_hit(std::size_t bank) const;
+
+  /*
+   * The requests in each queue that have been checked for collisions, keyed by DRAM_ADDRESS_MAPPING::collision_key() and mapped to their queue slot.
+   * A request that collides with one of these is merged or dropped when it is checked, so no two of them share a key.
+   */
+  std::unordered_map<uint64_t, std::size_t> RQ_blocks{};
+  std::unordered_map<uint64_t, std::size_t> WQ_blocks{};
+
+  void decode_location(request_type& req) const;
+  void add_to_bucket(queue_type& queue, queue_type::iterator pkt);
+  void remove_from_bucket(queue_type& queue, queue_type::iterator pkt);
+
   bool write_mode = false;
   champsim::chrono::clock::time_point dbus_cycle_available{};
 
+  /**
+   * The mode the channel should be in, given the occupancy of its queues.
+   * The scheduler module decides this if it can. Otherwise, writes are drained in bursts between watermarks of 7/8 and 6/8 of the write queue.
+   */
+  [[nodiscard]] bool select_write_mode() const;
+
   std::size_t refresh_row = 0;
   champsim::chrono::clock::time_point last_refresh{};
   std::size_t DRAM_ROWS_PER_REFRESH;
 
+  const dram_refresh_policy refresh_policy;
+
+  // The group of banks refreshed next, in the order given by the refresh policy
+  std::size_t refresh_group = 0;
+
+  [[nodiscard]] std::size_t refresh_groups() const;
+  [[nodiscard]] bool in_refresh_group(std::size_t bank_index, std::size_t group) const;
+  [[nodiscard]] champsim::chrono::clock::duration refresh_interval() const;
+  [[nodiscard]] champsim::chrono::clock::duration refresh_duration() const;
+
+  /**
+   * Whether an idle bank should begin a refresh now.
+   * A refresh is issued once the bank has postponed as many as it may, and never once it has pulled in as many as it may. Otherwise, the scheduler
+   * module decides if it can, and a refresh is issued if no requests are waiting for the bank.
+   */
+  [[nodiscard]] bool select_refresh(std::size_t bank_index);
+
   using stats_type = dram_stats;
   stats_type roi_stats, sim_stats;
 
   // Latencies
-  const champsim::chrono::clock::duration tRP, tRCD, tCAS, tRAS, tREF, tRFC, DRAM_DBUS_TURN_AROUND_TIME, DRAM_DBUS_RETURN_TIME, DRAM_DBUS_BANKGROUP_STALL;
+  const champsim::chrono::clock::duration tRP, tRCD, tCAS, tRAS, tREF, tRFC, tRFCpb, DRAM_DBUS_TURN_AROUND_TIME, DRAM_DBUS_RETURN_TIME,
+      DRAM_DBUS_BANKGROUP_STALL;
 
   // data bus period
   champsim::chrono::picoseconds data_bus_period{};
 
+  const dram_page_policy page_policy;
+
+  /*
+   * The energy of each command, in picojoules, and the background power of a rank, in milliwatts.
+   * The energy of an activation includes the precharge that closes the row.
+   */
+  struct command_energy_type {
+    double activate, read, write, refresh;
+    double active_standby_power, precharge_standby_power;
+  };
+  const command_energy_type command_energy;
+
+  /*
+   * A rank is in active standby while any of its banks has an open row, and in precharge standby otherwise.
+   * The time spent in each is accounted when the rank changes state and at the end of each phase.
+   */
+  struct rank_power_state {
+    std::size_t open_banks = 0;
+    champsim::chrono::clock::time_point since{};
+  };
+  std::vector<rank_power_state> rank_power{address_mapping.ranks()};
+
+  void account_row_change(std::size_t bank_index, bool was_open, bool is_open);
+  void account_background(std::size_t rank_index);
+
+  struct scheduler_module_concept {
+    virtual ~scheduler_module_concept() = default;
+
+    virtual void bind(DRAM_CHANNEL* chan) = 0;
+
+    virtual void impl_initialize_dram_scheduler() = 0;
+    virtual std::optional<queue_type::iterator> impl_select_request() = 0;
+    virtual std::optional<bool> impl_select_write_mode(std::size_t rq_occupancy, std::size_t wq_occupancy) = 0;
+    virtual std::optional<bool> impl_select_refresh(std::size_t bank_index, long refresh_debt) = 0;
+    virtual void impl_request_scheduled(const request_type& req) = 0;
+    virtual void impl_dram_scheduler_final_stats() = 0;
+  };
+
+  template <typename... Ss>
+  struct scheduler_module_model final : scheduler_module_concept {
+    std::tuple<Ss...> intern_;
+    explicit scheduler_module_model(DRAM_CHANNEL* chan) : intern_(Ss{chan}...) { (void)chan; /* silence -Wunused-but-set-parameter when sizeof...(Ss) == 0 */ }
+    void bind(DRAM_CHANNEL* chan) final
+    {
+      std::apply([chan = chan](auto&... s) { (..., s.bind(chan)); }, intern_);
+    }
+
+    void impl_initialize_dram_scheduler() final;
+    [[nodiscard]] std::optional<queue_type::iterator> impl_select_request() final;
+    [[nodiscard]] std::optional<bool> impl_select_write_mode(std::size_t rq_occupancy, std::size_t wq_occupancy) final;
+    [[nodiscard]] std::optional<bool> impl_select_refresh(std::size_t bank_index, long refresh_debt) final;
+    void impl_request_scheduled(const request_type& req) final;
+    void impl_dram_scheduler_final_stats() final;
+  };
+
+  // Without a scheduler module, the channel schedules the oldest request to a free bank
+  std::unique_ptr<scheduler_module_concept> sched_module_pimpl = std::make_unique<scheduler_module_model<>>(this);
+
+  void impl_dram_scheduler_final_stats() const;
+
   DRAM_CHANNEL(champsim::chrono::picoseconds dbus_period, champsim::chrono::picoseconds mc_period, std::size_t t_rp, std::size_t t_rcd, std::size_t t_cas,
                std::size_t t_ras, champsim::chrono::microseconds refresh_period, std::size_t refreshes_per_period, champsim::data::bytes width,
-               std::size_t rq_size, std::size_t wq_size, DRAM_ADDRESS_MAPPING addr_mapping);
+               std::size_t rq_size, std::size_t wq_size, DRAM_ADDRESS_MAPPING addr_mapping, dram_power_parameters power = {},
+               dram_page_policy policy = {}, dram_refresh_policy refresh = {});
+
+  template <typename... Ss>
+  DRAM_CHANNEL(champsim::chrono::picoseconds dbus_period, champsim::chrono::picoseconds mc_period, std::size_t t_rp, std::size_t t_rcd, std::size_t t_cas,
+               std::size_t t_ras, champsim::chrono::microseconds refresh_period, std::size_t refreshes_per_period, champsim::data::bytes width,
+               std::size_t rq_size, std::size_t wq_size, DRAM_ADDRESS_MAPPING addr_mapping, dram_power_parameters power, dram_page_policy policy,
+               dram_refresh_policy refresh, champsim::dram_scheduler_module_type_holder<Ss...>)
+      : DRAM_CHANNEL(dbus_period, mc_period, t_rp, t_rcd, t_cas, t_ras, refresh_period, refreshes_per_period, width, rq_size, wq_size, addr_mapping, power,
+                     policy, refresh)
+  {
+    sched_module_pimpl = std::make_unique<scheduler_module_model<Ss...>>(this);
+  }
+
+  DRAM_CHANNEL(const DRAM_CHANNEL&) = delete;
+  DRAM_CHANNEL(DRAM_CHANNEL&&);
+  DRAM_CHANNEL& operator=(const DRAM_CHANNEL&) = delete;
+  DRAM_CHANNEL& operator=(DRAM_CHANNEL&&) = delete;
 
   void check_write_collision();
   void check_read_collision();
   long finish_dbus_request();
+  void close_idle_rows();
+  [[nodiscard]] champsim::chrono::clock::time_point row_close_time() const;
   long schedule_refresh();
   void swap_write_mode();
   long populate_dbus();
@@ -177,10 +427,17 @@ struct DRAM_CHANNEL final : public champsim::operable {
 
   void initialize() final;
   long operate() final;
+  [[nodiscard]] champsim::chrono::clock::time_point next_event() const final;
   void begin_phase() final;
   void end_phase(unsigned cpu) final;
   void print_deadlock() final;
 
+  /**
+   * The open rows and refresh progress are saved. Requests in flight are not.
+   */
+  void save_checkpoint(champsim::checkpoint_writer& writer) const;
+  void load_checkpoint(champsim::checkpoint_reader& reader);
+
   std::size_t bank_request_capacity() const;
   std::size_t bankgroup_request_capacity() const;
   [[nodiscard]] champsim::data::bytes density() const;
@@ -197,6 +454,7 @@ class MEMORY_CONTROLLER : public champsim::operable
   void initiate_requests();
   bool add_rq(const request_type& packet, champsim::channel* ul);
   bool add_wq(const request_type& packet);
+  void raise_request_event(const request_type& packet, bool is_write) const;
 
   const DRAM_ADDRESS_MAPPING address_mapping;
 
@@ -204,20 +462,139 @@ class MEMORY_CONTROLLER : public champsim::operable
   champsim::chrono::picoseconds data_bus_period{};
 
 public:
+  const dram_node node;
+
   std::vector<DRAM_CHANNEL> channels;
 
   MEMORY_CONTROLLER(champsim::chrono::picoseconds dbus_period, champsim::chrono::picoseconds mc_period, std::size_t t_rp, std::size_t t_rcd, std::size_t t_cas,
                     std::size_t t_ras, champsim::chrono::microseconds refresh_period, std::vector<channel_type*>&& ul, std::size_t rq_size, std::size_t wq_size,
                     std::size_t chans, champsim::data::bytes chan_width, std::size_t rows, std::size_t columns, std::size_t ranks, std::size_t bankgroups,
-                    std::size_t banks, std::size_t refreshes_per_period);
+                    std::size_t banks, std::size_t refreshes_per_period, dram_power_parameters power = {}, dram_page_policy page_policy = {},
+                    dram_address_layout layout = {}, dram_node node_ = {}, dram_refresh_policy refresh = {});
+
+  template <typename... Ss>
+  MEMORY_CONTROLLER(champsim::chrono::picoseconds dbus_period, champsim::chrono::picoseconds mc_period, std::size_t t_rp, std::size_t t_rcd, std::size_t t_cas,
+                    std::size_t t_ras, champsim::chrono::microseconds refresh_period, std::vector<channel_type*>&& ul, std::size_t rq_size, std::size_t wq_size,
+                    std::size_t chans, champsim::data::bytes chan_width, std::size_t rows, std::size_t columns, std::size_t ranks, std::size_t bankgroups,
+                    std::size_t banks, std::size_t refreshes_per_period, dram_power_parameters power, dram_page_policy page_policy,
+                    dram_address_layout layout, dram_node node_, dram_refresh_policy refresh, champsim::dram_scheduler_module_type_holder<Ss...>)
+      : MEMORY_CONTROLLER(dbus_period, mc_period, t_rp, t_rcd, t_cas, t_ras, refresh_period, std::move(ul), rq_size, wq_size, chans, chan_width, rows, columns,
+                          ranks, bankgroups, banks, refreshes_per_period, power, page_policy, layout, std::move(node_), refresh)
+  {
+    for (auto& chan : channels) {
+      chan.sched_module_pimpl = std::make_unique<DRAM_CHANNEL::scheduler_module_model<Ss...>>(&chan);
+    }
+  }
 
   void initialize() final;
   long operate() final;
+  [[nodiscard]] champsim::chrono::clock::time_point next_event() const final;
+  void skip_cycles(long count) final;
   void begin_phase() final;
   void end_phase(unsigned cpu) final;
   void print_deadlock() final;
 
+  void save_checkpoint(champsim::checkpoint_writer& writer) const;
+  void load_checkpoint(champsim::checkpoint_reader& reader);
+
+  /**
+   * The capacity of this controller.
+   */
   [[nodiscard]] champsim::data::bytes size() const;
+
+  /**
+   * The range of physical addresses that this controller shares with the others of its tier, as its lowest address and the address past its end.
+   */
+  [[nodiscard]] std::pair<champsim::address, champsim::address> address_range() const;
+
+  /**
+   * Whether requests to the address are served by this controller.
+   */
+  [[nodiscard]] bool owns(champsim::address address) const;
+
+  /**
+   * The channels through which the upper levels send requests to this controller.
+   */
+  [[nodiscard]] const std::vector<champsim::channel*>& upper_levels() const { return queues; }
 };
 
+template <typename... Ss>
+void DRAM_CHANNEL::scheduler_module_model<Ss...>::impl_initialize_dram_scheduler()
+{
+  [[maybe_unused]] auto process_one = [&](auto& s) {
+    using namespace champsim::modules;
+    if constexpr (dram_scheduler::has_initialize<decltype(s)>)
+      s.initialize_dram_scheduler();
+  };
+
+  std::apply([&](auto&... s) { (..., process_one(s)); }, intern_);
+}
+
+template <typename... Ss>
+auto DRAM_CHANNEL::scheduler_module_model<Ss...>::impl_select_request() -> std::optional<queue_type::iterator>
+{
+  // The last module to select a request has the final say
+  std::optional<queue_type::iterator> selected{};
+  [[maybe_unused]] auto process_one = [&](auto& s) {
+    using namespace champsim::modules;
+    if constexpr (dram_scheduler::has_select_request<decltype(s)>)
+      selected = s.select_request();
+  };
+
+  std::apply([&](auto&... s) { (..., process_one(s)); }, intern_);
+  return selected;
+}
+
+template <typename... Ss>
+std::optional<bool> DRAM_CHANNEL::scheduler_module_model<Ss...>::impl_select_write_mode(std::size_t rq_occupancy, std::size_t wq_occupancy)
+{
+  std::optional<bool> selected{};
+  [[maybe_unused]] auto process_one = [&](auto& s) {
+    using namespace champsim::modules;
+    if constexpr (dram_scheduler::has_select_write_mode<decltype(s), std::size_t, std::size_t>)
+      selected = s.select_write_mode(rq_occupancy, wq_occupancy);
+  };
+
+  std::apply([&](auto&... s) { (..., process_one(s)); }, intern_);
+  return selected;
+}
+
+template <typename... Ss>
+std::optional<bool> DRAM_CHANNEL::scheduler_module_model<Ss...>::impl_select_refresh(std::size_t bank_index, long refresh_debt)
+{
+  std::optional<bool> selected{};
+  [[maybe_unused]] auto process_one = [&](auto& s) {
+    using namespace champsim::modules;
+    if constexpr (dram_scheduler::has_select_refresh<decltype(s), std::size_t, long>)
+      selected = s.select_refresh(bank_index, refresh_debt);
+  };
+
+  std::apply([&](auto&... s) { (..., process_one(s)); }, intern_);
+  return selected;
+}
+
+template <typename... Ss>
+void DRAM_CHANNEL::scheduler_module_model<Ss...>::impl_request_scheduled(const request_type& req)
+{
+  [[maybe_unused]] auto process_one = [&](auto& s) {
+    using namespace champsim::modules;
+    if constexpr (dram_scheduler::has_request_scheduled<decltype(s), const request_type&>)
+      s.request_scheduled(req);
+  };
+
+  std::apply([&](auto&... s) { (..., process_one(s)); }, intern_);
+}
+
+template <typename... Ss>
+void DRAM_CHANNEL::scheduler_module_model<Ss...>::impl_dram_scheduler_final_stats()
+{
+  [[maybe_unused]] auto process_one = [&](auto& s) {
+    using namespace champsim::modules;
+    if constexpr (dram_scheduler::has_final_stats<decltype(s)>)
+      s.dram_scheduler_final_stats();
+  };
+
+  std::apply([&](auto&... s) { (..., process_one(s)); }, intern_);
+}
+
 #endif
@@ -0,0 +1,69 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DRAM_REPLAY_H
+#define DRAM_REPLAY_H
+
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <string>
+
+#include "address.h"
+#include "environment.h"
+#include "phase_info.h"
+
+namespace champsim
+{
+/**
+ * One request in a memory trace, as it arrived at a memory controller.
+ *
+ * In text form, a record is a single line of the form
+ *
+ *     <cycle> <cpu> <R|W> <address>
+ *
+ * where the cycle is counted in the controller's clock and the address may be given in decimal or with a 0x prefix.
+ * Blank lines and lines beginning with '#' carry no record.
+ */
+struct dram_trace_record {
+  uint64_t cycle = 0;
+  uint32_t cpu = 0;
+  bool is_write = false;
+  champsim::address address{};
+};
+
+/**
+ * Parse one line of a memory trace.
+ * Returns an empty optional if the line carries no record, and throws std::invalid_argument if the line is malformed.
+ */
+std::optional<dram_trace_record> parse_dram_trace_record(const std::string& line);
+
+/**
+ * Format a record as one line of a memory trace, without the trailing newline.
+ */
+std::string format_dram_trace_record(const dram_trace_record& record);
+
+/**
+ * Replay a memory trace into the memory controllers of the environment, without any cores or caches.
+ *
+ * Each record is issued through the first upper-level channel of the first controller no earlier than its cycle.
+ * If the controller's queues are full, the record (and all that follow it) waits until there is room.
+ * The replay finishes when the trace is exhausted and every queue has drained.
+ */
+phase_stats replay_dram_trace(environment& env, std::istream& trace);
+} // namespace champsim
+
+#endif
@@ -3,13 +3,30 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
+
+#include "chrono.h"
 
 struct dram_stats {
   std::string name{};
   long dbus_cycle_congested{};
   uint64_t dbus_count_congested = 0;
   uint64_t refresh_cycles = 0;
+
+  // Cycles in which a read was ready but its bank was being refreshed
+  uint64_t refresh_stall_cycles = 0;
   unsigned WQ_ROW_BUFFER_HIT = 0, WQ_ROW_BUFFER_MISS = 0, RQ_ROW_BUFFER_HIT = 0, RQ_ROW_BUFFER_MISS = 0, WQ_FULL = 0;
+
+  // DRAM commands issued, with REF counted once for each bank refreshed
+  uint64_t ACT = 0, PRE = 0, RD = 0, WR = 0, REF = 0;
+
+  // Time spent by each rank in each background state
+  std::vector<champsim::chrono::picoseconds> active_standby_time{}, precharge_standby_time{};
+
+  // Energy, in picojoules
+  double activate_energy = 0, read_energy = 0, write_energy = 0, refresh_energy = 0, background_energy = 0;
+
+  [[nodiscard]] double total_energy() const { return activate_energy + read_energy + write_energy + refresh_energy + background_energy; }
 };
 
 dram_stats operator-(dram_stats lhs, dram_stats rhs);
@@ -2,14 +2,16 @@
 #define EVENT_LISTENERS_H
 
 #include <iostream>
+#include <mutex>
 #include <string>
 #include <tuple>
 #include <vector>
 
 #include "events.h"
+#include "listeners/dram_trace.h"
 #include "listeners/heartbeat.h"
 
-inline auto listeners = std::make_tuple(Heartbeat(&std::cout));
+inline auto listeners = std::make_tuple(Heartbeat(&std::cout), DramTrace(nullptr));
 
 template <typename>
 struct listener_names_helper {
@@ -22,6 +24,10 @@ constexpr inline auto listener_names = listener_names_helper<decltype(listeners)
 
 inline std::bitset<std::tuple_size_v<decltype(listeners)>> listener_activation_map;
 
+// Cores raise events from several host threads while the core-parallel engine has workers, which then serializes dispatch
+inline bool listener_serialize = false;
+inline std::mutex listener_mutex;
+
 inline void init_event_listeners(const std::vector<std::string>& requested_listeners)
 {
   listener_activation_map.reset();
@@ -58,7 +64,12 @@ void handle_listener_event(std::index_sequence<Is...>, Args&&... args)
 template <Event e, typename... Args>
 void handle_event(Args&&... args)
 {
-  handle_listener_event<e>(std::make_index_sequence<std::tuple_size_v<decltype(listeners)>>{}, std::forward<Args>(args)...);
+  if (listener_serialize) {
+    std::lock_guard<std::mutex> lock{listener_mutex};
+    handle_listener_event<e>(std::make_index_sequence<std::tuple_size_v<decltype(listeners)>>{}, std::forward<Args>(args)...);
+  } else {
+    handle_listener_event<e>(std::make_index_sequence<std::tuple_size_v<decltype(listeners)>>{}, std::forward<Args>(args)...);
+  }
 }
 
 #endif
\ No newline at end of file
@@ -1,6 +1,6 @@
-#ifndef EVENTS_H
-#define EVENTS_H
-
-enum Event { BEGIN_PHASE, RETIRE };
-
+#ifndef EVENTS_H
+#define EVENTS_H
+
+enum Event { BEGIN_PHASE, RETIRE, DRAM_REQUEST };
+
 #endif
\ No newline at end of file
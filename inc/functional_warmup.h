@@ -0,0 +1,57 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FUNCTIONAL_WARMUP_H
+#define FUNCTIONAL_WARMUP_H
+
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "channel.h"
+#include "environment.h"
+#include "instruction.h"
+
+namespace champsim
+{
+/**
+ * Serves each instruction of a trace at once through the caches and page table walkers of an environment, with no queue, bandwidth, or latency
+ * modeling. The tags, replacement state, prefetchers, branch predictors, BTBs, and page tables are updated as they would be in a timed run.
+ * Requests that reach memory are not modeled.
+ */
+class functional_hierarchy
+{
+  std::unordered_map<const champsim::channel*, CACHE*> caches{};
+  std::unordered_map<const champsim::channel*, PageTableWalker*> walkers{};
+  std::vector<std::optional<champsim::block_number>> last_fetch{};
+  champsim::functional_access lower;
+
+public:
+  explicit functional_hierarchy(environment& env);
+
+  /**
+   * Serve the request from whichever level receives the channel's requests.
+   */
+  champsim::channel::response_type access(champsim::channel* queue, const champsim::channel::request_type& packet);
+
+  /**
+   * Predict, fetch, and perform the memory accesses of the instruction, and count it as retired by the core.
+   */
+  void execute(O3_CPU& cpu, ooo_model_instr& instr);
+};
+} // namespace champsim
+
+#endif
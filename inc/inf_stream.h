@@ -197,6 +197,7 @@ struct inf_istream {
     constexpr static std::size_t CHUNK = (1 << 16);
 
     std::array<strm_in_buf_type, CHUNK> in_buf;
+    std::array<strm_out_buf_type, CHUNK> uns_out_buf; // the inflation state points here between calls
     std::array<char_type, CHUNK> out_buf;
     typename Tag::inflate_state_type strm = Tag::new_inflate_state();
     typename std::add_pointer<IStrm>::type src;
@@ -236,9 +237,7 @@ template <typename T, typename S>
 template <typename I>
 auto inf_istream<T, S>::inf_streambuf<I>::underflow() -> int_type
 {
-  std::array<strm_out_buf_type, std::tuple_size<decltype(out_buf)>::value> uns_out_buf;
-
-  strm->avail_out = uns_out_buf.size();
+  strm->avail_out = CHUNK;
   strm->next_out = uns_out_buf.data();
   do {
     // Check to see if we have consumed all available input
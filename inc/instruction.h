@@ -20,15 +20,15 @@
 #include <algorithm>
 #include <array>
 #include <cstdint>
-#include <functional>
+#include <iterator>
 #include <limits>
 #include <string_view>
-#include <vector>
 
 #include "address.h"
 #include "champsim.h"
 #include "chrono.h"
 #include "trace_instruction.h"
+#include "util/inline_vector.h"
 
 // branch types
 enum branch_type {
@@ -91,6 +91,24 @@ struct program_ordered {
    * Return a functor that tests whether an instruction precededes the given instruction.
    */
   static auto precedes(const T& instr) { return precedes(instr.instr_id); }
+
+  /**
+   * Find the element with the given ID in a range that is in program order, or return the end of the range if there is none.
+   * IDs are usually consecutive, so the element is first looked for at the offset of its ID from the first element.
+   */
+  template <typename It>
+  static It find_id(It begin, It end, id_type id)
+  {
+    if (begin != end && id >= begin->instr_id && id - begin->instr_id < static_cast<id_type>(std::distance(begin, end))) {
+      auto guess = std::next(begin, static_cast<typename std::iterator_traits<It>::difference_type>(id - begin->instr_id));
+      if (guess->instr_id == id) {
+        return guess;
+      }
+    }
+
+    auto found = std::partition_point(begin, end, precedes(id));
+    return (found != end && found->instr_id == id) ? found : end;
+  }
 };
 } // namespace champsim
 
@@ -108,6 +126,8 @@ struct ooo_model_instr : champsim::program_ordered<ooo_model_instr> {
   branch_type branch{NOT_BRANCH};
   champsim::address branch_target{};
 
+  champsim::op_class op_class{champsim::op_class::unknown}; // only known if the trace records it
+
   bool dib_checked = false;
   bool fetch_issued = false;
   bool fetch_completed = false;
@@ -119,14 +139,12 @@ struct ooo_model_instr : champsim::program_ordered<ooo_model_instr> {
   unsigned completed_mem_ops = 0;
   int num_reg_dependent = 0;
 
-  std::vector<PHYSICAL_REGISTER_ID> destination_registers = {}; // output registers
-  std::vector<PHYSICAL_REGISTER_ID> source_registers = {};      // input registers
-
-  std::vector<champsim::address> destination_memory = {};
-  std::vector<champsim::address> source_memory = {};
+  // The operands are held inline, with room for as many as either trace format can hold, so that instructions never allocate
+  champsim::inline_vector<PHYSICAL_REGISTER_ID, NUM_INSTR_DESTINATIONS_SPARC> destination_registers = {}; // output registers
+  champsim::inline_vector<PHYSICAL_REGISTER_ID, NUM_INSTR_SOURCES> source_registers = {};                 // input registers
 
-  // these are indices of instructions in the ROB that depend on me
-  std::vector<std::reference_wrapper<ooo_model_instr>> registers_instrs_depend_on_me;
+  champsim::inline_vector<champsim::address, NUM_INSTR_DESTINATIONS_SPARC> destination_memory = {};
+  champsim::inline_vector<champsim::address, NUM_INSTR_SOURCES> source_memory = {};
 
 private:
   template <typename T>
@@ -194,6 +212,12 @@ private:
 public:
   ooo_model_instr(uint8_t cpu, input_instr instr) : ooo_model_instr(instr, {cpu, cpu}) {}
   ooo_model_instr(uint8_t /*cpu*/, cloudsuite_instr instr) : ooo_model_instr(instr, {instr.asid[0], instr.asid[1]}) {}
+  ooo_model_instr(uint8_t cpu, op_class_instr instr) : ooo_model_instr(instr, {cpu, cpu})
+  {
+    if (instr.op_class < champsim::NUM_OP_CLASSES) {
+      op_class = static_cast<champsim::op_class>(instr.op_class);
+    }
+  }
 
   [[nodiscard]] std::size_t num_mem_ops() const { return std::size(destination_memory) + std::size(source_memory); }
 };
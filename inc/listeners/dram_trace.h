@@ -0,0 +1,52 @@
+#ifndef DRAM_TRACE_H
+#define DRAM_TRACE_H
+
+#include <cstdint>
+#include <iostream>
+
+#include "address.h"
+#include "dram_replay.h"
+#include "events.h"
+
+/**
+ * Writes every request that reaches a memory controller outside of warmup as one line of a memory trace,
+ * which can be replayed later with --dram-replay.
+ */
+class DramTrace
+{
+public:
+  std::ostream* trace_out;
+
+  explicit DramTrace(std::ostream* so) { trace_out = so; }
+
+  static constexpr auto cli_key = "DramTrace";
+
+  template <Event e, typename... Args>
+  void handle_event(Args&&... args);
+};
+
+namespace dram_trace
+{
+
+template <Event e, typename... Args>
+inline void handle_event([[maybe_unused]] DramTrace* dt, [[maybe_unused]] Args&... args)
+{
+}
+
+template <>
+inline void handle_event<Event::DRAM_REQUEST>(DramTrace* dt, uint64_t& cycle, uint32_t& cpu, bool& is_write, champsim::address& address)
+{
+  if (dt->trace_out != nullptr) {
+    *(dt->trace_out) << champsim::format_dram_trace_record({cycle, cpu, is_write, address}) << '\n';
+  }
+}
+
+} // namespace dram_trace
+
+template <Event e, typename... Args>
+void DramTrace::handle_event(Args&&... args)
+{
+  dram_trace::handle_event<e>(this, std::forward<Args>(args)...);
+}
+
+#endif
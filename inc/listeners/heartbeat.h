@@ -2,13 +2,13 @@
 #define HEARTBEAT_H
 
 #include <chrono>
-#include <deque>
 #include <iostream>
 #include <vector>
 #include <fmt/chrono.h>
 
 #include "events.h"
 #include "instruction.h"
+#include "util/ring_buffer.h"
 
 class Heartbeat
 {
@@ -50,7 +50,7 @@ namespace heartbeat
 {
 
 template <Event e, typename... Args>
-inline void handle_event(Heartbeat* hb, Args&... args)
+inline void handle_event([[maybe_unused]] Heartbeat* hb, [[maybe_unused]] Args&... args)
 {
   // std::cout << "WARNING: generic handle event\n";
 }
@@ -64,8 +64,8 @@ inline void handle_event<Event::BEGIN_PHASE>(Heartbeat* hb, [[maybe_unused]] boo
 }
 
 template <>
-inline void handle_event<Event::RETIRE>(Heartbeat* hb, uint32_t& cpu, std::deque<ooo_model_instr>::const_iterator& begin,
-                                        std::deque<ooo_model_instr>::const_iterator& end, uint64_t& current_cycles)
+inline void handle_event<Event::RETIRE>(Heartbeat* hb, uint32_t& cpu, champsim::ring_buffer<ooo_model_instr>::const_iterator& begin,
+                                        champsim::ring_buffer<ooo_model_instr>::const_iterator& end, uint64_t& current_cycles)
 {
   hb->add_cpu(cpu);
   hb->num_retired[cpu] += std::distance(begin, end);
@@ -0,0 +1,106 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MMAP_TRACEREADER_H
+#define MMAP_TRACEREADER_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include "instruction.h"
+
+namespace champsim
+{
+/**
+ * A read-only memory mapping of an entire file.
+ * The kernel is advised that the file will be read sequentially and, where supported, that it may back the mapping with huge pages.
+ */
+class mapped_file
+{
+  const std::byte* m_data = nullptr;
+  std::size_t m_size = 0;
+
+public:
+  /**
+   * Map the named file. Throws a std::system_error if the file cannot be opened or mapped.
+   */
+  explicit mapped_file(const std::string& fname);
+  ~mapped_file();
+
+  mapped_file(const mapped_file&) = delete;
+  mapped_file& operator=(const mapped_file&) = delete;
+  mapped_file(mapped_file&& other) noexcept;
+  mapped_file& operator=(mapped_file&& other) noexcept;
+
+  [[nodiscard]] const std::byte* data() const { return m_data; }
+  [[nodiscard]] std::size_t size() const { return m_size; }
+};
+
+/**
+ * Reads an uncompressed trace directly from a memory mapping of the file.
+ *
+ * Each record is decoded straight from the mapping, and the branch target of a taken branch is read from the record that follows it.
+ * Like the bulk_tracereader, the last record in the file is never returned, since its branch target is unknown.
+ */
+template <typename T>
+class mmap_tracereader
+{
+  static_assert(std::is_trivial_v<T>);
+  static_assert(std::is_standard_layout_v<T>);
+
+  uint8_t cpu;
+  mapped_file trace_file;
+  std::size_t num_records;
+  std::size_t next_record = 0;
+
+  [[nodiscard]] T record(std::size_t idx) const
+  {
+    T retval;
+    std::memcpy(&retval, trace_file.data() + idx * sizeof(T), sizeof(T)); // the mapping may not be aligned for T
+    return retval;
+  }
+
+public:
+  mmap_tracereader(uint8_t cpu_idx, std::string tf) : cpu(cpu_idx), trace_file(tf), num_records(trace_file.size() / sizeof(T)) {}
+
+  ooo_model_instr operator()()
+  {
+    assert(next_record < num_records);
+    ooo_model_instr retval{cpu, record(next_record)};
+    ++next_record;
+
+    if (retval.is_branch && retval.branch_taken && next_record < num_records) {
+      retval.branch_target = champsim::address{record(next_record).ip};
+    }
+
+    return retval;
+  }
+
+  [[nodiscard]] bool eof() const { return next_record + 1 >= num_records; }
+
+  /**
+   * Skip over the given number of records.
+   */
+  void skip(uint64_t count) { next_record = std::min<std::size_t>(num_records, next_record + count); }
+};
+} // namespace champsim
+
+#endif
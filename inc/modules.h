@@ -25,9 +25,11 @@
 #include "address.h"
 #include "block.h"
 #include "champsim.h"
+#include "checkpoint.h"
 
 class CACHE;
 class O3_CPU;
+struct DRAM_CHANNEL;
 namespace champsim::modules
 {
 inline constexpr bool warn_if_any_missing = true;
@@ -196,6 +198,58 @@ struct replacement : public bound_to<CACHE> {
   template <typename T, typename... Args>
   constexpr static bool has_final_stats = decltype(final_stats_member_impl<T, Args...>(0))::value;
 };
+
+struct dram_scheduler : public bound_to<DRAM_CHANNEL> {
+  explicit dram_scheduler(DRAM_CHANNEL* chan) : bound_to<DRAM_CHANNEL>(chan) {}
+
+  template <typename T, typename... Args>
+  static auto initialize_member_impl(int) -> decltype(std::declval<T>().initialize_dram_scheduler(std::declval<Args>()...), std::true_type{});
+  template <typename, typename...>
+  static auto initialize_member_impl(long) -> std::false_type;
+
+  template <typename T, typename... Args>
+  static auto select_request_member_impl(int) -> decltype(std::declval<T>().select_request(std::declval<Args>()...), std::true_type{});
+  template <typename, typename...>
+  static auto select_request_member_impl(long) -> std::false_type;
+
+  template <typename T, typename... Args>
+  static auto select_write_mode_member_impl(int) -> decltype(std::declval<T>().select_write_mode(std::declval<Args>()...), std::true_type{});
+  template <typename, typename...>
+  static auto select_write_mode_member_impl(long) -> std::false_type;
+
+  template <typename T, typename... Args>
+  static auto select_refresh_member_impl(int) -> decltype(std::declval<T>().select_refresh(std::declval<Args>()...), std::true_type{});
+  template <typename, typename...>
+  static auto select_refresh_member_impl(long) -> std::false_type;
+
+  template <typename T, typename... Args>
+  static auto request_scheduled_member_impl(int) -> decltype(std::declval<T>().request_scheduled(std::declval<Args>()...), std::true_type{});
+  template <typename, typename...>
+  static auto request_scheduled_member_impl(long) -> std::false_type;
+
+  template <typename T, typename... Args>
+  static auto final_stats_member_impl(int) -> decltype(std::declval<T>().dram_scheduler_final_stats(std::declval<Args>()...), std::true_type{});
+  template <typename, typename...>
+  static auto final_stats_member_impl(long) -> std::false_type;
+
+  template <typename T, typename... Args>
+  constexpr static bool has_initialize = decltype(initialize_member_impl<T, Args...>(0))::value;
+
+  template <typename T, typename... Args>
+  constexpr static bool has_select_request = decltype(select_request_member_impl<T, Args...>(0))::value;
+
+  template <typename T, typename... Args>
+  constexpr static bool has_select_write_mode = decltype(select_write_mode_member_impl<T, Args...>(0))::value;
+
+  template <typename T, typename... Args>
+  constexpr static bool has_select_refresh = decltype(select_refresh_member_impl<T, Args...>(0))::value;
+
+  template <typename T, typename... Args>
+  constexpr static bool has_request_scheduled = decltype(request_scheduled_member_impl<T, Args...>(0))::value;
+
+  template <typename T, typename... Args>
+  constexpr static bool has_final_stats = decltype(final_stats_member_impl<T, Args...>(0))::value;
+};
 } // namespace champsim::modules
 
 #endif
@@ -26,6 +26,7 @@
 #include <utility>
 #include <vector>
 
+#include "checkpoint.h"
 #include "extent.h"
 #include "msl/bits.h"
 #include "util/detect.h"
@@ -165,6 +166,28 @@ public:
     return std::exchange(*hit, {}).data;
   }
 
+  void save_checkpoint(champsim::checkpoint_writer& writer) const
+  {
+    writer.write(NUM_SET);
+    writer.write(NUM_WAY);
+    writer.write(access_count);
+    for (const auto& blk : block) {
+      writer.write(blk.last_used);
+      writer.write(blk.data);
+    }
+  }
+
+  void load_checkpoint(champsim::checkpoint_reader& reader)
+  {
+    reader.expect(NUM_SET, "the number of sets in a table");
+    reader.expect(NUM_WAY, "the number of ways in a table");
+    reader.read(access_count);
+    for (auto& blk : block) {
+      reader.read(blk.last_used);
+      reader.read(blk.data);
+    }
+  }
+
   lru_table(std::size_t sets, std::size_t ways, SetProj set_proj, TagProj tag_proj)
       : set_projection(set_proj), tag_projection(tag_proj), NUM_SET(static_cast<diff_type>(sets)), NUM_WAY(static_cast<diff_type>(ways)), block(sets * ways)
   {
@@ -25,17 +25,21 @@
 #include <array>
 #include <bitset>
 #include <deque>
+#include <functional>
 #include <limits>
 #include <memory>
 #include <optional>
 #include <queue>
 #include <stdexcept>
 #include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "bandwidth.h"
 #include "champsim.h"
 #include "channel.h"
+#include "checkpoint.h"
 #include "core_builder.h"
 #include "core_stats.h"
 #include "instruction.h"
@@ -43,6 +47,7 @@
 #include "operable.h"
 #include "register_allocator.h"
 #include "util/lru_table.h"
+#include "util/ring_buffer.h"
 #include "util/to_underlying.h"
 
 class CACHE;
@@ -59,8 +64,10 @@ class CacheBus
 
 public:
   CacheBus(uint32_t cpu_idx, champsim::channel* ll) : lower_level(ll), cpu(cpu_idx) {}
+  [[nodiscard]] channel_type* lower_channel() const { return lower_level; }
   bool issue_read(request_type packet);
   bool issue_write(request_type packet);
+  bool issue_prefetch(request_type packet);
 };
 
 struct LSQ_ENTRY : champsim::program_ordered<LSQ_ENTRY> {
@@ -76,7 +83,7 @@ struct LSQ_ENTRY : champsim::program_ordered<LSQ_ENTRY> {
 
   LSQ_ENTRY(champsim::address addr, champsim::program_ordered<LSQ_ENTRY>::id_type id, champsim::address ip, std::array<uint8_t, 2> asid);
   void finish(ooo_model_instr& rob_entry) const;
-  void finish(std::deque<ooo_model_instr>::iterator begin, std::deque<ooo_model_instr>::iterator end) const;
+  void finish(champsim::ring_buffer<ooo_model_instr>::iterator begin, champsim::ring_buffer<ooo_model_instr>::iterator end) const;
 };
 
 // cpu
@@ -98,6 +105,27 @@ public:
 
   bool show_heartbeat = true;
 
+  // In cache-only mode, the pipeline is bypassed. Each cycle, up to FETCH_WIDTH instructions are taken from the input queue in order,
+  // and their fetches, loads, and stores are issued directly to the L1I and L1D. At most one load per entry of the load queue may be outstanding.
+  bool cache_only = false;
+  std::vector<champsim::block_number> cache_only_outstanding_loads;
+  std::optional<champsim::block_number> cache_only_last_fetch;
+
+  // In wrong-path mode, the front end follows the predicted path after a misprediction instead of stopping. The wrong-path instructions are
+  // replayed from an image of the code, which is learned from the instructions already seen in the trace and grows with its static footprint.
+  // The wrong path ends where the image has no entry, and everything younger than the branch is squashed when the branch resolves.
+  bool wrong_path = false;
+  struct code_image_entry {
+    ooo_model_instr instr;
+    champsim::address fall_through{};
+  };
+  std::unordered_map<uint64_t, code_image_entry> code_image; // by instruction pointer
+  std::optional<champsim::address> code_image_last_ip;
+  std::optional<ooo_model_instr> wrong_path_next;
+  champsim::address wrong_path_successor{};
+  uint64_t wrong_path_instr_id = uint64_t{1} << 63; // greater than the ID of any instruction from a trace
+  std::optional<uint64_t> wrong_path_squash_after;
+
   using stats_type = cpu_stats;
 
   stats_type roi_stats{}, sim_stats{};
@@ -111,17 +139,25 @@ public:
   dib_type DIB;
 
   // reorder buffer, load/store queue, register file
-  std::deque<ooo_model_instr> IFETCH_BUFFER;
-  std::deque<ooo_model_instr> DISPATCH_BUFFER;
-  std::deque<ooo_model_instr> DECODE_BUFFER;
-  std::deque<ooo_model_instr> ROB;
-  std::deque<ooo_model_instr> DIB_HIT_BUFFER;
+  // The instruction buffers are reserved to their configured sizes on construction, so instructions pass through them without allocating.
+  champsim::ring_buffer<ooo_model_instr> IFETCH_BUFFER;
+  champsim::ring_buffer<ooo_model_instr> DISPATCH_BUFFER;
+  champsim::ring_buffer<ooo_model_instr> DECODE_BUFFER;
+  champsim::ring_buffer<ooo_model_instr> ROB;
+  champsim::ring_buffer<ooo_model_instr> DIB_HIT_BUFFER;
 
   std::vector<std::optional<LSQ_ENTRY>> LQ;
   std::deque<LSQ_ENTRY> SQ;
 
+  // Indices over the load and store queues, so that finding an entry does not scan them. Each index is kept in step with the entries it names.
+  std::priority_queue<std::size_t, std::vector<std::size_t>, std::greater<>> lq_free_slots; // the lowest free slot is allocated first
+  std::unordered_multimap<uint64_t, std::size_t> lq_slots_by_instr_id;
+  std::unordered_multimap<uint64_t, std::size_t> lq_issued_slots_by_block;                // by block number
+  std::vector<std::size_t> lq_ready_slots;                                                 // in slot order, executed and waiting to issue
+  std::unordered_map<uint64_t, std::pair<uint64_t, std::size_t>> sq_stores_by_address;   // the youngest store to each address, and the number of stores
+
   // Constants
-  const std::size_t IFETCH_BUFFER_SIZE, DISPATCH_BUFFER_SIZE, DECODE_BUFFER_SIZE, REGISTER_FILE_SIZE, ROB_SIZE, SQ_SIZE, DIB_HIT_BUFFER_SIZE;
+  const std::size_t IFETCH_BUFFER_SIZE, DISPATCH_BUFFER_SIZE, DECODE_BUFFER_SIZE, REGISTER_FILE_SIZE, ROB_SIZE, SQ_SIZE, DIB_HIT_BUFFER_SIZE, FTQ_SIZE;
   champsim::bandwidth::maximum_type FETCH_WIDTH, DECODE_WIDTH, DISPATCH_WIDTH, SCHEDULER_SIZE, EXEC_WIDTH, DIB_INORDER_WIDTH;
   champsim::bandwidth::maximum_type LQ_WIDTH, SQ_WIDTH;
   champsim::bandwidth::maximum_type RETIRE_WIDTH;
@@ -136,21 +172,50 @@ public:
 
   RegisterAllocator reg_allocator{REGISTER_FILE_SIZE};
 
+  // The scheduling and execution stages track the instructions in the ROB by their positions, counted from the first instruction to enter it,
+  // so that each cycle they examine only the instructions that can change state.
+  using rob_position = uint64_t;
+  using completion_entry = std::pair<champsim::chrono::clock::time_point, rob_position>;
+  rob_position rob_head_position = 0;
+  std::vector<rob_position> ready_to_execute;                                                      // in program order
+  std::priority_queue<completion_entry, std::vector<completion_entry>, std::greater<>> executing;  // by the time their latency elapses
+  std::vector<rob_position> finished_executing;                                                    // in program order
+  std::deque<std::pair<rob_position, unsigned long>> scheduled_register_demand;                    // a decreasing running maximum
+  uint64_t register_demand_generation = 0;
+  long scheduled_unexecuted = 0;
+
+  // Each class of instruction executes with its own latency. A class with functional units also waits for one of them to be free.
+  struct functional_unit_pool {
+    champsim::chrono::clock::duration latency{};
+    bool pipelined = true;
+    std::vector<champsim::chrono::clock::time_point> free_at{}; // one per unit, or empty if the class is limited only by the execute width
+  };
+  std::array<functional_unit_pool, champsim::NUM_OP_CLASSES> functional_units;
+
   // branch
   champsim::chrono::clock::time_point fetch_resume_time{};
 
   const long IN_QUEUE_SIZE;
-  std::deque<ooo_model_instr> input_queue;
+  champsim::ring_buffer<ooo_model_instr> input_queue;
+
+  // If FTQ_SIZE is nonzero, the branch predictor runs ahead of fetch. Each cycle, it predicts up to one fetch block from the input queue into the
+  // fetch target queue and prefetches the block into the L1I. Fetch then takes its instructions from the head of the queue.
+  champsim::ring_buffer<ooo_model_instr> FTQ;
+  champsim::ring_buffer<std::size_t> ftq_block_lengths; // the number of instructions in each fetch block
+  std::optional<champsim::block_number> ftq_last_prefetch;
 
   CacheBus L1I_bus, L1D_bus;
   CACHE* l1i;
 
   void initialize() final;
   long operate() final;
+  [[nodiscard]] champsim::chrono::clock::time_point next_event() const final;
   void begin_phase() final;
   void end_phase(unsigned cpu) final;
+  void skip_cycles(long count) final;
 
   void initialize_instruction();
+  long predict_fetch_targets();
   long check_dib();
   long fetch_instruction();
   long promote_to_decode();
@@ -162,18 +227,40 @@ public:
   long complete_inflight_instruction();
   long handle_memory_return();
   long retire_rob();
+  long operate_cache_only();
+  bool issue_cache_only(ooo_model_instr& instr);
+
+  [[nodiscard]] bool front_end_stalled() const;
+  ooo_model_instr* next_predicted_instruction();
+  bool take_predicted_instruction(champsim::ring_buffer<ooo_model_instr>& buffer);
+  void learn_code_image(const ooo_model_instr& instr);
+  void begin_wrong_path(champsim::address ip);
+  void resolve_wrong_path(const ooo_model_instr& branch);
+  void squash_wrong_path();
 
   bool do_init_instruction(ooo_model_instr& instr);
   bool do_predict_branch(ooo_model_instr& instr);
   void do_check_dib(ooo_model_instr& instr);
-  bool do_fetch_instruction(std::deque<ooo_model_instr>::iterator begin, std::deque<ooo_model_instr>::iterator end);
+  bool do_fetch_instruction(champsim::ring_buffer<ooo_model_instr>::iterator begin, champsim::ring_buffer<ooo_model_instr>::iterator end);
   void do_dib_update(const ooo_model_instr& instr);
   void do_scheduling(ooo_model_instr& instr);
   void do_execution(ooo_model_instr& instr);
+  [[nodiscard]] static champsim::op_class execution_class(const ooo_model_instr& instr);
+  bool reserve_functional_unit(const ooo_model_instr& instr);
   void do_memory_scheduling(ooo_model_instr& instr);
   void do_complete_execution(ooo_model_instr& instr);
   void do_sq_forward_to_lq(LSQ_ENTRY& sq_entry, LSQ_ENTRY& lq_entry);
 
+  ooo_model_instr* rob_entry_at(rob_position pos);
+  [[nodiscard]] const ooo_model_instr* rob_entry_at(rob_position pos) const;
+  [[nodiscard]] unsigned long registers_needed(const ooo_model_instr& instr) const;
+  [[nodiscard]] std::pair<std::size_t, champsim::bandwidth> scheduler_window() const;
+  void track_register_demand(rob_position pos);
+  void await_sources(rob_position pos);
+  void wake_consumers();
+
+  std::deque<LSQ_ENTRY>::iterator youngest_store_to(champsim::address addr);
+  void release_lq_entry(std::size_t slot);
   void do_finish_store(const LSQ_ENTRY& sq_entry);
   bool do_complete_store(const LSQ_ENTRY& sq_entry);
   bool execute_load(const LSQ_ENTRY& lq_entry);
@@ -185,6 +272,13 @@ public:
 
   void print_deadlock() final;
 
+  /**
+   * Throw a checkpoint_error if the branch predictor or BTB cannot be checkpointed.
+   */
+  void check_checkpoint_support() const;
+  void save_checkpoint(champsim::checkpoint_writer& writer) const;
+  void load_checkpoint(champsim::checkpoint_reader& reader);
+
 #include "module_decl.inc"
 
   struct branch_module_concept {
@@ -193,6 +287,9 @@ public:
     virtual void impl_initialize_branch_predictor() = 0;
     virtual void impl_last_branch_result(champsim::address ip, champsim::address target, bool taken, uint8_t branch_type) = 0;
     virtual bool impl_predict_branch(champsim::address ip, champsim::address predicted_target, bool always_taken, uint8_t branch_type) = 0;
+    [[nodiscard]] virtual bool impl_branch_predictor_has_checkpoint() const = 0;
+    virtual void impl_branch_predictor_save_checkpoint(champsim::checkpoint_writer& writer) const = 0;
+    virtual void impl_branch_predictor_load_checkpoint(champsim::checkpoint_reader& reader) = 0;
   };
 
   struct btb_module_concept {
@@ -201,6 +298,9 @@ public:
     virtual void impl_initialize_btb() = 0;
     virtual void impl_update_btb(champsim::address ip, champsim::address predicted_target, bool taken, uint8_t branch_type) = 0;
     virtual std::pair<champsim::address, bool> impl_btb_prediction(champsim::address ip, uint8_t branch_type) = 0;
+    [[nodiscard]] virtual bool impl_btb_has_checkpoint() const = 0;
+    virtual void impl_btb_save_checkpoint(champsim::checkpoint_writer& writer) const = 0;
+    virtual void impl_btb_load_checkpoint(champsim::checkpoint_reader& reader) = 0;
   };
 
   template <typename... Bs>
@@ -211,6 +311,9 @@ public:
     void impl_initialize_branch_predictor() final;
     void impl_last_branch_result(champsim::address ip, champsim::address target, bool taken, uint8_t branch_type) final;
     [[nodiscard]] bool impl_predict_branch(champsim::address ip, champsim::address predicted_target, bool always_taken, uint8_t branch_type) final;
+    [[nodiscard]] bool impl_branch_predictor_has_checkpoint() const final;
+    void impl_branch_predictor_save_checkpoint(champsim::checkpoint_writer& writer) const final;
+    void impl_branch_predictor_load_checkpoint(champsim::checkpoint_reader& reader) final;
   };
 
   template <typename... Ts>
@@ -221,6 +324,9 @@ public:
     void impl_initialize_btb() final;
     void impl_update_btb(champsim::address ip, champsim::address predicted_target, bool taken, uint8_t branch_type) final;
     [[nodiscard]] std::pair<champsim::address, bool> impl_btb_prediction(champsim::address ip, uint8_t branch_type) final;
+    [[nodiscard]] bool impl_btb_has_checkpoint() const final;
+    void impl_btb_save_checkpoint(champsim::checkpoint_writer& writer) const final;
+    void impl_btb_load_checkpoint(champsim::checkpoint_reader& reader) final;
   };
 
   std::unique_ptr<branch_module_concept> branch_module_pimpl;
@@ -242,8 +348,9 @@ public:
         DIB(b.m_dib_set, b.m_dib_way, {champsim::data::bits{champsim::lg2(b.m_dib_window)}}, {champsim::data::bits{champsim::lg2(b.m_dib_window)}}),
         LQ(b.m_lq_size), IFETCH_BUFFER_SIZE(b.m_ifetch_buffer_size), DISPATCH_BUFFER_SIZE(b.m_dispatch_buffer_size), DECODE_BUFFER_SIZE(b.m_decode_buffer_size),
         REGISTER_FILE_SIZE(b.m_register_file_size), ROB_SIZE(b.m_rob_size), SQ_SIZE(b.m_sq_size), DIB_HIT_BUFFER_SIZE(b.m_dib_hit_buffer_size),
-        FETCH_WIDTH(b.m_fetch_width), DECODE_WIDTH(b.m_decode_width), DISPATCH_WIDTH(b.m_dispatch_width), SCHEDULER_SIZE(b.m_schedule_width),
-        EXEC_WIDTH(b.m_execute_width), DIB_INORDER_WIDTH(b.m_dib_inorder_width), LQ_WIDTH(b.m_lq_width), SQ_WIDTH(b.m_sq_width), RETIRE_WIDTH(b.m_retire_width),
+        FTQ_SIZE(b.m_ftq_size), FETCH_WIDTH(b.m_fetch_width), DECODE_WIDTH(b.m_decode_width), DISPATCH_WIDTH(b.m_dispatch_width),
+        SCHEDULER_SIZE(b.m_schedule_width), EXEC_WIDTH(b.m_execute_width), DIB_INORDER_WIDTH(b.m_dib_inorder_width), LQ_WIDTH(b.m_lq_width),
+        SQ_WIDTH(b.m_sq_width), RETIRE_WIDTH(b.m_retire_width),
         BRANCH_MISPREDICT_PENALTY(b.m_mispredict_penalty * b.m_clock_period), DISPATCH_LATENCY(b.m_dispatch_latency * b.m_clock_period),
         DECODE_LATENCY(b.m_decode_latency * b.m_clock_period), SCHEDULING_LATENCY(b.m_schedule_latency * b.m_clock_period),
         EXEC_LATENCY(b.m_execute_latency * b.m_clock_period), DIB_HIT_LATENCY(b.m_dib_hit_latency * b.m_clock_period), L1I_BANDWIDTH(b.m_l1i_bw),
@@ -251,6 +358,25 @@ public:
         L1D_bus(b.m_cpu, b.m_data_queues), l1i(b.m_l1i), branch_module_pimpl(std::make_unique<branch_module_model<Bs...>>(this)),
         btb_module_pimpl(std::make_unique<btb_module_model<Ts...>>(this))
   {
+    for (std::size_t slot = 0; slot < std::size(LQ); ++slot) {
+      lq_free_slots.push(slot);
+    }
+
+    for (std::size_t op_class = 0; op_class < champsim::NUM_OP_CLASSES; ++op_class) {
+      const auto& spec = b.m_functional_units.at(op_class);
+      auto& pool = functional_units.at(op_class);
+      pool.latency = spec.latency.has_value() ? spec.latency.value() * b.m_clock_period : EXEC_LATENCY;
+      pool.pipelined = spec.pipelined;
+      pool.free_at.resize(spec.count);
+    }
+
+    IFETCH_BUFFER.reserve(IFETCH_BUFFER_SIZE);
+    DISPATCH_BUFFER.reserve(DISPATCH_BUFFER_SIZE);
+    DECODE_BUFFER.reserve(DECODE_BUFFER_SIZE);
+    ROB.reserve(ROB_SIZE);
+    DIB_HIT_BUFFER.reserve(DIB_HIT_BUFFER_SIZE);
+    input_queue.reserve(static_cast<std::size_t>(IN_QUEUE_SIZE));
+    ftq_block_lengths.reserve(FTQ_SIZE);
   }
 };
 
@@ -311,6 +437,34 @@ bool O3_CPU::branch_module_model<Bs...>::impl_predict_branch(champsim::address i
   return return_type{};
 }
 
+template <typename... Bs>
+bool O3_CPU::branch_module_model<Bs...>::impl_branch_predictor_has_checkpoint() const
+{
+  return (true && ... && champsim::is_checkpointable_v<Bs>);
+}
+
+template <typename... Bs>
+void O3_CPU::branch_module_model<Bs...>::impl_branch_predictor_save_checkpoint(champsim::checkpoint_writer& writer) const
+{
+  [[maybe_unused]] auto process_one = [&](const auto& b) {
+    if constexpr (champsim::is_checkpointable_v<std::decay_t<decltype(b)>>)
+      writer.write(b);
+  };
+
+  std::apply([&](const auto&... b) { (..., process_one(b)); }, intern_);
+}
+
+template <typename... Bs>
+void O3_CPU::branch_module_model<Bs...>::impl_branch_predictor_load_checkpoint(champsim::checkpoint_reader& reader)
+{
+  [[maybe_unused]] auto process_one = [&](auto& b) {
+    if constexpr (champsim::is_checkpointable_v<std::decay_t<decltype(b)>>)
+      reader.read(b);
+  };
+
+  std::apply([&](auto&... b) { (..., process_one(b)); }, intern_);
+}
+
 template <typename... Ts>
 void O3_CPU::btb_module_model<Ts...>::impl_initialize_btb()
 {
@@ -369,6 +523,34 @@ std::pair<champsim::address, bool> O3_CPU::btb_module_model<Ts...>::impl_btb_pre
   return return_type{};
 }
 
+template <typename... Ts>
+bool O3_CPU::btb_module_model<Ts...>::impl_btb_has_checkpoint() const
+{
+  return (true && ... && champsim::is_checkpointable_v<Ts>);
+}
+
+template <typename... Ts>
+void O3_CPU::btb_module_model<Ts...>::impl_btb_save_checkpoint(champsim::checkpoint_writer& writer) const
+{
+  [[maybe_unused]] auto process_one = [&](const auto& t) {
+    if constexpr (champsim::is_checkpointable_v<std::decay_t<decltype(t)>>)
+      writer.write(t);
+  };
+
+  std::apply([&](const auto&... t) { (..., process_one(t)); }, intern_);
+}
+
+template <typename... Ts>
+void O3_CPU::btb_module_model<Ts...>::impl_btb_load_checkpoint(champsim::checkpoint_reader& reader)
+{
+  [[maybe_unused]] auto process_one = [&](auto& t) {
+    if constexpr (champsim::is_checkpointable_v<std::decay_t<decltype(t)>>)
+      reader.read(t);
+  };
+
+  std::apply([&](auto&... t) { (..., process_one(t)); }, intern_);
+}
+
 #ifdef SET_ASIDE_CHAMPSIM_MODULE
 #undef SET_ASIDE_CHAMPSIM_MODULE
 #define CHAMPSIM_MODULE
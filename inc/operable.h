@@ -35,11 +35,24 @@ public:
   long _operate();
   long operate_on(const champsim::chrono::clock& clock);
 
+  /**
+   * Advance to the given clock without operating, as though every intervening cycle did nothing.
+   * This is only valid if next_event() is later than every skipped cycle.
+   */
+  void skip_to(const champsim::chrono::clock& clock);
+
+  /**
+   * The earliest time at which operate() could change the state of this operable, assuming that none of its inputs change.
+   * The default, one period after the current time, means that the operable must be operated every cycle.
+   */
+  [[nodiscard]] virtual champsim::chrono::clock::time_point next_event() const;
+
   virtual void initialize() {} // LCOV_EXCL_LINE
   virtual long operate() = 0;
   virtual void begin_phase() {}                     // LCOV_EXCL_LINE
   virtual void end_phase(unsigned /*cpu index*/) {} // LCOV_EXCL_LINE
   virtual void print_deadlock() {}                  // LCOV_EXCL_LINE
+  virtual void skip_cycles(long /*count*/) {}       // LCOV_EXCL_LINE
 
   [[deprecated]] uint64_t current_cycle() const;
 };
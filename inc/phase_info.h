@@ -38,6 +38,29 @@ struct phase_info {
   std::vector<std::string> trace_names;
 };
 
+/**
+ * Options that control how the phases are run.
+ */
+struct run_options {
+  std::size_t num_threads = 1;
+  long sync_quantum = 1;
+
+  /**
+   * If not empty, the warm state is written to this file before the first non-warmup phase.
+   */
+  std::string save_checkpoint{};
+
+  /**
+   * If not empty, the warm state is restored from this file and the warmup phases are skipped.
+   */
+  std::string load_checkpoint{};
+
+  /**
+   * If set, the warmup phases are run through the functional hierarchy rather than the timing model.
+   */
+  bool functional_warmup = false;
+};
+
 struct phase_stats {
   std::string name;
   std::vector<std::string> trace_names;
@@ -26,6 +26,7 @@
 #include "address.h"
 #include "bandwidth.h"
 #include "channel.h"
+#include "checkpoint.h"
 #include "operable.h"
 #include "ptw_builder.h"
 #include "util/lru_table.h"
@@ -71,9 +72,8 @@ class PageTableWalker : public champsim::operable
   std::deque<mshr_type> finished;
   std::deque<mshr_type> completed;
 
-  std::vector<channel_type*> upper_levels;
-  channel_type* lower_level;
-
+  mshr_type begin_walk(const request_type& handle_pkt);
+  static request_type translation_packet(const mshr_type& source);
   std::optional<mshr_type> handle_read(const request_type& pkt, channel_type* ul);
   std::optional<mshr_type> handle_fill(const mshr_type& fill_mshr);
   std::optional<mshr_type> step_translation(const mshr_type& source);
@@ -81,6 +81,9 @@ class PageTableWalker : public champsim::operable
   void finish_packet(const response_type& packet);
 
 public:
+  std::vector<channel_type*> upper_levels;
+  channel_type* lower_level;
+
   const std::string NAME;
   const uint32_t MSHR_SIZE;
   champsim::bandwidth::maximum_type MAX_READ, MAX_FILL;
@@ -94,9 +97,18 @@ public:
   explicit PageTableWalker(champsim::ptw_builder builder);
 
   long operate() final;
+  [[nodiscard]] champsim::chrono::clock::time_point next_event() const final;
 
   void begin_phase() final;
   void print_deadlock() final;
+
+  /**
+   * Walk the page table at once, filling the paging structure caches and touching each entry through the given function.
+   */
+  response_type functional_access(const request_type& packet, const champsim::functional_access& lower);
+
+  void save_checkpoint(champsim::checkpoint_writer& writer) const;
+  void load_checkpoint(champsim::checkpoint_reader& reader);
 };
 
 #endif
@@ -3,6 +3,7 @@
 #include <list>
 #include <optional>
 #include <queue>
+#include <vector>
 
 #ifndef REG_ALLOC_H
 #define REG_ALLOC_H
@@ -23,6 +24,13 @@ private:
   std::queue<PHYSICAL_REGISTER_ID> free_registers;
   std::vector<physical_register> physical_register_file;
 
+  // The instructions waiting for each physical register to become valid
+  std::vector<std::vector<uint64_t>> consumers;
+  std::vector<uint64_t> woken;
+
+  // Incremented whenever an architectural register gains a mapping in the frontend RAT
+  uint64_t mapping_generation_ = 0;
+
 public:
   RegisterAllocator(size_t num_physical_registers);
   PHYSICAL_REGISTER_ID rename_dest_register(int16_t reg, champsim::program_ordered<ooo_model_instr>::id_type producer_id);
@@ -34,6 +42,31 @@ public:
   bool isAllocated(PHYSICAL_REGISTER_ID archreg) const;
   unsigned long count_free_registers() const;
   int count_reg_dependencies(const ooo_model_instr& instr) const;
+
+  /**
+   * Record that an instruction, identified by a value of the caller's choosing, is waiting for the physical register to become valid.
+   * When complete_dest_register() marks the register valid, the value is added to the list returned by woken_consumers().
+   */
+  void wait_for(PHYSICAL_REGISTER_ID physreg, uint64_t consumer);
+  [[nodiscard]] const std::vector<uint64_t>& woken_consumers() const { return woken; }
+  void clear_woken_consumers() { woken.clear(); }
+
+  /**
+   * A value that changes whenever isAllocated() may have changed from false to true for some register.
+   */
+  [[nodiscard]] uint64_t mapping_generation() const { return mapping_generation_; }
+
+  /**
+   * Forget the waiting instructions whose values are at least the given one, which the caller has squashed.
+   */
+  void squash_consumers(uint64_t first_squashed);
+
+  /**
+   * Map the architectural register written by the physical register to it again in the frontend RAT.
+   * After reset_frontend_RAT(), restoring the destinations of the instructions that remain in program order recovers the mapping they left.
+   */
+  void restore_dest_register(PHYSICAL_REGISTER_ID physreg);
+
   void reset_frontend_RAT();
   void print_deadlock();
 };
@@ -0,0 +1,67 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TAG_ARRAY_H
+#define TAG_ARRAY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace champsim
+{
+/**
+ * The tags of a set-associative array, stored contiguously by set, with a bitmask of the valid ways in each set.
+ *
+ * A set is searched by comparing all of its tags at once, with AVX2 or SSE4.1 if the simulator is compiled for them.
+ * Ways that are not valid keep the tag they were last given, so that they can still be found by find().
+ */
+class tag_array
+{
+  std::size_t num_way = 0;
+  std::size_t words_per_set = 0;
+  std::vector<uint64_t> tags{};
+  std::vector<uint64_t> valid_bits{};
+
+  [[nodiscard]] uint64_t match_mask(std::size_t set, std::size_t word, uint64_t tag) const;
+
+public:
+  tag_array() = default;
+  tag_array(std::size_t num_sets, std::size_t num_ways);
+
+  /**
+   * Set the tag and validity of the way at the given index, counting ways from the first way of the first set.
+   */
+  void assign(std::size_t index, uint64_t tag, bool valid);
+
+  /**
+   * The first valid way in the set with the given tag, or the number of ways if there is none.
+   */
+  [[nodiscard]] std::size_t find_valid(std::size_t set, uint64_t tag) const;
+
+  /**
+   * The first way in the set with the given tag, whether or not it is valid, or the number of ways if there is none.
+   */
+  [[nodiscard]] std::size_t find(std::size_t set, uint64_t tag) const;
+
+  /**
+   * The first way in the set that is not valid, or the number of ways if there is none.
+   */
+  [[nodiscard]] std::size_t find_invalid(std::size_t set) const;
+};
+} // namespace champsim
+
+#endif
@@ -0,0 +1,115 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRACE_INDEX_H
+#define TRACE_INDEX_H
+
+#include <cstdint>
+#include <fstream>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace champsim
+{
+/**
+ * A list of points in a compressed trace at which decompression can begin.
+ *
+ * For xz traces, every block of the first stream is a restart point. For gzip traces, the restart points are full-flush points, where the
+ * compressor discarded its history. Each point records the offset into the decompressed data at which it begins.
+ */
+struct trace_index {
+  enum class format_type { xz, gzip };
+
+  struct entry {
+    uint64_t uncompressed_offset = 0;
+    uint64_t compressed_offset = 0;
+
+    // For xz, the sizes of the block that begins here. For gzip, the CRC-32 and length of the data from here to the end of the trace.
+    uint64_t compressed_size = 0;
+    uint64_t uncompressed_size = 0;
+    uint32_t crc = 0;
+  };
+
+  format_type format = format_type::xz;
+  uint32_t check = 0;           // The xz integrity check type
+  uint64_t compressed_end = 0;  // The end of the compressed data, not including any trailer
+  std::vector<entry> entries{};
+
+  /**
+   * Find the last restart point at or before the given offset into the decompressed data.
+   */
+  [[nodiscard]] std::optional<entry> restart_point(uint64_t uncompressed_offset) const;
+};
+
+/**
+ * The name of the file that holds the index of the given trace.
+ */
+std::string trace_index_name(const std::string& trace_name);
+
+/**
+ * Scan a compressed trace and find its restart points.
+ * For gzip traces, points closer than ``spacing`` bytes of decompressed data to the previous point are not recorded.
+ * Throws a std::runtime_error if the trace is not in a format that can be indexed.
+ */
+trace_index build_trace_index(const std::string& trace_name, uint64_t spacing);
+
+void write_trace_index(std::ostream& out, const trace_index& index);
+trace_index read_trace_index(std::istream& in);
+
+/**
+ * Read the index of the given trace, if it has one.
+ */
+std::optional<trace_index> load_trace_index(const std::string& trace_name);
+
+/**
+ * A view of a compressed file that begins at a restart point.
+ *
+ * The bytes of the file from the restart point onward are framed by a synthesized header and trailer, so that they form a complete
+ * compressed stream. It has the subset of the std::istream interface that inf_istream uses.
+ */
+class spliced_ifstream
+{
+  std::ifstream file;
+  std::string prefix{};
+  std::string suffix{};
+  uint64_t file_remaining;
+  std::size_t prefix_pos = 0;
+  std::size_t suffix_pos = 0;
+  std::streamsize gcount_ = 0;
+  bool fail_ = false;
+
+public:
+  using char_type = char;
+
+  /**
+   * Read the entire file, unchanged.
+   */
+  explicit spliced_ifstream(const std::string& fname);
+
+  /**
+   * Read the file from the given restart point onward.
+   */
+  spliced_ifstream(const std::string& fname, const trace_index& index, const trace_index::entry& start);
+
+  spliced_ifstream& read(char* s, std::streamsize count);
+  [[nodiscard]] std::streamsize gcount() const { return gcount_; }
+  [[nodiscard]] bool fail() const { return fail_; }
+};
+} // namespace champsim
+
+#endif
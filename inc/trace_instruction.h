@@ -17,6 +17,7 @@
 #ifndef TRACE_INSTRUCTION_H
 #define TRACE_INSTRUCTION_H
 
+#include <cstddef>
 #include <limits>
 
 // special registers that help us identify branches
@@ -25,6 +26,10 @@ namespace champsim
 constexpr char REG_STACK_POINTER = 6;
 constexpr char REG_FLAGS = 25;
 constexpr char REG_INSTRUCTION_POINTER = 26;
+
+// the kinds of functional unit an instruction can execute on
+enum class op_class : unsigned char { unknown = 0, alu, slow_alu, fp, load, store, branch };
+constexpr std::size_t NUM_OP_CLASSES = 7;
 } // namespace champsim
 
 // instruction format
@@ -64,6 +69,27 @@ struct cloudsuite_instr {
 
   unsigned char asid[2];
 };
+
+// the standard format, followed by the class of the instruction
+struct op_class_instr {
+  // instruction pointer or PC (Program Counter)
+  unsigned long long ip;
+
+  // branch info
+  unsigned char is_branch;
+  unsigned char branch_taken;
+
+  unsigned char destination_registers[NUM_INSTR_DESTINATIONS]; // output registers
+  unsigned char source_registers[NUM_INSTR_SOURCES];           // input registers
+
+  unsigned long long destination_memory[NUM_INSTR_DESTINATIONS]; // output memory
+  unsigned long long source_memory[NUM_INSTR_SOURCES];           // input memory
+
+  unsigned char op_class; // a champsim::op_class
+};
 // NOLINTEND(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
 
+// A tracer can write either format from the same record
+static_assert(offsetof(op_class_instr, op_class) == sizeof(input_instr));
+
 #endif
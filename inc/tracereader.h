@@ -17,6 +17,9 @@
 #ifndef TRACEREADER_H
 #define TRACEREADER_H
 
+#include <algorithm>
+#include <array>
+#include <cassert>
 #include <cstring>
 #include <deque>
 #include <memory>
@@ -95,6 +98,11 @@ public:
   bulk_tracereader(uint8_t cpu_idx, F&& file) : cpu(cpu_idx), trace_file(std::move(file)) {}
 
   [[nodiscard]] bool eof() const { return trace_file.eof() && std::size(instr_buffer) <= refresh_thresh; }
+
+  /**
+   * Read and throw away the next bytes of the trace without decoding them. This may only be called before the first instruction is read.
+   */
+  void discard(uint64_t count);
 };
 
 ooo_model_instr apply_branch_target(ooo_model_instr branch, const ooo_model_instr& target);
@@ -132,15 +140,48 @@ ooo_model_instr bulk_tracereader<T, F>::operator()()
     set_branch_targets(std::begin(instr_buffer), std::end(instr_buffer));
   }
 
-  auto retval = instr_buffer.front();
+  auto retval = std::move(instr_buffer.front());
   instr_buffer.pop_front();
 
   return retval;
 }
 
+template <typename T, typename F>
+void bulk_tracereader<T, F>::discard(uint64_t count)
+{
+  assert(std::empty(instr_buffer));
+  std::array<char, buffer_size * sizeof(T)> discard_buf;
+  while (count > 0 && !trace_file.eof()) {
+    trace_file.read(std::data(discard_buf), static_cast<std::streamsize>(std::min<uint64_t>(count, std::size(discard_buf))));
+    if (trace_file.gcount() <= 0) {
+      break;
+    }
+    count -= static_cast<uint64_t>(trace_file.gcount());
+  }
+  eof_ = trace_file.eof();
+}
+
 std::string get_fptr_cmd(std::string_view fname);
+
+/**
+ * How get_tracereader() reads a trace.
+ */
+struct tracereader_options {
+  bool cloudsuite = false;        // Read the trace using the cloudsuite format
+  bool op_class = false;          // Read the trace using the format that records each instruction's op class
+  bool repeat = false;            // Restart the trace from the beginning when it ends
+  bool async = false;             // Decompress and decode the trace on a background thread
+  uint64_t skip_instructions = 0; // Begin this many instructions into the trace
+};
 } // namespace champsim
 
 champsim::tracereader get_tracereader(const std::string& fname, uint8_t cpu, bool is_cloudsuite, bool repeat);
 
+/**
+ * Open a trace with the given options.
+ * When instructions are skipped, the trace index is used to begin decompressing near the first instruction, if the trace has one.
+ * Otherwise, the skipped part of the trace is decompressed but not decoded. A repeated trace restarts from its beginning.
+ */
+champsim::tracereader get_tracereader(const std::string& fname, uint8_t cpu, const champsim::tracereader_options& options);
+
 #endif
@@ -0,0 +1,148 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UTIL_INLINE_VECTOR_H
+#define UTIL_INLINE_VECTOR_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+namespace champsim
+{
+/**
+ * A sequence container with the interface of std::vector, whose elements are stored inline in a fixed-capacity array.
+ *
+ * It never allocates, and it is trivially copyable if its element type is. Growing it beyond its capacity throws a std::length_error.
+ */
+template <typename T, std::size_t N>
+class inline_vector
+{
+  using storage_type = std::array<T, N>;
+  storage_type storage{};
+  std::size_t count = 0;
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using iterator = typename storage_type::iterator;
+  using const_iterator = typename storage_type::const_iterator;
+
+  constexpr inline_vector() = default;
+  constexpr inline_vector(std::initializer_list<T> init)
+  {
+    for (const auto& elem : init) {
+      push_back(elem);
+    }
+  }
+
+  [[nodiscard]] constexpr iterator begin() noexcept { return std::begin(storage); }
+  [[nodiscard]] constexpr const_iterator begin() const noexcept { return std::cbegin(storage); }
+  [[nodiscard]] constexpr const_iterator cbegin() const noexcept { return begin(); }
+  [[nodiscard]] constexpr iterator end() noexcept { return std::next(begin(), static_cast<difference_type>(count)); }
+  [[nodiscard]] constexpr const_iterator end() const noexcept { return std::next(begin(), static_cast<difference_type>(count)); }
+  [[nodiscard]] constexpr const_iterator cend() const noexcept { return end(); }
+
+  [[nodiscard]] constexpr size_type size() const noexcept { return count; }
+  [[nodiscard]] constexpr bool empty() const noexcept { return count == 0; }
+  [[nodiscard]] constexpr static size_type capacity() noexcept { return N; }
+  [[nodiscard]] constexpr static size_type max_size() noexcept { return N; }
+
+  [[nodiscard]] constexpr pointer data() noexcept { return std::data(storage); }
+  [[nodiscard]] constexpr const_pointer data() const noexcept { return std::data(storage); }
+
+  constexpr reference operator[](size_type pos)
+  {
+    assert(pos < count);
+    return storage[pos];
+  }
+  constexpr const_reference operator[](size_type pos) const
+  {
+    assert(pos < count);
+    return storage[pos];
+  }
+
+  constexpr reference at(size_type pos)
+  {
+    if (pos >= count) {
+      throw std::out_of_range{"inline_vector::at"};
+    }
+    return storage[pos];
+  }
+  constexpr const_reference at(size_type pos) const
+  {
+    if (pos >= count) {
+      throw std::out_of_range{"inline_vector::at"};
+    }
+    return storage[pos];
+  }
+
+  constexpr reference front() { return operator[](0); }
+  constexpr const_reference front() const { return operator[](0); }
+  constexpr reference back() { return operator[](count - 1); }
+  constexpr const_reference back() const { return operator[](count - 1); }
+
+  constexpr void push_back(const T& value) { emplace_back(value); }
+  constexpr void push_back(T&& value) { emplace_back(std::move(value)); }
+
+  template <typename... Args>
+  constexpr reference emplace_back(Args&&... args)
+  {
+    if (count >= N) {
+      throw std::length_error{"inline_vector capacity exceeded"};
+    }
+    storage[count] = T{std::forward<Args>(args)...};
+    return storage[count++];
+  }
+
+  constexpr void pop_back()
+  {
+    assert(count > 0);
+    --count;
+  }
+
+  constexpr void clear() noexcept { count = 0; }
+
+  constexpr iterator erase(const_iterator first, const_iterator last)
+  {
+    auto dest = std::next(begin(), std::distance(cbegin(), first));
+    auto src = std::next(begin(), std::distance(cbegin(), last));
+    auto new_end = std::move(src, end(), dest);
+    count = static_cast<size_type>(std::distance(begin(), new_end));
+    return dest;
+  }
+
+  constexpr iterator erase(const_iterator pos) { return erase(pos, std::next(pos)); }
+
+  friend constexpr bool operator==(const inline_vector& lhs, const inline_vector& rhs)
+  {
+    return std::equal(std::begin(lhs), std::end(lhs), std::begin(rhs), std::end(rhs));
+  }
+  friend constexpr bool operator!=(const inline_vector& lhs, const inline_vector& rhs) { return !(lhs == rhs); }
+};
+} // namespace champsim
+
+#endif
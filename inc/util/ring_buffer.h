@@ -0,0 +1,334 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UTIL_RING_BUFFER_H
+#define UTIL_RING_BUFFER_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace champsim
+{
+/**
+ * A sequence container with the interface of std::deque, whose elements are stored contiguously in a circular array.
+ *
+ * Elements are added at the back and removed from either end without allocating, as long as the size stays within the reserved capacity.
+ * Growing beyond the capacity reallocates, which invalidates all iterators and references. Otherwise, iterators remain valid until their
+ * element is removed.
+ */
+template <typename T>
+class ring_buffer
+{
+  using allocator_type = std::allocator<T>;
+  using alloc_traits = std::allocator_traits<allocator_type>;
+
+  allocator_type alloc{};
+  T* storage = nullptr;
+  std::size_t slots = 0; // a power of two
+  std::size_t head = 0;  // the position of the first element, counted from the last reallocation
+  std::size_t tail = 0;  // the position after the last element
+
+  template <bool Const>
+  class iterator_type
+  {
+    friend class ring_buffer;
+    template <bool>
+    friend class iterator_type;
+
+    T* base = nullptr;
+    std::size_t mask = 0;
+    std::size_t pos = 0;
+
+    iterator_type(T* base_, std::size_t mask_, std::size_t pos_) : base(base_), mask(mask_), pos(pos_) {}
+
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const T*, T*>;
+    using reference = std::conditional_t<Const, const T&, T&>;
+
+    iterator_type() = default;
+
+    template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+    iterator_type(const iterator_type<OtherConst>& other) : base(other.base), mask(other.mask), pos(other.pos) // NOLINT(google-explicit-constructor)
+    {
+    }
+
+    reference operator*() const { return base[pos & mask]; }
+    pointer operator->() const { return &base[pos & mask]; }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    iterator_type& operator++()
+    {
+      ++pos;
+      return *this;
+    }
+    iterator_type operator++(int)
+    {
+      auto retval = *this;
+      ++pos;
+      return retval;
+    }
+    iterator_type& operator--()
+    {
+      --pos;
+      return *this;
+    }
+    iterator_type operator--(int)
+    {
+      auto retval = *this;
+      --pos;
+      return retval;
+    }
+
+    iterator_type& operator+=(difference_type n)
+    {
+      pos += static_cast<std::size_t>(n);
+      return *this;
+    }
+    iterator_type& operator-=(difference_type n)
+    {
+      pos -= static_cast<std::size_t>(n);
+      return *this;
+    }
+
+    friend iterator_type operator+(iterator_type it, difference_type n) { return it += n; }
+    friend iterator_type operator+(difference_type n, iterator_type it) { return it += n; }
+    friend iterator_type operator-(iterator_type it, difference_type n) { return it -= n; }
+    friend difference_type operator-(const iterator_type& lhs, const iterator_type& rhs)
+    {
+      return static_cast<difference_type>(lhs.pos) - static_cast<difference_type>(rhs.pos);
+    }
+
+    friend bool operator==(const iterator_type& lhs, const iterator_type& rhs) { return lhs.pos == rhs.pos; }
+    friend bool operator!=(const iterator_type& lhs, const iterator_type& rhs) { return lhs.pos != rhs.pos; }
+    friend bool operator<(const iterator_type& lhs, const iterator_type& rhs) { return lhs.pos < rhs.pos; }
+    friend bool operator>(const iterator_type& lhs, const iterator_type& rhs) { return lhs.pos > rhs.pos; }
+    friend bool operator<=(const iterator_type& lhs, const iterator_type& rhs) { return lhs.pos <= rhs.pos; }
+    friend bool operator>=(const iterator_type& lhs, const iterator_type& rhs) { return lhs.pos >= rhs.pos; }
+  };
+
+  T* slot(std::size_t pos) const { return storage + (pos & (slots - 1)); }
+
+  void reallocate(std::size_t new_slots)
+  {
+    T* new_storage = alloc_traits::allocate(alloc, new_slots);
+    std::size_t count = 0;
+    for (auto pos = head; pos != tail; ++pos, ++count) {
+      alloc_traits::construct(alloc, new_storage + count, std::move_if_noexcept(*slot(pos)));
+      alloc_traits::destroy(alloc, slot(pos));
+    }
+
+    if (storage != nullptr) {
+      alloc_traits::deallocate(alloc, storage, slots);
+    }
+    storage = new_storage;
+    slots = new_slots;
+    head = 0;
+    tail = count;
+  }
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using iterator = iterator_type<false>;
+  using const_iterator = iterator_type<true>;
+
+  ring_buffer() = default;
+  ring_buffer(std::initializer_list<T> init)
+  {
+    reserve(std::size(init));
+    for (const auto& elem : init) {
+      push_back(elem);
+    }
+  }
+
+  ring_buffer(const ring_buffer& other)
+  {
+    reserve(other.size());
+    for (const auto& elem : other) {
+      push_back(elem);
+    }
+  }
+
+  ring_buffer(ring_buffer&& other) noexcept
+      : storage(std::exchange(other.storage, nullptr)), slots(std::exchange(other.slots, 0)), head(std::exchange(other.head, 0)),
+        tail(std::exchange(other.tail, 0))
+  {
+  }
+
+  ring_buffer& operator=(ring_buffer other) noexcept
+  {
+    std::swap(storage, other.storage);
+    std::swap(slots, other.slots);
+    std::swap(head, other.head);
+    std::swap(tail, other.tail);
+    return *this;
+  }
+
+  ~ring_buffer()
+  {
+    clear();
+    if (storage != nullptr) {
+      alloc_traits::deallocate(alloc, storage, slots);
+    }
+  }
+
+  [[nodiscard]] iterator begin() noexcept { return {storage, slots - 1, head}; }
+  [[nodiscard]] const_iterator begin() const noexcept { return {storage, slots - 1, head}; }
+  [[nodiscard]] const_iterator cbegin() const noexcept { return begin(); }
+  [[nodiscard]] iterator end() noexcept { return {storage, slots - 1, tail}; }
+  [[nodiscard]] const_iterator end() const noexcept { return {storage, slots - 1, tail}; }
+  [[nodiscard]] const_iterator cend() const noexcept { return end(); }
+
+  [[nodiscard]] size_type size() const noexcept { return tail - head; }
+  [[nodiscard]] bool empty() const noexcept { return tail == head; }
+  [[nodiscard]] size_type capacity() const noexcept { return slots; }
+
+  /**
+   * Ensure that at least the given number of elements can be held without reallocating.
+   */
+  void reserve(size_type new_cap)
+  {
+    if (new_cap > slots) {
+      size_type new_slots = 1;
+      while (new_slots < new_cap) {
+        new_slots <<= 1;
+      }
+      reallocate(new_slots);
+    }
+  }
+
+  reference operator[](size_type pos)
+  {
+    assert(pos < size());
+    return *slot(head + pos);
+  }
+  const_reference operator[](size_type pos) const
+  {
+    assert(pos < size());
+    return *slot(head + pos);
+  }
+
+  reference at(size_type pos)
+  {
+    if (pos >= size()) {
+      throw std::out_of_range{"ring_buffer::at"};
+    }
+    return *slot(head + pos);
+  }
+  const_reference at(size_type pos) const
+  {
+    if (pos >= size()) {
+      throw std::out_of_range{"ring_buffer::at"};
+    }
+    return *slot(head + pos);
+  }
+
+  reference front() { return operator[](0); }
+  const_reference front() const { return operator[](0); }
+  reference back() { return operator[](size() - 1); }
+  const_reference back() const { return operator[](size() - 1); }
+
+  void push_back(const T& value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+
+  template <typename... Args>
+  reference emplace_back(Args&&... args)
+  {
+    if (size() == slots) {
+      // The arguments may refer to an element, so the new element is made before the storage moves
+      T value{std::forward<Args>(args)...};
+      reallocate(std::max<size_type>(2 * slots, 1));
+      alloc_traits::construct(alloc, slot(tail), std::move(value));
+    } else {
+      alloc_traits::construct(alloc, slot(tail), std::forward<Args>(args)...);
+    }
+    ++tail;
+    return back();
+  }
+
+  void pop_front()
+  {
+    assert(!empty());
+    alloc_traits::destroy(alloc, slot(head));
+    ++head;
+  }
+
+  void pop_back()
+  {
+    assert(!empty());
+    --tail;
+    alloc_traits::destroy(alloc, slot(tail));
+  }
+
+  void clear() noexcept
+  {
+    while (!empty()) {
+      pop_back();
+    }
+  }
+
+  template <typename InputIt>
+  iterator insert(const_iterator pos, InputIt first, InputIt last)
+  {
+    auto offset = std::distance(cbegin(), pos);
+    auto old_size = static_cast<difference_type>(size());
+    for (; first != last; ++first) {
+      emplace_back(*first);
+    }
+    std::rotate(std::next(begin(), offset), std::next(begin(), old_size), end());
+    return std::next(begin(), offset);
+  }
+
+  iterator erase(const_iterator first, const_iterator last)
+  {
+    if (first.pos == head) {
+      // Removing from the front does not move any element
+      while (head != last.pos) {
+        pop_front();
+      }
+      return begin();
+    }
+
+    auto dest = first.pos;
+    for (auto src = last.pos; src != tail; ++src, ++dest) {
+      *slot(dest) = std::move(*slot(src));
+    }
+    while (tail != dest) {
+      pop_back();
+    }
+    return {storage, slots - 1, first.pos};
+  }
+
+  iterator erase(const_iterator pos) { return erase(pos, std::next(pos)); }
+};
+} // namespace champsim
+
+#endif
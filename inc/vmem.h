@@ -19,12 +19,15 @@
 
 #include <cstdint>
 #include <deque>
+#include <functional>
 #include <map>
 #include <optional>
 #include <random>
+#include <vector>
 
 #include "address.h"
 #include "champsim.h"
+#include "checkpoint.h"
 #include "chrono.h"
 
 class MEMORY_CONTROLLER;
@@ -37,7 +40,7 @@ private:
   std::map<std::pair<uint32_t, champsim::page_number>, champsim::page_number> vpage_to_ppage_map;
   std::map<std::tuple<uint32_t, uint32_t, champsim::address_slice<champsim::dynamic_extent>>, champsim::address> page_table;
   std::optional<uint64_t> randomization_seed;
-  MEMORY_CONTROLLER& dram;
+  std::vector<std::reference_wrapper<MEMORY_CONTROLLER>> dram;
 
 public:
   const champsim::chrono::clock::duration minor_fault_penalty;
@@ -66,14 +69,17 @@ public:
    * :param page_table_page_size: The size of one page table page. This value must be less than the size of a physical page.
    * :param page_table_levels: The number of levels in the virtual memory table hierarchy.
    * :param minor_penalty: The latency of a minor page fault.
-   * :param dram: The physical memory of the system.
-   *   This is currently only used to issue a warning if the physical memory is smaller than the virtual memory.
+   * :param dram: The physical memory of the system, as one or more memory controllers.
+   *   Physical pages are allocated from the address ranges of the controllers, and a warning is issued if the physical memory is smaller than the virtual
+   *   memory.
    *   Future versions may perform major page faults through this reference.
    */
   VirtualMemory(champsim::data::bytes page_table_page_size, std::size_t page_table_levels, champsim::chrono::clock::duration minor_penalty,
                 MEMORY_CONTROLLER& dram_);
   VirtualMemory(champsim::data::bytes page_table_page_size, std::size_t page_table_levels, champsim::chrono::clock::duration minor_penalty,
                 MEMORY_CONTROLLER& dram_, std::optional<uint64_t> randomization_seed_);
+  VirtualMemory(champsim::data::bytes page_table_page_size, std::size_t page_table_levels, champsim::chrono::clock::duration minor_penalty,
+                std::vector<std::reference_wrapper<MEMORY_CONTROLLER>> dram_, std::optional<uint64_t> randomization_seed_);
 
   /**
    * Find the bit location of the lowest bit for the given page table level.
@@ -118,6 +124,12 @@ public:
    * :returns: A pair of the page table page address and the latency to be applied to the operation.
    */
   std::pair<champsim::address, champsim::chrono::clock::duration> get_pte_pa(uint32_t cpu_num, champsim::page_number vaddr, std::size_t level);
+
+  /**
+   * Save the translations, the page table pages, and the list of free physical pages.
+   */
+  void save_checkpoint(champsim::checkpoint_writer& writer) const;
+  void load_checkpoint(champsim::checkpoint_reader& reader);
 };
 
 #endif
@@ -75,6 +75,7 @@ public:
 
   bool is_ready_at(time_type cycle) const;
   bool has_unknown_readiness() const;
+  time_type ready_time() const;
 
   auto& operator*();
   auto& operator*() const;
@@ -128,6 +129,12 @@ bool champsim::waitable<T>::is_ready_at(time_type cycle) const
   return event_cycle.value_or(time_sentinel) <= cycle;
 }
 
+template <typename T>
+auto champsim::waitable<T>::ready_time() const -> time_type
+{
+  return event_cycle.value_or(time_sentinel);
+}
+
 template <typename T>
 bool champsim::waitable<T>::has_unknown_readiness() const
 {
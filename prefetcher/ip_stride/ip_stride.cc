@@ -57,3 +57,15 @@ uint32_t ip_stride::prefetcher_cache_fill(champsim::address addr, long set, long
 {
   return metadata_in;
 }
+
+void ip_stride::save_checkpoint(champsim::checkpoint_writer& writer) const
+{
+  writer.write(active_lookahead);
+  writer.write(table);
+}
+
+void ip_stride::load_checkpoint(champsim::checkpoint_reader& reader)
+{
+  reader.read(active_lookahead);
+  reader.read(table);
+}
@@ -12,3 +12,8 @@ uint32_t next_line::prefetcher_cache_fill(champsim::address addr, long set, long
 {
   return metadata_in;
 }
+
+// This prefetcher has no state
+void next_line::save_checkpoint(champsim::checkpoint_writer&) const {}
+
+void next_line::load_checkpoint(champsim::checkpoint_reader&) {}
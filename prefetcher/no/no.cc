@@ -11,3 +11,8 @@ uint32_t no::prefetcher_cache_fill(champsim::address addr, long set, long way, u
 {
   return metadata_in;
 }
+
+// This prefetcher has no state
+void no::save_checkpoint(champsim::checkpoint_writer&) const {}
+
+void no::load_checkpoint(champsim::checkpoint_reader&) {}
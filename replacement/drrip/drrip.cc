@@ -78,3 +78,17 @@ long drrip::find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, co
   assert(victim < end);
   return std::distance(begin, victim); // cast protected by assertions
 }
+
+void drrip::save_checkpoint(champsim::checkpoint_writer& writer) const
+{
+  writer.write(brrip_counter);
+  writer.write(rrpv);
+  writer.write(PSEL);
+}
+
+void drrip::load_checkpoint(champsim::checkpoint_reader& reader)
+{
+  reader.read(brrip_counter);
+  reader.read(rrpv);
+  reader.read(PSEL);
+}
@@ -34,3 +34,15 @@ void lru::update_replacement_state(uint32_t triggering_cpu, long set, long way,
   if (hit && access_type{type} != access_type::WRITE) // Skip this for writeback hits
     last_used_cycles.at((std::size_t)(set * NUM_WAY + way)) = cycle++;
 }
+
+void lru::save_checkpoint(champsim::checkpoint_writer& writer) const
+{
+  writer.write(last_used_cycles);
+  writer.write(cycle);
+}
+
+void lru::load_checkpoint(champsim::checkpoint_reader& reader)
+{
+  reader.read(last_used_cycles);
+  reader.read(cycle);
+}
@@ -44,3 +44,19 @@ long srrip_set_helper::victim()
 }
 
 void srrip_set_helper::update(long way, bool hit) { get_rrpv(way) = hit ? 0 : (maxRRPV - 1); }
+
+void srrip::save_checkpoint(champsim::checkpoint_writer& writer) const
+{
+  writer.write(static_cast<uint64_t>(std::size(sets)));
+  for (const auto& set : sets) {
+    writer.write(set.rrpv_values);
+  }
+}
+
+void srrip::load_checkpoint(champsim::checkpoint_reader& reader)
+{
+  reader.expect(static_cast<uint64_t>(std::size(sets)), "the number of sets in the SRRIP state");
+  for (auto& set : sets) {
+    reader.read(set.rrpv_values);
+  }
+}
@@ -33,6 +33,9 @@ struct srrip : public champsim::modules::replacement {
   void update_replacement_state(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip, champsim::address victim_addr,
                                 access_type type, uint8_t hit);
 
+  void save_checkpoint(champsim::checkpoint_writer& writer) const;
+  void load_checkpoint(champsim::checkpoint_reader& reader);
+
   // use this function to print out your own stats at the end of simulation
   // void replacement_final_stats() {}
 };
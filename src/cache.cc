@@ -38,9 +38,9 @@ CACHE::CACHE(CACHE&& other)
       upper_levels(std::move(other.upper_levels)), lower_level(std::move(other.lower_level)), lower_translate(std::move(other.lower_translate)),
 
       cpu(other.cpu), NAME(std::move(other.NAME)), NUM_SET(other.NUM_SET), NUM_WAY(other.NUM_WAY), MSHR_SIZE(other.MSHR_SIZE), PQ_SIZE(other.PQ_SIZE),
-      HIT_LATENCY(other.HIT_LATENCY), FILL_LATENCY(other.FILL_LATENCY), OFFSET_BITS(other.OFFSET_BITS), block(std::move(other.block)), MAX_TAG(other.MAX_TAG),
-      MAX_FILL(other.MAX_FILL), prefetch_as_load(other.prefetch_as_load), match_offset_bits(other.match_offset_bits), virtual_prefetch(other.virtual_prefetch),
-      pref_activate_mask(std::move(other.pref_activate_mask)),
+      HIT_LATENCY(other.HIT_LATENCY), FILL_LATENCY(other.FILL_LATENCY), OFFSET_BITS(other.OFFSET_BITS), block(std::move(other.block)),
+      block_tags(std::move(other.block_tags)), MAX_TAG(other.MAX_TAG), MAX_FILL(other.MAX_FILL), prefetch_as_load(other.prefetch_as_load),
+      match_offset_bits(other.match_offset_bits), virtual_prefetch(other.virtual_prefetch), pref_activate_mask(std::move(other.pref_activate_mask)),
 
       sim_stats(std::move(other.sim_stats)), roi_stats(std::move(other.roi_stats)),
 
@@ -73,6 +73,7 @@ auto CACHE::operator=(CACHE&& other) -> CACHE&
   this->OFFSET_BITS = other.OFFSET_BITS;
   ;
   this->block = std::move(other.block);
+  this->block_tags = std::move(other.block_tags);
   this->MAX_TAG = other.MAX_TAG;
   this->MAX_FILL = other.MAX_FILL;
   this->prefetch_as_load = other.prefetch_as_load;
@@ -159,6 +160,45 @@ auto CACHE::matches_address(champsim::address addr) const
   };
 }
 
+uint64_t CACHE::block_key(champsim::address addr) const { return addr.slice_upper(OFFSET_BITS).to<uint64_t>(); }
+
+auto CACHE::find_fill(std::deque<fill_type>& queue, const fill_index_type& index, champsim::address addr) const -> std::deque<fill_type>::iterator
+{
+  auto found = index.entries.find(block_key(addr));
+  if (found == std::end(index.entries)) {
+    return std::end(queue);
+  }
+  return std::next(std::begin(queue), static_cast<std::ptrdiff_t>(found->second.first - index.head_position));
+}
+
+void CACHE::index_push_back(fill_index_type& index, const std::deque<fill_type>& queue) const
+{
+  assert(!std::empty(queue));
+  auto position = index.head_position + std::size(queue) - 1;
+  auto [found, inserted] = index.entries.try_emplace(block_key(queue.back().address), position, 1);
+  if (!inserted) {
+    ++found->second.second;
+  }
+}
+
+void CACHE::index_pop_front(fill_index_type& index, const std::deque<fill_type>& queue) const
+{
+  assert(!std::empty(queue));
+  auto found = index.entries.find(block_key(queue.front().address));
+  assert(found != std::end(index.entries));
+  assert(found->second.first == index.head_position);
+
+  if (--found->second.second == 0) {
+    index.entries.erase(found);
+  } else {
+    // Another entry for the same block remains, so the next one becomes the oldest
+    auto next = std::find_if(std::next(std::begin(queue)), std::end(queue), matches_address(queue.front().address));
+    assert(next != std::end(queue));
+    found->second.first = index.head_position + static_cast<uint64_t>(std::distance(std::begin(queue), next));
+  }
+  ++index.head_position;
+}
+
 template <typename T>
 champsim::address CACHE::module_address(const T& element) const
 {
@@ -172,7 +212,8 @@ bool CACHE::handle_fill(const fill_type& fill)
 
   // find victim
   auto [set_begin, set_end] = get_set_span(fill.address);
-  auto way = std::find_if_not(set_begin, set_end, [](auto x) { return x.valid; });
+  const auto set_idx = static_cast<std::size_t>(get_set_index(fill.address));
+  auto way = std::next(set_begin, static_cast<set_type::difference_type>(block_tags.find_invalid(set_idx)));
   if (way == set_end) {
     way = std::next(set_begin, impl_find_victim(fill.cpu, fill.instr_id, get_set_index(fill.address), &*set_begin, fill.ip, fill.address, fill.type));
   }
@@ -229,6 +270,7 @@ bool CACHE::handle_fill(const fill_type& fill)
     }
 
     *way = fill_block(fill, metadata_thru);
+    update_tags(way);
   }
 
   // COLLECT STATS
@@ -250,7 +292,8 @@ bool CACHE::try_hit(const tag_lookup_type& handle_pkt)
 
   // access cache
   auto [set_begin, set_end] = get_set_span(handle_pkt.address);
-  auto way = std::find_if(set_begin, set_end, [matcher = matches_address(handle_pkt.address)](const auto& x) { return x.valid && matcher(x); });
+  const auto set_idx = static_cast<std::size_t>(get_set_index(handle_pkt.address));
+  auto way = std::next(set_begin, static_cast<set_type::difference_type>(block_tags.find_valid(set_idx, block_key(handle_pkt.address))));
   const auto hit = (way != set_end);
   const auto useful_prefetch = (hit && way->prefetch && !handle_pkt.prefetch_from_this);
 
@@ -329,12 +372,12 @@ bool CACHE::handle_miss(const tag_lookup_type& handle_pkt)
   auto mshr_pkt = mshr_and_forward_packet(handle_pkt);
 
   // check mshr
-  auto fill_entry = std::find_if(std::begin(MSHR), std::end(MSHR), matches_address(handle_pkt.address));
+  auto fill_entry = find_fill(MSHR, mshr_index, handle_pkt.address);
   bool mshr_full = (MSHR.size() == MSHR_SIZE);
 
   // check inflight fills
   if (fill_entry == MSHR.end()) {
-    fill_entry = std::find_if(inflight_fills.begin(), inflight_fills.end(), matches_address(handle_pkt.address));
+    fill_entry = find_fill(inflight_fills, inflight_fills_index, handle_pkt.address);
   }
 
   if (fill_entry != inflight_fills.end()) // miss or fill already inflight
@@ -365,6 +408,7 @@ bool CACHE::handle_miss(const tag_lookup_type& handle_pkt)
     // Allocate an MSHR
     if (mshr_pkt.second.response_requested) {
       MSHR.emplace_back(std::move(mshr_pkt.first));
+      index_push_back(mshr_index, MSHR);
     }
   }
 
@@ -384,12 +428,87 @@ bool CACHE::handle_write(const tag_lookup_type& handle_pkt)
   fill_type to_allocate{handle_pkt, current_time};
   to_allocate.data_promise.ready_at(current_time + (warmup ? champsim::chrono::clock::duration{} : FILL_LATENCY));
   inflight_fills.push_back(to_allocate);
+  index_push_back(inflight_fills_index, inflight_fills);
 
   sim_stats.misses.increment(std::pair{handle_pkt.type, handle_pkt.cpu});
 
   return true;
 }
 
+auto CACHE::functional_access(const request_type& packet, const champsim::functional_access& lower) -> response_type
+{
+  auto response = functional_lookup(tag_lookup_type{packet}, lower);
+  impl_prefetcher_cycle_operate();
+
+  // Serve the prefetches that the access issued, and any that they issue in turn
+  while (!std::empty(internal_PQ)) {
+    auto pf_packet = internal_PQ.front();
+    internal_PQ.pop_front();
+    functional_lookup(pf_packet, lower);
+  }
+
+  return response;
+}
+
+auto CACHE::functional_lookup(tag_lookup_type handle_pkt, const champsim::functional_access& lower) -> response_type
+{
+  if (!handle_pkt.is_translated) {
+    request_type translation_packet;
+    translation_packet.asid[0] = handle_pkt.asid[0];
+    translation_packet.asid[1] = handle_pkt.asid[1];
+    translation_packet.type = access_type::LOAD;
+    translation_packet.cpu = handle_pkt.cpu;
+    translation_packet.address = handle_pkt.address;
+    translation_packet.v_address = handle_pkt.v_address;
+    translation_packet.data = handle_pkt.data;
+    translation_packet.instr_id = handle_pkt.instr_id;
+    translation_packet.ip = handle_pkt.ip;
+    translation_packet.is_translated = true;
+
+    auto translation = lower(lower_translate, translation_packet);
+    handle_pkt.address = champsim::address{champsim::splice(champsim::page_number{translation.data}, champsim::page_offset{handle_pkt.v_address})};
+    handle_pkt.is_translated = true;
+  }
+
+  // Hits and fills report to the access through its own return queue
+  std::deque<response_type> returned{};
+  handle_pkt.to_return = {&returned};
+  response_type response{handle_pkt.address, handle_pkt.v_address, handle_pkt.data, handle_pkt.pf_metadata, handle_pkt.instr_depend_on_me};
+
+  if (!try_hit(handle_pkt)) {
+    if (handle_pkt.type == access_type::WRITE && !match_offset_bits) {
+      functional_fill(fill_type{handle_pkt, current_time}, lower); // Treat writes (that is, writebacks) like fills
+    } else {
+      auto [to_allocate, fwd_pkt] = mshr_and_forward_packet(handle_pkt);
+      response = lower(lower_level, fwd_pkt);
+      if (fwd_pkt.response_requested) {
+        to_allocate.data_promise = champsim::waitable{fill_type::returned_value{response.data, response.pf_metadata}, current_time};
+        functional_fill(to_allocate, lower);
+      }
+    }
+
+    sim_stats.misses.increment(std::pair{handle_pkt.type, handle_pkt.cpu});
+  }
+
+  if (!std::empty(returned)) {
+    response = returned.front();
+  }
+  return response;
+}
+
+void CACHE::functional_fill(const fill_type& fill, const champsim::functional_access& lower)
+{
+  [[maybe_unused]] auto filled = handle_fill(fill);
+  assert(filled);
+
+  // The fill may have queued the writeback of a dirty victim
+  while (!std::empty(lower_level->WQ)) {
+    auto writeback_packet = lower_level->WQ.front();
+    lower_level->WQ.pop_front();
+    lower(lower_level, writeback_packet);
+  }
+}
+
 template <bool UpdateRequest>
 auto CACHE::initiate_tag_check(champsim::channel* ul)
 {
@@ -442,8 +561,12 @@ long CACHE::operate()
   auto [fill_begin, fill_end] = champsim::get_span_p(std::cbegin(inflight_fills), std::cend(inflight_fills), fill_bw,
                                                      [time = current_time](const auto& x) { return x.data_promise.is_ready_at(time); });
   auto complete_end = std::find_if_not(fill_begin, fill_end, [this](const auto& x) { return this->handle_fill(x); });
-  fill_bw.consume(std::distance(fill_begin, complete_end));
-  inflight_fills.erase(fill_begin, complete_end);
+  auto fills_complete = std::distance(fill_begin, complete_end);
+  fill_bw.consume(fills_complete);
+  for (; fills_complete > 0; --fills_complete) {
+    index_pop_front(inflight_fills_index, inflight_fills);
+    inflight_fills.pop_front();
+  }
 
   // Initiate tag checks
   const champsim::bandwidth::maximum_type bandwidth_from_tag_checks{champsim::to_underlying(MAX_TAG) * (long)(HIT_LATENCY / clock_period)
@@ -521,6 +644,48 @@ long CACHE::operate()
   return progress + fill_bw.amount_consumed() + initiate_tag_bw.amount_consumed() + tag_check_bw.amount_consumed();
 }
 
+champsim::chrono::clock::time_point CACHE::next_event() const
+{
+  auto next_cycle = current_time + clock_period;
+  if (pref_module_pimpl->impl_prefetcher_has_cycle_operate()) {
+    return next_cycle;
+  }
+
+  // Work that is waiting on this cache alone
+  auto untranslated = [](const auto& entry) {
+    return !entry.is_translated && !entry.translate_issued;
+  };
+  auto queues_empty = [](const auto* ul) {
+    return std::empty(ul->RQ) && std::empty(ul->WQ) && std::empty(ul->PQ);
+  };
+  if (!std::empty(lower_level->returned) || (lower_translate != nullptr && !std::empty(lower_translate->returned)) || !std::empty(internal_PQ)
+      || !std::all_of(std::cbegin(upper_levels), std::cend(upper_levels), queues_empty)
+      || std::any_of(std::cbegin(translation_stash), std::cend(translation_stash), [](const auto& entry) { return entry.is_translated; })
+      || std::any_of(std::cbegin(translation_stash), std::cend(translation_stash), untranslated)
+      || std::any_of(std::cbegin(inflight_tag_check), std::cend(inflight_tag_check), untranslated)) {
+    return next_cycle;
+  }
+
+  // Work that becomes ready at a known time
+  auto next = champsim::chrono::clock::time_point::max();
+  for (const auto& fill : inflight_fills) {
+    next = std::min(next, fill.data_promise.ready_time());
+  }
+  for (const auto& entry : inflight_tag_check) {
+    next = std::min(next, entry.event_cycle);
+  }
+  return std::max(next, next_cycle);
+}
+
+void CACHE::skip_cycles(long count)
+{
+  // Reproduce the rotation that operate() performs every cycle
+  if (std::size(upper_levels) > 1) {
+    auto shift = count % static_cast<long>(std::size(upper_levels));
+    std::rotate(upper_levels.begin(), upper_levels.begin() + shift, upper_levels.end());
+  }
+}
+
 // LCOV_EXCL_START exclude deprecated function
 uint64_t CACHE::get_set(uint64_t address) const { return static_cast<uint64_t>(get_set_index(champsim::address{address})); }
 // LCOV_EXCL_STOP
@@ -534,6 +699,11 @@ std::pair<It, It> get_span(It anchor, typename std::iterator_traits<It>::differe
   return {std::move(begin), std::next(begin, num_way)};
 }
 
+void CACHE::update_tags(set_type::const_iterator way)
+{
+  block_tags.assign(static_cast<std::size_t>(std::distance(std::cbegin(block), way)), block_key(way->address), way->valid);
+}
+
 auto CACHE::get_set_span(champsim::address address) -> std::pair<set_type::iterator, set_type::iterator>
 {
   const auto set_idx = get_set_index(address);
@@ -560,10 +730,12 @@ uint64_t CACHE::get_way(uint64_t address, uint64_t /*unused set index*/) const
 long CACHE::invalidate_entry(champsim::address inval_addr)
 {
   auto [begin, end] = get_set_span(inval_addr);
-  auto inv_way = std::find_if(begin, end, matches_address(inval_addr));
+  const auto set_idx = static_cast<std::size_t>(get_set_index(inval_addr));
+  auto inv_way = std::next(begin, static_cast<set_type::difference_type>(block_tags.find(set_idx, block_key(inval_addr))));
 
   if (inv_way != end) {
     inv_way->valid = false;
+    update_tags(inv_way);
   }
 
   return std::distance(begin, inv_way);
@@ -606,7 +778,7 @@ bool CACHE::prefetch_line(uint64_t /*deprecated*/, uint64_t /*deprecated*/, uint
 void CACHE::finish_packet(const response_type& packet)
 {
   // check MSHR information
-  auto mshr_entry = std::find_if(std::begin(MSHR), std::end(MSHR), matches_address(packet.address));
+  auto mshr_entry = find_fill(MSHR, mshr_index, packet.address);
 
   // sanity check
   if (mshr_entry == MSHR.end()) {
@@ -622,8 +794,15 @@ void CACHE::finish_packet(const response_type& packet)
                mshr_entry->data_promise->data, access_type_names.at(champsim::to_underlying(mshr_entry->type)), current_time.time_since_epoch() / clock_period);
   }
 
+  // Each block has at most one entry in the MSHR, so swapping two entries only exchanges their positions in the index
+  auto mshr_position = mshr_index.head_position + static_cast<uint64_t>(std::distance(std::begin(MSHR), mshr_entry));
   std::iter_swap(mshr_entry, std::begin(MSHR));
+  mshr_index.entries.at(block_key(mshr_entry->address)).first = mshr_position;
+  mshr_index.entries.at(block_key(MSHR.front().address)).first = mshr_index.head_position;
+
   inflight_fills.push_back(MSHR.front());
+  index_push_back(inflight_fills_index, inflight_fills);
+  index_pop_front(mshr_index, MSHR);
   MSHR.pop_front();
 }
 
@@ -838,6 +1017,41 @@ void CACHE::initialize()
   impl_initialize_replacement();
 }
 
+void CACHE::check_checkpoint_support() const
+{
+  if (!pref_module_pimpl->impl_prefetcher_has_checkpoint()) {
+    throw champsim::checkpoint_error{"The prefetcher of " + NAME + " does not support checkpoints"};
+  }
+  if (!repl_module_pimpl->impl_replacement_has_checkpoint()) {
+    throw champsim::checkpoint_error{"The replacement policy of " + NAME + " does not support checkpoints"};
+  }
+}
+
+void CACHE::save_checkpoint(champsim::checkpoint_writer& writer) const
+{
+  check_checkpoint_support();
+  writer.begin_section(NAME);
+  writer.write(NUM_SET);
+  writer.write(NUM_WAY);
+  writer.write(block);
+  pref_module_pimpl->impl_prefetcher_save_checkpoint(writer);
+  repl_module_pimpl->impl_replacement_save_checkpoint(writer);
+}
+
+void CACHE::load_checkpoint(champsim::checkpoint_reader& reader)
+{
+  check_checkpoint_support();
+  reader.begin_section(NAME);
+  reader.expect(NUM_SET, "the number of sets in " + NAME);
+  reader.expect(NUM_WAY, "the number of ways in " + NAME);
+  reader.read(block);
+  for (auto way = std::cbegin(block); way != std::cend(block); ++way) {
+    update_tags(way);
+  }
+  pref_module_pimpl->impl_prefetcher_load_checkpoint(reader);
+  repl_module_pimpl->impl_replacement_load_checkpoint(reader);
+}
+
 void CACHE::begin_phase()
 {
   stats_type new_roi_stats;
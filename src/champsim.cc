@@ -18,13 +18,18 @@
 
 #include <algorithm>
 #include <chrono>
+#include <fstream>
+#include <memory>
 #include <numeric>
 #include <vector>
 #include <fmt/chrono.h>
 #include <fmt/core.h>
 
+#include "checkpoint.h"
+#include "core_parallel.h"
 #include "environment.h"
 #include "event_listeners.h"
+#include "functional_warmup.h"
 #include "ooo_cpu.h"
 #include "operable.h"
 #include "phase_info.h"
@@ -61,7 +66,43 @@ long do_cycle(environment& env, std::vector<tracereader>& traces, std::vector<st
   return progress;
 }
 
-phase_stats do_phase(const phase_info& phase, environment& env, std::vector<tracereader>& traces, champsim::chrono::clock& global_clock)
+/**
+ * If no operable can change state within the next tick of the global clock, advance the clock to the tick just before the earliest event.
+ * Returns the number of ticks skipped.
+ */
+long skip_idle_cycles(environment& env, champsim::chrono::clock& global_clock, champsim::chrono::clock::duration time_quantum)
+{
+  auto operables = env.operable_view();
+
+  auto next_tick = champsim::chrono::clock::time_point::max();
+  for (const champsim::operable& op : operables) {
+    auto event = op.next_event();
+    if (event != champsim::chrono::clock::time_point::max()) {
+      // The first cycle of this operable that does something, and the tick that would operate it
+      auto active_cycle =
+          op.current_time + ((event - op.current_time + op.clock_period - champsim::chrono::picoseconds{1}) / op.clock_period) * op.clock_period;
+      auto active_tick = champsim::chrono::clock::time_point{} + ((active_cycle - op.clock_period).time_since_epoch() / time_quantum + 1) * time_quantum;
+      next_tick = std::min(next_tick, active_tick);
+    }
+  }
+
+  if (next_tick == champsim::chrono::clock::time_point::max() || next_tick - time_quantum <= global_clock.now()) {
+    return 0;
+  }
+
+  auto skipped = next_tick - time_quantum - global_clock.now();
+  global_clock.tick(skipped);
+  for (champsim::operable& op : operables) {
+    op.skip_to(global_clock);
+  }
+
+  return skipped / time_quantum;
+}
+
+phase_stats collect_phase_stats(const phase_info& phase, environment& env);
+
+phase_stats do_phase(const phase_info& phase, environment& env, std::vector<tracereader>& traces, champsim::chrono::clock& global_clock,
+                     core_parallel_engine* parallel_engine)
 {
   auto operables = env.operable_view();
   auto [phase_name, is_warmup, length, trace_index, trace_names] = phase;
@@ -75,6 +116,9 @@ phase_stats do_phase(const phase_info& phase, environment& env, std::vector<trac
   const auto time_quantum = std::accumulate(std::cbegin(operables), std::cend(operables), champsim::chrono::clock::duration::max(),
                                             [](const auto acc, const operable& y) { return std::min(acc, y.clock_period); });
 
+  // In parallel mode, each iteration advances the clock by a full synchronization quantum
+  const long cycles_per_step = (parallel_engine == nullptr) ? 1 : parallel_engine->quantum();
+
   bool livelock_trigger{false};
   uint64_t livelock_period{10000000};
   uint64_t livelock_timer{0};
@@ -87,18 +131,29 @@ phase_stats do_phase(const phase_info& phase, environment& env, std::vector<trac
   std::vector<bool> phase_complete(std::size(env.cpu_view()), false);
   while (!std::accumulate(std::begin(phase_complete), std::end(phase_complete), true, std::logical_and{})) {
     auto next_phase_complete = phase_complete;
-    global_clock.tick(time_quantum);
+    global_clock.tick(time_quantum * cycles_per_step);
 
-    auto progress = do_cycle(env, traces, trace_index, global_clock);
+    long progress{0};
+    if (parallel_engine == nullptr) {
+      progress = do_cycle(env, traces, trace_index, global_clock);
+    } else {
+      progress = parallel_engine->do_quantum(traces, trace_index, global_clock, time_quantum);
+    }
 
     if (progress == 0) {
-      ++stalled_cycle;
+      stalled_cycle += static_cast<int>(cycles_per_step);
     } else {
       stalled_cycle = 0;
     }
 
+    // Jump over cycles in which every operable would only wait. Waiting on a known event is not a deadlock, so these are not counted as stalled.
+    long skipped_cycles{0};
+    if (progress == 0 && cycles_per_step == 1) {
+      skipped_cycles = skip_idle_cycles(env, global_clock, time_quantum);
+    }
+
     // Livelock detect, every livelock_period cycles, check progress and alert the user
-    livelock_timer++;
+    livelock_timer += static_cast<uint64_t>(cycles_per_step + skipped_cycles);
     if (livelock_timer >= livelock_period) {
       // for each cpu
       for (O3_CPU& cpu : env.cpu_view()) {
@@ -157,11 +212,16 @@ phase_stats do_phase(const phase_info& phase, environment& env, std::vector<trac
                cpu.sim_instr(), cpu.sim_cycle(), std::ceil(cpu.sim_instr()) / std::ceil(cpu.sim_cycle()), elapsed_time());
   }
 
+  return collect_phase_stats(phase, env);
+}
+
+phase_stats collect_phase_stats(const phase_info& phase, environment& env)
+{
   phase_stats stats;
   stats.name = phase.name;
 
-  for (std::size_t i = 0; i < std::size(trace_index); ++i) {
-    stats.trace_names.push_back(trace_names.at(trace_index.at(i)));
+  for (std::size_t i = 0; i < std::size(phase.trace_index); ++i) {
+    stats.trace_names.push_back(phase.trace_names.at(phase.trace_index.at(i)));
   }
 
   auto cpus = env.cpu_view();
@@ -172,30 +232,156 @@ phase_stats do_phase(const phase_info& phase, environment& env, std::vector<trac
   std::transform(std::begin(caches), std::end(caches), std::back_inserter(stats.sim_cache_stats), [](const CACHE& cache) { return cache.sim_stats; });
   std::transform(std::begin(caches), std::end(caches), std::back_inserter(stats.roi_cache_stats), [](const CACHE& cache) { return cache.roi_stats; });
 
-  auto dram = env.dram_view();
-  std::transform(std::begin(dram.channels), std::end(dram.channels), std::back_inserter(stats.sim_dram_stats),
-                 [](const DRAM_CHANNEL& chan) { return chan.sim_stats; });
-  std::transform(std::begin(dram.channels), std::end(dram.channels), std::back_inserter(stats.roi_dram_stats),
-                 [](const DRAM_CHANNEL& chan) { return chan.roi_stats; });
+  for (const MEMORY_CONTROLLER& dram : env.dram_view()) {
+    std::transform(std::begin(dram.channels), std::end(dram.channels), std::back_inserter(stats.sim_dram_stats),
+                   [](const DRAM_CHANNEL& chan) { return chan.sim_stats; });
+    std::transform(std::begin(dram.channels), std::end(dram.channels), std::back_inserter(stats.roi_dram_stats),
+                   [](const DRAM_CHANNEL& chan) { return chan.roi_stats; });
+  }
 
   return stats;
 }
 
+/**
+ * Run a phase with the functional hierarchy, one instruction per core in turn.
+ * No cycles pass, so the phase only warms the state of the predictors, caches, and page tables.
+ */
+phase_stats do_functional_phase(const phase_info& phase, environment& env, std::vector<tracereader>& traces)
+{
+  auto operables = env.operable_view();
+  auto [phase_name, is_warmup, length, trace_index, trace_names] = phase;
+
+  // Initialize phase
+  for (champsim::operable& op : operables) {
+    op.warmup = is_warmup;
+    op.begin_phase();
+  }
+
+  functional_hierarchy hierarchy{env};
+
+  std::vector<bool> phase_complete(std::size(env.cpu_view()), false);
+  while (!std::accumulate(std::begin(phase_complete), std::end(phase_complete), true, std::logical_and{})) {
+    for (O3_CPU& cpu : env.cpu_view()) {
+      if (phase_complete[cpu.cpu]) {
+        continue;
+      }
+
+      // Instructions read ahead by an earlier timed phase are executed first
+      auto& trace = traces.at(trace_index.at(cpu.cpu));
+      if (!std::empty(cpu.input_queue)) {
+        hierarchy.execute(cpu, cpu.input_queue.front());
+        cpu.input_queue.pop_front();
+      } else if (!trace.eof()) {
+        auto instr = trace();
+        hierarchy.execute(cpu, instr);
+      }
+    }
+
+    auto next_phase_complete = phase_complete;
+
+    // If any trace reaches EOF, terminate all phases
+    if (std::any_of(std::begin(traces), std::end(traces), [](const auto& tr) { return tr.eof(); })) {
+      std::fill(std::begin(next_phase_complete), std::end(next_phase_complete), true);
+    }
+
+    for (O3_CPU& cpu : env.cpu_view()) {
+      next_phase_complete[cpu.cpu] = next_phase_complete[cpu.cpu] || (cpu.sim_instr() >= length);
+      if (next_phase_complete[cpu.cpu] != phase_complete[cpu.cpu]) {
+        for (champsim::operable& op : operables) {
+          op.end_phase(cpu.cpu);
+        }
+
+        fmt::print("{} finished CPU {} instructions: {} (functional) (Simulation time: {:%H hr %M min %S sec})\n", phase_name, cpu.cpu, cpu.sim_instr(),
+                   elapsed_time());
+      }
+    }
+
+    phase_complete = next_phase_complete;
+  }
+
+  return collect_phase_stats(phase, env);
+}
+
+void save_checkpoint_file(const std::string& file_name, environment& env, const champsim::chrono::clock& global_clock)
+{
+  std::ofstream out{file_name, std::ios::binary};
+  if (!out) {
+    throw checkpoint_error{"Could not open " + file_name + " to write a checkpoint"};
+  }
+  save_checkpoint(out, env, global_clock);
+  fmt::print("Saved checkpoint to {}\n", file_name);
+}
+
+void load_checkpoint_file(const std::string& file_name, environment& env, champsim::chrono::clock& global_clock)
+{
+  std::ifstream in{file_name, std::ios::binary};
+  if (!in) {
+    throw checkpoint_error{"Could not open checkpoint " + file_name};
+  }
+  load_checkpoint(in, env, global_clock);
+  fmt::print("Restored checkpoint from {}\n", file_name);
+}
+
+/**
+ * Advance each trace past the instructions its core had retired when the checkpoint was taken.
+ * Instructions that were in flight at that point are read again.
+ */
+void skip_checkpointed_instructions(environment& env, std::vector<tracereader>& traces, const std::vector<std::size_t>& trace_index)
+{
+  for (O3_CPU& cpu : env.cpu_view()) {
+    auto& trace = traces.at(trace_index.at(cpu.cpu));
+    for (long long i = 0; i < cpu.num_retired && !trace.eof(); ++i) {
+      (void)trace();
+    }
+  }
+}
+
 // simulation entry point
-std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces)
+std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces, const run_options& options)
 {
+  // Fail before simulating anything if the checkpoint could not be written
+  if (!options.save_checkpoint.empty()) {
+    check_checkpoint_support(env);
+  }
+
   for (champsim::operable& op : env.operable_view()) {
     op.initialize();
   }
 
+  std::unique_ptr<core_parallel_engine> parallel_engine;
+  if (options.num_threads > 1 || options.sync_quantum > 1) {
+    parallel_engine = std::make_unique<core_parallel_engine>(env, options.num_threads, options.sync_quantum);
+  }
+
   champsim::chrono::clock global_clock;
+  const bool restored = !options.load_checkpoint.empty();
+  if (restored) {
+    load_checkpoint_file(options.load_checkpoint, env, global_clock);
+  }
+
+  bool warm = false;
   std::vector<phase_stats> results;
   for (auto phase : phases) {
+    if (restored && phase.is_warmup) {
+      continue;
+    }
+
+    if (!warm && !phase.is_warmup) {
+      warm = true;
+      if (restored) {
+        skip_checkpointed_instructions(env, traces, phase.trace_index);
+      }
+      if (!options.save_checkpoint.empty()) {
+        save_checkpoint_file(options.save_checkpoint, env, global_clock);
+      }
+    }
+
     // call event listeners
     handle_event<Event::BEGIN_PHASE>(phase.is_warmup);
     // handle_begin_phase(0, phase.is_warmup);
 
-    auto stats = do_phase(phase, env, traces, global_clock);
+    auto stats = (phase.is_warmup && options.functional_warmup) ? do_functional_phase(phase, env, traces)
+                                                                : do_phase(phase, env, traces, global_clock, parallel_engine.get());
     if (!phase.is_warmup) {
       results.push_back(stats);
     }
@@ -203,4 +389,9 @@ std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases,
 
   return results;
 }
+
+std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces)
+{
+  return main(env, phases, traces, run_options{});
+}
 } // namespace champsim
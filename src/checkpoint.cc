@@ -0,0 +1,142 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "checkpoint.h"
+
+#include <set>
+
+#include "environment.h"
+#include "vmem.h"
+
+namespace
+{
+constexpr std::string_view checkpoint_magic{"ChampSim checkpoint"};
+constexpr uint32_t checkpoint_version = 1;
+} // namespace
+
+champsim::checkpoint_writer::checkpoint_writer(std::ostream& out) : stream(out) {}
+
+void champsim::checkpoint_writer::write_bytes(const void* data, std::size_t size)
+{
+  stream.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+  if (!stream) {
+    throw checkpoint_error{"Failed to write the checkpoint"};
+  }
+}
+
+void champsim::checkpoint_writer::begin_section(std::string_view name) { write(std::string{name}); }
+
+champsim::checkpoint_reader::checkpoint_reader(std::istream& in) : stream(in) {}
+
+void champsim::checkpoint_reader::read_bytes(void* data, std::size_t size)
+{
+  stream.read(static_cast<char*>(data), static_cast<std::streamsize>(size));
+  if (!stream) {
+    throw checkpoint_error{"The checkpoint ended unexpectedly"};
+  }
+}
+
+void champsim::checkpoint_reader::begin_section(std::string_view name)
+{
+  std::string found;
+  read(found);
+  if (found != name) {
+    throw checkpoint_error{"The checkpoint does not match this configuration: expected section '" + std::string{name} + "' but found '" + found + "'"};
+  }
+}
+
+void champsim::check_checkpoint_support(environment& env)
+{
+  for (const O3_CPU& cpu : env.cpu_view()) {
+    cpu.check_checkpoint_support();
+  }
+  for (const CACHE& cache : env.cache_view()) {
+    cache.check_checkpoint_support();
+  }
+}
+
+void champsim::save_checkpoint(std::ostream& out, environment& env, const champsim::chrono::clock& global_clock)
+{
+  check_checkpoint_support(env);
+
+  checkpoint_writer writer{out};
+  writer.begin_section(checkpoint_magic);
+  writer.write(checkpoint_version);
+
+  writer.begin_section("clock");
+  writer.write(global_clock.now().time_since_epoch());
+  auto operables = env.operable_view();
+  writer.write(static_cast<uint64_t>(std::size(operables)));
+  for (const champsim::operable& op : operables) {
+    writer.write(op.current_time);
+  }
+
+  for (const O3_CPU& cpu : env.cpu_view()) {
+    writer.write(cpu);
+  }
+  for (const CACHE& cache : env.cache_view()) {
+    writer.write(cache);
+  }
+
+  // The page table walkers share a single virtual memory
+  std::set<const VirtualMemory*> vmems;
+  for (const PageTableWalker& ptw : env.ptw_view()) {
+    writer.write(ptw);
+    if (ptw.vmem != nullptr && vmems.insert(ptw.vmem).second) {
+      writer.write(*ptw.vmem);
+    }
+  }
+
+  for (const MEMORY_CONTROLLER& dram : env.dram_view()) {
+    writer.write(dram);
+  }
+}
+
+void champsim::load_checkpoint(std::istream& in, environment& env, champsim::chrono::clock& global_clock)
+{
+  checkpoint_reader reader{in};
+  reader.begin_section(checkpoint_magic);
+  reader.expect(checkpoint_version, "the checkpoint version");
+
+  reader.begin_section("clock");
+  champsim::chrono::clock::duration elapsed{};
+  reader.read(elapsed);
+  global_clock.tick(elapsed - global_clock.now().time_since_epoch());
+  auto operables = env.operable_view();
+  reader.expect(static_cast<uint64_t>(std::size(operables)), "the number of components");
+  for (champsim::operable& op : operables) {
+    reader.read(op.current_time);
+  }
+
+  for (O3_CPU& cpu : env.cpu_view()) {
+    reader.read(cpu);
+  }
+  for (CACHE& cache : env.cache_view()) {
+    reader.read(cache);
+  }
+
+  std::set<const VirtualMemory*> vmems;
+  for (PageTableWalker& ptw : env.ptw_view()) {
+    reader.read(ptw);
+    if (ptw.vmem != nullptr && vmems.insert(ptw.vmem).second) {
+      reader.read(*ptw.vmem);
+    }
+  }
+
+  for (MEMORY_CONTROLLER& dram : env.dram_view()) {
+    reader.read(dram);
+  }
+}
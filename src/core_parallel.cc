@@ -0,0 +1,343 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "core_parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <map>
+#include <numeric>
+#include <set>
+#include <thread>
+#include <utility>
+
+#include "cache.h"
+#include "environment.h"
+#include "event_listeners.h"
+#include "ooo_cpu.h"
+#include "tracereader.h"
+
+namespace
+{
+bool by_current_time(const champsim::operable* lhs, const champsim::operable* rhs) { return lhs->current_time < rhs->current_time; }
+} // namespace
+
+/**
+ * A fixed set of spinning worker threads. The calling thread acts as worker 0, so a pool of n workers owns n-1 threads.
+ */
+class champsim::core_parallel_engine::worker_pool
+{
+  struct alignas(64) slot_type {
+    long progress = 0;
+    std::exception_ptr error{};
+  };
+
+  std::vector<std::thread> threads{};
+  std::vector<slot_type> slots;
+
+  void (*task)(void*, std::size_t) = nullptr;
+  void* task_context = nullptr;
+
+  alignas(64) std::atomic<uint64_t> generation{0};
+  alignas(64) std::atomic<std::size_t> outstanding{0};
+  std::atomic<bool> stopping{false};
+
+  void run_task(std::size_t idx)
+  {
+    try {
+      task(task_context, idx);
+    } catch (...) {
+      slots[idx].error = std::current_exception();
+    }
+  }
+
+  void worker_loop(std::size_t idx)
+  {
+    uint64_t seen = 0;
+    while (true) {
+      uint64_t gen = generation.load(std::memory_order_acquire);
+      while (gen == seen) {
+        if (stopping.load(std::memory_order_acquire)) {
+          return;
+        }
+        std::this_thread::yield();
+        gen = generation.load(std::memory_order_acquire);
+      }
+      seen = gen;
+
+      run_task(idx);
+      outstanding.fetch_sub(1, std::memory_order_acq_rel);
+    }
+  }
+
+public:
+  explicit worker_pool(std::size_t num_workers) : slots(num_workers)
+  {
+    for (std::size_t i = 1; i < num_workers; ++i) {
+      threads.emplace_back([this, i] { worker_loop(i); });
+    }
+  }
+
+  ~worker_pool()
+  {
+    stopping.store(true, std::memory_order_release);
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  worker_pool(const worker_pool&) = delete;
+  worker_pool& operator=(const worker_pool&) = delete;
+
+  [[nodiscard]] std::size_t size() const { return std::size(slots); }
+
+  /**
+   * Run func(idx) on every worker and wait for all of them to finish. Returns the sum of the progress recorded by the workers.
+   * The first exception thrown by any worker is rethrown on the calling thread.
+   */
+  template <typename F>
+  long dispatch(F&& func)
+  {
+    using func_type = std::remove_reference_t<F>;
+    task = [](void* ctx, std::size_t idx) { (*static_cast<func_type*>(ctx))(idx); };
+    task_context = &func;
+    for (auto& slot : slots) {
+      slot.progress = 0;
+    }
+
+    outstanding.store(std::size(threads), std::memory_order_relaxed);
+    generation.fetch_add(1, std::memory_order_release);
+
+    run_task(0);
+    while (outstanding.load(std::memory_order_acquire) > 0) {
+      std::this_thread::yield();
+    }
+
+    for (auto& slot : slots) {
+      if (slot.error) {
+        std::rethrow_exception(std::exchange(slot.error, nullptr));
+      }
+    }
+
+    return std::accumulate(std::cbegin(slots), std::cend(slots), long{0}, [](long acc, const slot_type& slot) { return acc + slot.progress; });
+  }
+
+  long& progress(std::size_t idx) { return slots.at(idx).progress; }
+};
+
+champsim::core_parallel_engine::core_parallel_engine(environment& env, std::size_t num_threads, long quantum) : m_quantum(std::max(quantum, 1L))
+{
+  auto cpus = env.cpu_view();
+  auto caches = env.cache_view();
+
+  // Find the cache that receives the requests from each channel
+  std::map<const champsim::channel*, CACHE*> receiver;
+  for (CACHE& cache : caches) {
+    for (auto* ul : cache.upper_levels) {
+      receiver.try_emplace(ul, &cache);
+    }
+  }
+
+  // Walk down from each core, recording which cores can reach each cache
+  std::map<const CACHE*, std::set<std::size_t>> reached_by;
+  for (std::size_t group_idx = 0; group_idx < std::size(cpus); ++group_idx) {
+    O3_CPU& cpu = cpus.at(group_idx);
+    std::vector<const champsim::channel*> frontier{cpu.L1I_bus.lower_channel(), cpu.L1D_bus.lower_channel()};
+    while (!std::empty(frontier)) {
+      auto found = receiver.find(frontier.back());
+      frontier.pop_back();
+      if (found != std::end(receiver) && reached_by[found->second].insert(group_idx).second) {
+        frontier.push_back(found->second->lower_level);
+        frontier.push_back(found->second->lower_translate);
+      }
+    }
+    m_groups.push_back(group_type{&cpu});
+  }
+
+  std::map<const operable*, std::size_t> owner;
+  for (std::size_t group_idx = 0; group_idx < std::size(cpus); ++group_idx) {
+    owner.try_emplace(&static_cast<operable&>(cpus.at(group_idx).get()), group_idx);
+  }
+  for (auto [cache, groups] : reached_by) {
+    if (std::size(groups) == 1) {
+      owner.try_emplace(static_cast<const operable*>(cache), *std::begin(groups));
+    }
+  }
+
+  for (operable& op : env.operable_view()) {
+    auto found = owner.find(&op);
+    auto op_owner = (found == std::end(owner)) ? shared_owner : found->second;
+    m_operables.push_back({&op, op_owner});
+    if (op_owner == shared_owner) {
+      m_shared.push_back(&op);
+    } else {
+      m_groups.at(op_owner).members.push_back(&op);
+    }
+  }
+
+  m_num_workers = std::clamp<std::size_t>(num_threads, 1, std::max<std::size_t>(std::size(m_groups), 1));
+  if (m_num_workers > 1) {
+    m_pool = std::make_unique<worker_pool>(m_num_workers);
+    listener_serialize = true;
+  }
+}
+
+champsim::core_parallel_engine::~core_parallel_engine()
+{
+  if (m_pool) {
+    listener_serialize = false;
+  }
+}
+
+long champsim::core_parallel_engine::quantum() const { return m_quantum; }
+
+std::size_t champsim::core_parallel_engine::num_workers() const { return m_num_workers; }
+
+bool champsim::core_parallel_engine::is_private(const operable& op) const
+{
+  auto found = std::find_if(std::begin(m_operables), std::end(m_operables), [addr = &op](const entry_type& entry) { return entry.op == addr; });
+  return found != std::end(m_operables) && found->owner != shared_owner;
+}
+
+long champsim::core_parallel_engine::do_quantum(std::vector<tracereader>& traces, const std::vector<std::size_t>& trace_index,
+                                                const champsim::chrono::clock& global_clock, champsim::chrono::clock::duration time_quantum)
+{
+  if (m_quantum > 1) {
+    return do_relaxed_quantum(traces, trace_index, global_clock, time_quantum);
+  }
+
+  auto progress = do_exact_cycle(global_clock);
+
+  // Read from trace
+  for (auto& group : m_groups) {
+    auto& trace = traces.at(trace_index.at(group.cpu->cpu));
+    for (auto pkt_count = group.cpu->IN_QUEUE_SIZE - static_cast<long>(std::size(group.cpu->input_queue)); !trace.eof() && pkt_count > 0; --pkt_count) {
+      group.cpu->input_queue.push_back(trace());
+    }
+  }
+
+  return progress;
+}
+
+long champsim::core_parallel_engine::do_exact_cycle(const champsim::chrono::clock& global_clock)
+{
+  // Reproduce the order of the serial do_cycle()
+  m_schedule = m_operables;
+  std::sort(std::begin(m_schedule), std::end(m_schedule), [](const entry_type& lhs, const entry_type& rhs) { return by_current_time(lhs.op, rhs.op); });
+
+  long progress{0};
+  auto is_shared = [](const entry_type& entry) { return entry.owner == shared_owner; };
+  for (auto seg_begin = std::begin(m_schedule); seg_begin != std::end(m_schedule);) {
+    if (is_shared(*seg_begin)) {
+      progress += seg_begin->op->operate_on(global_clock);
+      ++seg_begin;
+      continue;
+    }
+
+    // Operables of different cores within a run of private operables commute, so the run may be split among the workers
+    auto seg_end = std::find_if(seg_begin, std::end(m_schedule), is_shared);
+    auto first_owner = seg_begin->owner;
+    bool single_owner = std::all_of(seg_begin, seg_end, [first_owner](const entry_type& entry) { return entry.owner == first_owner; });
+    if (!m_pool || single_owner) {
+      for (auto it = seg_begin; it != seg_end; ++it) {
+        progress += it->op->operate_on(global_clock);
+      }
+    } else {
+      progress += m_pool->dispatch([this, seg_begin, seg_end, &global_clock](std::size_t worker) {
+        for (auto it = seg_begin; it != seg_end; ++it) {
+          if (it->owner % m_num_workers == worker) {
+            m_pool->progress(worker) += it->op->operate_on(global_clock);
+          }
+        }
+      });
+    }
+    seg_begin = seg_end;
+  }
+
+  return progress;
+}
+
+long champsim::core_parallel_engine::do_relaxed_quantum(std::vector<tracereader>& traces, const std::vector<std::size_t>& trace_index,
+                                                        const champsim::chrono::clock& global_clock, champsim::chrono::clock::duration time_quantum)
+{
+  const auto quantum_begin = global_clock.now() - (time_quantum * m_quantum);
+  auto clock_at = [quantum_begin, time_quantum](long step) {
+    champsim::chrono::clock local_clock;
+    local_clock.tick((quantum_begin + time_quantum * step).time_since_epoch());
+    return local_clock;
+  };
+
+  // Each core group runs through the whole quantum on its own
+  auto run_group = [this, &clock_at](group_type& group) {
+    long group_progress{0};
+    for (long step = 1; step <= m_quantum; ++step) {
+      auto local_clock = clock_at(step);
+      group.order = group.members;
+      std::sort(std::begin(group.order), std::end(group.order), by_current_time);
+      for (auto* op : group.order) {
+        group_progress += op->operate_on(local_clock);
+      }
+
+      auto& input_queue = group.cpu->input_queue;
+      while (!std::empty(group.pending) && static_cast<long>(std::size(input_queue)) < group.cpu->IN_QUEUE_SIZE) {
+        input_queue.push_back(std::move(group.pending.front()));
+        group.pending.pop_front();
+      }
+    }
+    return group_progress;
+  };
+
+  long progress{0};
+  if (m_pool) {
+    progress += m_pool->dispatch([this, &run_group](std::size_t worker) {
+      for (std::size_t group_idx = worker; group_idx < std::size(m_groups); group_idx += m_num_workers) {
+        m_pool->progress(worker) += run_group(m_groups[group_idx]);
+      }
+    });
+  } else {
+    for (auto& group : m_groups) {
+      progress += run_group(group);
+    }
+  }
+
+  // The shared operables then catch up
+  for (long step = 1; step <= m_quantum; ++step) {
+    auto local_clock = clock_at(step);
+    m_shared_order = m_shared;
+    std::sort(std::begin(m_shared_order), std::end(m_shared_order), by_current_time);
+    for (auto* op : m_shared_order) {
+      progress += op->operate_on(local_clock);
+    }
+  }
+
+  // Stage enough of each trace for the next quantum. Instruction IDs are assigned here, in core order, so they do not depend on thread timing.
+  for (auto& group : m_groups) {
+    auto& trace = traces.at(trace_index.at(group.cpu->cpu));
+    auto& input_queue = group.cpu->input_queue;
+    for (auto pkt_count = group.cpu->IN_QUEUE_SIZE * m_quantum - static_cast<long>(std::size(input_queue) + std::size(group.pending));
+         !trace.eof() && pkt_count > 0; --pkt_count) {
+      group.pending.push_back(trace());
+    }
+
+    while (!std::empty(group.pending) && static_cast<long>(std::size(input_queue)) < group.cpu->IN_QUEUE_SIZE) {
+      input_queue.push_back(std::move(group.pending.front()));
+      group.pending.pop_front();
+    }
+  }
+
+  return progress;
+}
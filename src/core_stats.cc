@@ -7,6 +7,9 @@ cpu_stats operator-(cpu_stats lhs, cpu_stats rhs)
   lhs.end_instrs -= rhs.end_instrs;
   lhs.end_cycles -= rhs.end_cycles;
   lhs.total_rob_occupancy_at_branch_mispredict -= rhs.total_rob_occupancy_at_branch_mispredict;
+  lhs.total_ftq_occupancy -= rhs.total_ftq_occupancy;
+  lhs.front_end_stall_cycles -= rhs.front_end_stall_cycles;
+  lhs.wrong_path_instrs -= rhs.wrong_path_instrs;
 
   lhs.total_branch_types -= rhs.total_branch_types;
   lhs.branch_type_misses -= rhs.branch_type_misses;
@@ -17,51 +17,106 @@
 #include "dram_controller.h"
 
 #include <algorithm>
+#include <cassert>
 #include <cfenv>
 #include <cmath>
+#include <limits>
+#include <stdexcept>
 #include <fmt/core.h>
 
 #include "deadlock.h"
+#include "event_listeners.h"
 #include "instruction.h"
 #include "util/bits.h" // for lg2, bitmask
-#include "util/span.h"
 #include "util/units.h"
 
 MEMORY_CONTROLLER::MEMORY_CONTROLLER(champsim::chrono::picoseconds dbus_period, champsim::chrono::picoseconds mc_period, std::size_t t_rp, std::size_t t_rcd,
                                      std::size_t t_cas, std::size_t t_ras, champsim::chrono::microseconds refresh_period, std::vector<channel_type*>&& ul,
                                      std::size_t rq_size, std::size_t wq_size, std::size_t chans, champsim::data::bytes chan_width, std::size_t rows,
-                                     std::size_t columns, std::size_t ranks, std::size_t bankgroups, std::size_t banks, std::size_t refreshes_per_period)
+                                     std::size_t columns, std::size_t ranks, std::size_t bankgroups, std::size_t banks, std::size_t refreshes_per_period,
+                                     dram_power_parameters power, dram_page_policy page_policy, dram_address_layout layout, dram_node node_,
+                                     dram_refresh_policy refresh)
     : champsim::operable(mc_period), queues(std::move(ul)), channel_width(chan_width),
-      address_mapping(chan_width, BLOCK_SIZE / chan_width.count(), chans, bankgroups, banks, columns, ranks, rows), data_bus_period(dbus_period)
+      address_mapping(chan_width, BLOCK_SIZE / chan_width.count(), chans, bankgroups, banks, columns, ranks, rows, layout, node_.count),
+      data_bus_period(dbus_period), node(std::move(node_))
 {
   for (std::size_t i{0}; i < chans; ++i) {
     channels.emplace_back(dbus_period, mc_period, t_rp, t_rcd, t_cas, t_ras, refresh_period, refreshes_per_period, chan_width, rq_size, wq_size,
-                          address_mapping);
+                          address_mapping, power, page_policy, refresh);
   }
 }
 
+namespace
+{
+DRAM_CHANNEL::command_energy_type make_command_energy(const dram_power_parameters& power, champsim::data::bytes channel_width, std::size_t banks_per_rank,
+                                                      champsim::chrono::clock::duration t_rp, champsim::chrono::clock::duration t_ras,
+                                                      champsim::chrono::clock::duration t_burst, champsim::chrono::clock::duration t_rfc)
+{
+  const auto devices = static_cast<double>(std::max<std::size_t>(
+      static_cast<std::size_t>(champsim::data::bits_per_byte * channel_width.count()) / std::max<std::size_t>(power.device_width, 1), 1));
+
+  // Milliwatts times picoseconds gives femtojoules
+  auto energy = [devices, vdd = power.VDD](double current, champsim::chrono::clock::duration duration) {
+    return devices * vdd * current * static_cast<double>(duration.count()) / 1000.0;
+  };
+
+  return {energy(power.IDD0, t_ras + t_rp) - energy(power.IDD3N, t_ras) - energy(power.IDD2N, t_rp), energy(power.IDD4R - power.IDD3N, t_burst),
+          energy(power.IDD4W - power.IDD3N, t_burst), energy(power.IDD5B - power.IDD3N, t_rfc) / static_cast<double>(banks_per_rank),
+          devices * power.VDD * power.IDD3N, devices * power.VDD * power.IDD2N};
+}
+} // namespace
+
 DRAM_CHANNEL::DRAM_CHANNEL(champsim::chrono::picoseconds dbus_period, champsim::chrono::picoseconds mc_period, std::size_t t_rp, std::size_t t_rcd,
                            std::size_t t_cas, std::size_t t_ras, champsim::chrono::microseconds refresh_period, std::size_t refreshes_per_period,
-                           champsim::data::bytes width, std::size_t rq_size, std::size_t wq_size, DRAM_ADDRESS_MAPPING addr_mapper)
+                           champsim::data::bytes width, std::size_t rq_size, std::size_t wq_size, DRAM_ADDRESS_MAPPING addr_mapper,
+                           dram_power_parameters power, dram_page_policy policy, dram_refresh_policy refresh)
     : champsim::operable(mc_period), address_mapping(addr_mapper), WQ{wq_size}, RQ{rq_size}, channel_width(width),
-      DRAM_ROWS_PER_REFRESH(address_mapping.rows() / refreshes_per_period), tRP(t_rp * mc_period), tRCD(t_rcd * mc_period), tCAS(t_cas * mc_period),
-      tRAS(t_ras * mc_period), tREF(refresh_period / refreshes_per_period),
+      DRAM_ROWS_PER_REFRESH(address_mapping.rows() / refreshes_per_period), refresh_policy(refresh), tRP(t_rp * mc_period), tRCD(t_rcd * mc_period),
+      tCAS(t_cas * mc_period), tRAS(t_ras * mc_period), tREF(refresh_period / refreshes_per_period),
       tRFC(std::chrono::duration_cast<champsim::chrono::clock::duration>(
           std::sqrt(champsim::data::bits_per_byte * (double)champsim::data::gibibytes{density()}.count()) * mc_period * t_ras)),
+      tRFCpb(refresh.per_bank_duration > 0 ? champsim::chrono::clock::duration{static_cast<long>(refresh.per_bank_duration) * mc_period} : tRFC / 2),
       DRAM_DBUS_TURN_AROUND_TIME(tRAS),
       DRAM_DBUS_RETURN_TIME(std::chrono::duration_cast<champsim::chrono::clock::duration>(dbus_period * address_mapping.prefetch_size)),
       DRAM_DBUS_BANKGROUP_STALL(
           std::chrono::duration_cast<champsim::chrono::clock::duration>((dbus_period * std::max(address_mapping.prefetch_size / 3, std::size_t{1})))),
-      data_bus_period(dbus_period)
+      data_bus_period(dbus_period), page_policy(policy),
+      command_energy(make_command_energy(power, channel_width, address_mapping.bankgroups() * address_mapping.banks(), tRP, tRAS, DRAM_DBUS_RETURN_TIME, tRFC))
 {
   request_array_type br(address_mapping.ranks() * address_mapping.banks() * address_mapping.bankgroups());
   bank_request = br;
   active_request = std::end(bank_request);
+  RQ_buckets.resize(std::size(bank_request));
+  WQ_buckets.resize(std::size(bank_request));
+  RQ_row_buckets.resize(std::size(bank_request));
+  WQ_row_buckets.resize(std::size(bank_request));
+  sim_stats.active_standby_time.resize(std::size(rank_power));
+  sim_stats.precharge_standby_time.resize(std::size(rank_power));
+}
+
+DRAM_CHANNEL::DRAM_CHANNEL(DRAM_CHANNEL&& other)
+    : champsim::operable(other), address_mapping(other.address_mapping), WQ(std::move(other.WQ)), RQ(std::move(other.RQ)), channel_width(other.channel_width),
+      bank_request(std::move(other.bank_request)), active_request(other.active_request), bankgroup_readytime(std::move(other.bankgroup_readytime)),
+      RQ_buckets(std::move(other.RQ_buckets)), WQ_buckets(std::move(other.WQ_buckets)), RQ_row_buckets(std::move(other.RQ_row_buckets)),
+      WQ_row_buckets(std::move(other.WQ_row_buckets)), RQ_blocks(std::move(other.RQ_blocks)), WQ_blocks(std::move(other.WQ_blocks)),
+      write_mode(other.write_mode), dbus_cycle_available(other.dbus_cycle_available), refresh_row(other.refresh_row),
+      last_refresh(other.last_refresh), DRAM_ROWS_PER_REFRESH(other.DRAM_ROWS_PER_REFRESH), refresh_policy(other.refresh_policy),
+      refresh_group(other.refresh_group), roi_stats(std::move(other.roi_stats)),
+      sim_stats(std::move(other.sim_stats)), tRP(other.tRP), tRCD(other.tRCD), tCAS(other.tCAS), tRAS(other.tRAS), tREF(other.tREF), tRFC(other.tRFC),
+      tRFCpb(other.tRFCpb), DRAM_DBUS_TURN_AROUND_TIME(other.DRAM_DBUS_TURN_AROUND_TIME), DRAM_DBUS_RETURN_TIME(other.DRAM_DBUS_RETURN_TIME),
+      DRAM_DBUS_BANKGROUP_STALL(other.DRAM_DBUS_BANKGROUP_STALL), data_bus_period(other.data_bus_period), page_policy(other.page_policy),
+      command_energy(other.command_energy),
+      rank_power(std::move(other.rank_power)), sched_module_pimpl(std::move(other.sched_module_pimpl))
+{
+  sched_module_pimpl->bind(this);
 }
 
 DRAM_ADDRESS_MAPPING::DRAM_ADDRESS_MAPPING(champsim::data::bytes channel_width_, std::size_t pref_size_, std::size_t channels_, std::size_t bankgroups_,
-                                           std::size_t banks_, std::size_t columns_, std::size_t ranks_, std::size_t rows_)
-    : address_slicer(make_slicer(channel_width_, pref_size_, channels_, bankgroups_, banks_, columns_, ranks_, rows_)), prefetch_size(pref_size_)
+                                           std::size_t banks_, std::size_t columns_, std::size_t ranks_, std::size_t rows_, dram_address_layout layout,
+                                           std::size_t controllers_)
+    : address_slicer(make_slicer(channel_width_, pref_size_, channels_, bankgroups_, banks_, columns_, ranks_, rows_, layout, controllers_)),
+      prefetch_size(pref_size_),
+      swizzle(layout.swizzle)
 {
   // assert prefetch size is not zero
   assert(prefetch_size != 0);
@@ -75,11 +130,34 @@ DRAM_ADDRESS_MAPPING::DRAM_ADDRESS_MAPPING(champsim::data::bytes channel_width_,
   assert(bankgroups() >= 1 && bankgroups() == bankgroups_);
   assert(ranks() >= 1 && ranks() == ranks_);
   assert(channels() >= 1 && channels() == channels_);
+  assert(controllers() >= 1 && controllers() == controllers_);
 }
 
 auto DRAM_ADDRESS_MAPPING::make_slicer(champsim::data::bytes channel_width, std::size_t pref_size, std::size_t channels, std::size_t bankgroups,
-                                       std::size_t banks, std::size_t columns, std::size_t ranks, std::size_t rows) -> slicer_type
+                                       std::size_t banks, std::size_t columns, std::size_t ranks, std::size_t rows, dram_address_layout layout,
+                                       std::size_t controllers) -> slicer_type
 {
+  using field = dram_address_layout::field;
+  auto slicer_index = [](field f) {
+    switch (f) {
+    case field::channel:
+      return SLICER_CHANNEL_IDX;
+    case field::bankgroup:
+      return SLICER_BANKGROUP_IDX;
+    case field::bank:
+      return SLICER_BANK_IDX;
+    case field::column:
+      return SLICER_COLUMN_IDX;
+    case field::rank:
+      return SLICER_RANK_IDX;
+    case field::row:
+      return SLICER_ROW_IDX;
+    case field::controller:
+      return SLICER_CONTROLLER_IDX;
+    }
+    throw std::invalid_argument{"Unknown DRAM address field"};
+  };
+
   std::array<std::size_t, slicer_type::size()> params{};
   params.at(SLICER_ROW_IDX) = rows;
   params.at(SLICER_COLUMN_IDX) = columns / pref_size;
@@ -88,7 +166,26 @@ auto DRAM_ADDRESS_MAPPING::make_slicer(champsim::data::bytes channel_width, std:
   params.at(SLICER_BANKGROUP_IDX) = bankgroups;
   params.at(SLICER_CHANNEL_IDX) = channels;
   params.at(SLICER_OFFSET_IDX) = channel_width.count() * pref_size;
-  return std::apply([](auto... p) { return champsim::make_contiguous_extent_set(0, champsim::lg2(p)...); }, params);
+  params.at(SLICER_CONTROLLER_IDX) = controllers;
+
+  // The block offset is always the lowest field, and the others are stacked above it in the given order
+  std::array<std::size_t, slicer_type::size()> order{SLICER_OFFSET_IDX};
+  std::transform(std::cbegin(layout.order), std::cend(layout.order), std::next(std::begin(order)), slicer_index);
+  if (!std::is_permutation(std::cbegin(order), std::cend(order), std::cbegin(std::array{SLICER_OFFSET_IDX, SLICER_CHANNEL_IDX, SLICER_BANKGROUP_IDX,
+                                                                                       SLICER_BANK_IDX, SLICER_COLUMN_IDX, SLICER_RANK_IDX, SLICER_ROW_IDX,
+                                                                                       SLICER_CONTROLLER_IDX}))) {
+    throw std::invalid_argument{"A DRAM address layout must name each field exactly once"};
+  }
+
+  std::array<champsim::dynamic_extent, slicer_type::size()> extents{
+      champsim::detail::dynamic_extent_array_initializer(std::make_index_sequence<slicer_type::size()>{})};
+  std::size_t lower = 0;
+  for (auto idx : order) {
+    auto upper = lower + static_cast<std::size_t>(champsim::lg2(params.at(idx)));
+    extents.at(idx) = champsim::dynamic_extent{champsim::data::bits{upper}, champsim::data::bits{lower}};
+    lower = upper;
+  }
+  return std::apply([](auto... x) { return slicer_type{x...}; }, extents);
 }
 
 long MEMORY_CONTROLLER::operate()
@@ -127,11 +224,27 @@ long DRAM_CHANNEL::operate()
       }
       entry.reset();
     }
+
+    for (auto& bucket : RQ_buckets) {
+      bucket.clear();
+    }
+    for (auto& bucket : WQ_buckets) {
+      bucket.clear();
+    }
+    for (auto& bucket : RQ_row_buckets) {
+      bucket.clear();
+    }
+    for (auto& bucket : WQ_row_buckets) {
+      bucket.clear();
+    }
+    RQ_blocks.clear();
+    WQ_blocks.clear();
   }
 
   check_write_collision();
   check_read_collision();
   progress += finish_dbus_request();
+  close_idle_rows();
   swap_write_mode();
   progress += schedule_refresh();
   progress += populate_dbus();
@@ -140,6 +253,84 @@ long DRAM_CHANNEL::operate()
   return progress;
 }
 
+champsim::chrono::clock::time_point MEMORY_CONTROLLER::next_event() const
+{
+  auto next_cycle = current_time + clock_period;
+  auto queues_empty = [](const auto* ul) {
+    return std::empty(ul->RQ) && std::empty(ul->WQ) && std::empty(ul->PQ);
+  };
+  if (!std::all_of(std::cbegin(queues), std::cend(queues), queues_empty)) {
+    return next_cycle;
+  }
+
+  // The channels advance by one of their cycles in each cycle of the controller
+  auto idle_cycles = std::numeric_limits<long>::max();
+  for (const auto& chan : channels) {
+    auto chan_next = chan.next_event();
+    if (chan_next != champsim::chrono::clock::time_point::max()) {
+      idle_cycles = std::min(idle_cycles, static_cast<long>((chan_next - chan.current_time - champsim::chrono::picoseconds{1}) / chan.clock_period));
+    }
+  }
+
+  if (idle_cycles == std::numeric_limits<long>::max()) {
+    return champsim::chrono::clock::time_point::max();
+  }
+  return current_time + (idle_cycles + 1) * clock_period;
+}
+
+void MEMORY_CONTROLLER::skip_cycles(long count)
+{
+  for (auto& chan : channels) {
+    chan.current_time += count * chan.clock_period;
+    chan.skip_cycles(count);
+  }
+}
+
+champsim::chrono::clock::time_point DRAM_CHANNEL::next_event() const
+{
+  auto next_cycle = current_time + clock_period;
+
+  // Newly arrived packets are checked for collisions, and are returned immediately during warmup
+  auto is_unchecked = [warmup = warmup](const auto& pkt) {
+    return pkt.has_value() && (warmup || !pkt->forward_checked);
+  };
+  if (std::any_of(std::begin(RQ), std::end(RQ), is_unchecked) || std::any_of(std::begin(WQ), std::end(WQ), is_unchecked)) {
+    return next_cycle;
+  }
+
+  // The mode is about to change
+  if (select_write_mode() != write_mode) {
+    return next_cycle;
+  }
+
+  auto next = last_refresh + refresh_interval();
+  for (std::size_t i = 0; i < std::size(bank_request); ++i) {
+    const auto& b_req = bank_request[i];
+    // A refresh may begin, or a ready read is stalled by one
+    if (!b_req.valid && !b_req.under_refresh && b_req.refresh_debt > -static_cast<long>(refresh_policy.max_pulled_in)) {
+      return next_cycle;
+    }
+    if (b_req.under_refresh && !std::empty(RQ_buckets[i]) && std::begin(RQ_buckets[i])->first <= current_time) {
+      return next_cycle;
+    }
+    if (b_req.valid || b_req.under_refresh) {
+      next = std::min(next, b_req.ready_time);
+    } else if (b_req.open_row.has_value()) {
+      next = std::min(next, b_req.close_time);
+    }
+  }
+
+  // Packets waiting for a free bank
+  const auto& buckets = write_mode ? WQ_buckets : RQ_buckets;
+  for (std::size_t i = 0; i < std::size(buckets); ++i) {
+    if (!std::empty(buckets[i]) && !bank_request[i].valid && !bank_request[i].under_refresh) {
+      next = std::min(next, std::begin(buckets[i])->first);
+    }
+  }
+
+  return std::max(next, next_cycle);
+}
+
 long DRAM_CHANNEL::finish_dbus_request()
 {
   long progress{0};
@@ -152,6 +343,15 @@ long DRAM_CHANNEL::finish_dbus_request()
     }
 
     active_request->valid = false;
+    active_request->close_time = row_close_time();
+
+    auto key = address_mapping.collision_key(active_request->pkt->value().address);
+    for (auto [queue, blocks] : {std::pair{&RQ, &RQ_blocks}, std::pair{&WQ, &WQ_blocks}}) {
+      if (auto found = blocks->find(key);
+          found != std::end(*blocks) && std::next(std::begin(*queue), static_cast<queue_type::difference_type>(found->second)) == active_request->pkt) {
+        blocks->erase(found);
+      }
+    }
 
     active_request->pkt->reset();
     active_request = std::end(bank_request);
@@ -161,66 +361,179 @@ long DRAM_CHANNEL::finish_dbus_request()
   return progress;
 }
 
+champsim::chrono::clock::time_point DRAM_CHANNEL::row_close_time() const
+{
+  switch (page_policy.type) {
+  case dram_page_policy::mode::close:
+    return current_time;
+  case dram_page_policy::mode::adaptive:
+    return current_time + static_cast<long>(page_policy.timeout) * clock_period;
+  case dram_page_policy::mode::open:
+    break;
+  }
+  return champsim::chrono::clock::time_point::max();
+}
+
+void DRAM_CHANNEL::close_idle_rows()
+{
+  if (page_policy.type == dram_page_policy::mode::open) {
+    return;
+  }
+
+  for (std::size_t i = 0; i < std::size(bank_request); ++i) {
+    auto& b_req = bank_request[i];
+    if (!b_req.valid && !b_req.under_refresh && b_req.open_row.has_value() && b_req.close_time <= current_time) {
+      ++sim_stats.PRE;
+      account_row_change(i, true, false);
+      b_req.open_row.reset();
+      b_req.precharge_done = current_time + tRP;
+    }
+  }
+}
+
+std::size_t DRAM_CHANNEL::refresh_groups() const
+{
+  switch (refresh_policy.type) {
+  case dram_refresh_policy::mode::per_bank:
+    return address_mapping.bankgroups() * address_mapping.banks();
+  case dram_refresh_policy::mode::same_bank:
+    return address_mapping.banks();
+  case dram_refresh_policy::mode::all_bank:
+    break;
+  }
+  return 1;
+}
+
+bool DRAM_CHANNEL::in_refresh_group(std::size_t bank_index, std::size_t group) const
+{
+  // Each rank is refreshed alongside the others
+  auto bank_in_rank = bank_index % (address_mapping.bankgroups() * address_mapping.banks());
+  switch (refresh_policy.type) {
+  case dram_refresh_policy::mode::per_bank:
+    return bank_in_rank == group;
+  case dram_refresh_policy::mode::same_bank:
+    return bank_in_rank % address_mapping.banks() == group;
+  case dram_refresh_policy::mode::all_bank:
+    break;
+  }
+  return true;
+}
+
+champsim::chrono::clock::duration DRAM_CHANNEL::refresh_interval() const { return tREF / static_cast<long>(refresh_groups()); }
+
+champsim::chrono::clock::duration DRAM_CHANNEL::refresh_duration() const
+{
+  return refresh_policy.type == dram_refresh_policy::mode::all_bank ? tRFC : tRFCpb;
+}
+
+bool DRAM_CHANNEL::select_refresh(std::size_t bank_index)
+{
+  const auto debt = bank_request[bank_index].refresh_debt;
+  if (debt > static_cast<long>(refresh_policy.max_postponed)) {
+    return true;
+  }
+  if (debt <= -static_cast<long>(refresh_policy.max_pulled_in)) {
+    return false;
+  }
+
+  if (auto selected = sched_module_pimpl->impl_select_refresh(bank_index, debt); selected.has_value()) {
+    return *selected;
+  }
+  return std::empty(RQ_buckets[bank_index]) && std::empty(WQ_buckets[bank_index]);
+}
+
 long DRAM_CHANNEL::schedule_refresh()
 {
   long progress = {0};
   // check if we reached refresh cycle
 
-  bool schedule_refresh = current_time >= last_refresh + tREF;
+  bool schedule_refresh = current_time >= last_refresh + refresh_interval();
+  std::size_t group = refresh_group;
   // if so, record stats
   if (schedule_refresh) {
     last_refresh = current_time;
-    refresh_row += DRAM_ROWS_PER_REFRESH;
     sim_stats.refresh_cycles++;
-    if (refresh_row >= address_mapping.rows())
-      refresh_row -= address_mapping.rows();
+    refresh_group = (refresh_group + 1) % refresh_groups();
+    if (refresh_group == 0) {
+      refresh_row += DRAM_ROWS_PER_REFRESH;
+      if (refresh_row >= address_mapping.rows())
+        refresh_row -= address_mapping.rows();
+    }
   }
 
   // go through each bank, and handle refreshes
-  for (auto& b_req : bank_request) {
+  bool read_stalled = false;
+  for (std::size_t i = 0; i < std::size(bank_request); ++i) {
+    auto& b_req = bank_request[i];
     // refresh is now needed for this bank
-    if (schedule_refresh) {
-      b_req.need_refresh = true;
+    if (schedule_refresh && in_refresh_group(i, group)) {
+      ++b_req.refresh_debt;
     }
     // refresh is being scheduled for this bank
-    if (b_req.need_refresh && !b_req.valid) {
-      b_req.ready_time = current_time + tRFC;
-      b_req.need_refresh = false;
+    if (!b_req.valid && !b_req.under_refresh && select_refresh(i)) {
+      b_req.ready_time = current_time + refresh_duration();
+      --b_req.refresh_debt;
       b_req.under_refresh = true;
+      ++sim_stats.REF;
+      sim_stats.refresh_energy += command_energy.refresh;
     }
     // refresh is done for this bank
     else if (b_req.under_refresh && b_req.ready_time <= current_time) {
       b_req.under_refresh = false;
+      if (b_req.open_row.has_value()) {
+        ++sim_stats.PRE;
+        account_row_change(i, true, false);
+      }
       b_req.open_row.reset();
       progress++;
     }
 
-    if (b_req.under_refresh)
+    if (b_req.under_refresh) {
       progress++;
+      read_stalled = read_stalled || (!std::empty(RQ_buckets[i]) && std::begin(RQ_buckets[i])->first <= current_time);
+    }
+  }
+
+  if (read_stalled) {
+    ++sim_stats.refresh_stall_cycles;
   }
   return (progress);
 }
 
-void DRAM_CHANNEL::swap_write_mode()
+bool DRAM_CHANNEL::select_write_mode() const
 {
-  // these values control when to send out a burst of writes
-  const std::size_t DRAM_WRITE_HIGH_WM = ((std::size(WQ) * 7) >> 3); // 7/8th
-  const std::size_t DRAM_WRITE_LOW_WM = ((std::size(WQ) * 6) >> 3);  // 6/8th
-  // const std::size_t MIN_DRAM_WRITES_PER_SWITCH = ((std::size(WQ) * 1) >> 2); // 1/4
-
   // Check queue occupancy
   auto wq_occu = static_cast<std::size_t>(std::count_if(std::begin(WQ), std::end(WQ), [](const auto& x) { return x.has_value(); }));
   auto rq_occu = static_cast<std::size_t>(std::count_if(std::begin(RQ), std::end(RQ), [](const auto& x) { return x.has_value(); }));
 
+  if (auto selected = sched_module_pimpl->impl_select_write_mode(rq_occu, wq_occu); selected.has_value()) {
+    return *selected;
+  }
+
+  // these values control when to send out a burst of writes
+  const std::size_t DRAM_WRITE_HIGH_WM = ((std::size(WQ) * 7) >> 3); // 7/8th
+  const std::size_t DRAM_WRITE_LOW_WM = ((std::size(WQ) * 6) >> 3);  // 6/8th
+
   // Change modes if the queues are unbalanced
-  if ((!write_mode && (wq_occu >= DRAM_WRITE_HIGH_WM || (rq_occu == 0 && wq_occu > 0)))
-      || (write_mode && (wq_occu == 0 || (rq_occu > 0 && wq_occu < DRAM_WRITE_LOW_WM)))) {
+  if (write_mode) {
+    return !(wq_occu == 0 || (rq_occu > 0 && wq_occu < DRAM_WRITE_LOW_WM));
+  }
+  return wq_occu >= DRAM_WRITE_HIGH_WM || (rq_occu == 0 && wq_occu > 0);
+}
+
+void DRAM_CHANNEL::swap_write_mode()
+{
+  if (select_write_mode() != write_mode) {
+    auto& queue = write_mode ? WQ : RQ;
+
     // Reset scheduled requests
     for (auto it = std::begin(bank_request); it != std::end(bank_request); ++it) {
       // Leave active request on the data bus
       if (it != active_request && it->valid) {
         // Leave rows charged
-        if (it->ready_time < (current_time + tCAS)) {
+        if (it->ready_time < (current_time + tCAS) && it->open_row.has_value()) {
+          ++sim_stats.PRE;
+          account_row_change(static_cast<std::size_t>(std::distance(std::begin(bank_request), it)), true, false);
           it->open_row.reset();
         }
 
@@ -228,6 +541,7 @@ void DRAM_CHANNEL::swap_write_mode()
         it->valid = false;
         it->pkt->value().scheduled = false;
         it->pkt->value().ready_time = current_time;
+        add_to_bucket(queue, it->pkt);
       }
     }
 
@@ -256,7 +570,7 @@ long DRAM_CHANNEL::populate_dbus()
       // Put this request on the data bus
 
       // get which bankgroup we are in
-      auto op_bankgroup = bankgroup_request_index(iter_next_process->pkt->value().address);
+      auto op_bankgroup = iter_next_process->pkt->value().bankgroup_index;
       auto bankgroup_ready_time = bankgroup_readytime[op_bankgroup];
 
       active_request = iter_next_process;
@@ -270,6 +584,14 @@ long DRAM_CHANNEL::populate_dbus()
       // set when bankgroup dbus will be next ready
       bankgroup_readytime[op_bankgroup] = current_time + DRAM_DBUS_RETURN_TIME + DRAM_DBUS_BANKGROUP_STALL;
 
+      if (write_mode) {
+        ++sim_stats.WR;
+        sim_stats.write_energy += command_energy.write;
+      } else {
+        ++sim_stats.RD;
+        sim_stats.read_energy += command_energy.read;
+      }
+
       if (iter_next_process->row_buffer_hit) {
         if (write_mode) {
           ++sim_stats.WQ_ROW_BUFFER_HIT;
@@ -312,51 +634,126 @@ std::size_t DRAM_CHANNEL::bankgroup_request_index(champsim::address addr) const
   return (op_rank * address_mapping.bankgroups() + op_bankgroup);
 }
 
+void DRAM_CHANNEL::decode_location(request_type& req) const
+{
+  req.bank_index = bank_request_index(req.address);
+  req.bankgroup_index = bankgroup_request_index(req.address);
+  req.row = address_mapping.get_row(req.address);
+}
+
+void DRAM_CHANNEL::add_to_bucket(queue_type& queue, queue_type::iterator pkt)
+{
+  auto& buckets = (&queue == &WQ) ? WQ_buckets : RQ_buckets;
+  auto& row_buckets = (&queue == &WQ) ? WQ_row_buckets : RQ_row_buckets;
+  bucket_entry_type entry{pkt->value().ready_time, static_cast<std::size_t>(std::distance(std::begin(queue), pkt))};
+  buckets[pkt->value().bank_index].insert(entry);
+  row_buckets[pkt->value().bank_index][pkt->value().row].insert(entry);
+}
+
+void DRAM_CHANNEL::remove_from_bucket(queue_type& queue, queue_type::iterator pkt)
+{
+  auto& buckets = (&queue == &WQ) ? WQ_buckets : RQ_buckets;
+  auto& row_buckets = (&queue == &WQ) ? WQ_row_buckets : RQ_row_buckets;
+  bucket_entry_type entry{pkt->value().ready_time, static_cast<std::size_t>(std::distance(std::begin(queue), pkt))};
+  [[maybe_unused]] auto erased = buckets[pkt->value().bank_index].erase(entry);
+  assert(erased == 1);
+
+  auto row_bucket = row_buckets[pkt->value().bank_index].find(pkt->value().row);
+  assert(row_bucket != std::end(row_buckets[pkt->value().bank_index]));
+  row_bucket->second.erase(entry);
+  if (std::empty(row_bucket->second)) {
+    row_buckets[pkt->value().bank_index].erase(row_bucket);
+  }
+}
+
+auto DRAM_CHANNEL::oldest_ready_request(std::size_t bank) const -> std::optional<bucket_entry_type>
+{
+  const auto& bucket = (write_mode ? WQ_buckets : RQ_buckets).at(bank);
+  if (std::empty(bucket) || std::begin(bucket)->first > current_time) {
+    return std::nullopt;
+  }
+  return *std::begin(bucket);
+}
+
+auto DRAM_CHANNEL::oldest_ready_row_hit(std::size_t bank) const -> std::optional<bucket_entry_type>
+{
+  const auto& open_row = bank_request.at(bank).open_row;
+  if (!open_row.has_value()) {
+    return std::nullopt;
+  }
+
+  const auto& row_buckets = (write_mode ? WQ_row_buckets : RQ_row_buckets).at(bank);
+  auto row_bucket = row_buckets.find(*open_row);
+  if (row_bucket == std::end(row_buckets) || std::begin(row_bucket->second)->first > current_time) {
+    return std::nullopt;
+  }
+  return *std::begin(row_bucket->second);
+}
+
 // Look for queued packets that have not been scheduled
 DRAM_CHANNEL::queue_type::iterator DRAM_CHANNEL::schedule_packet()
 {
-  // Look for queued packets that have not been scheduled
+  if (auto selected = sched_module_pimpl->impl_select_request(); selected.has_value()) {
+    return *selected;
+  }
+
+  auto& queue = write_mode ? WQ : RQ;
+  const auto& buckets = write_mode ? WQ_buckets : RQ_buckets;
+
   // prioritize packets that are ready to execute, bank is free
-  auto next_schedule = [this](const auto& lhs, const auto& rhs) {
-    if (!(rhs.has_value() && !rhs.value().scheduled)) {
-      return true;
-    }
-    if (!(lhs.has_value() && !lhs.value().scheduled)) {
-      return false;
+  std::optional<std::pair<bool, bucket_entry_type>> next_schedule;
+  for (std::size_t i = 0; i < std::size(buckets); ++i) {
+    if (!std::empty(buckets[i])) {
+      auto candidate = std::pair{!bank_request[i].valid, *std::begin(buckets[i])};
+      if (!next_schedule.has_value() || (candidate.first && !next_schedule->first)
+          || (candidate.first == next_schedule->first && bucket_order{}(candidate.second, next_schedule->second))) {
+        next_schedule = candidate;
+      }
     }
+  }
 
-    auto lop_idx = this->bank_request_index(lhs.value().address);
-    auto rop_idx = this->bank_request_index(rhs.value().address);
-    auto rready = !this->bank_request[rop_idx].valid;
-    auto lready = !this->bank_request[lop_idx].valid;
-    return (rready == lready) ? lhs.value().ready_time <= rhs.value().ready_time : lready;
-  };
-  queue_type::iterator iter_next_schedule;
-  if (write_mode) {
-    iter_next_schedule = std::min_element(std::begin(WQ), std::end(WQ), next_schedule);
-  } else {
-    iter_next_schedule = std::min_element(std::begin(RQ), std::end(RQ), next_schedule);
+  if (!next_schedule.has_value()) {
+    return std::end(queue);
   }
-  return (iter_next_schedule);
+  return std::next(std::begin(queue), static_cast<queue_type::difference_type>(next_schedule->second.second));
 }
 
 long DRAM_CHANNEL::service_packet(DRAM_CHANNEL::queue_type::iterator pkt)
 {
   long progress{0};
-  if (pkt->has_value() && pkt->value().ready_time <= current_time) {
-    auto op_row = address_mapping.get_row(pkt->value().address);
-    auto op_idx = bank_request_index(pkt->value().address);
+  auto& queue = write_mode ? WQ : RQ;
+  if (pkt != std::end(queue) && pkt->has_value() && pkt->value().ready_time <= current_time) {
+    auto op_row = pkt->value().row;
+    auto op_idx = pkt->value().bank_index;
 
     if (!bank_request[op_idx].valid && !bank_request[op_idx].under_refresh) {
-      bool row_buffer_hit = (bank_request[op_idx].open_row.has_value() && *(bank_request[op_idx].open_row) == op_row);
+      bool row_was_open = bank_request[op_idx].open_row.has_value();
+      bool row_buffer_hit = (row_was_open && *(bank_request[op_idx].open_row) == op_row);
+      if (!row_buffer_hit) {
+        if (row_was_open) {
+          ++sim_stats.PRE;
+        }
+        ++sim_stats.ACT;
+        sim_stats.activate_energy += command_energy.activate;
+        account_row_change(op_idx, row_was_open, true);
+      }
 
-      // this bank is now busy
-      auto row_charge_delay = champsim::chrono::clock::duration{bank_request[op_idx].open_row.has_value() ? tRP + tRCD : tRCD};
-      bank_request[op_idx] = {true,  row_buffer_hit,        false,
-                              false, std::optional{op_row}, current_time + tCAS + (row_buffer_hit ? champsim::chrono::clock::duration{} : row_charge_delay),
+      // this bank is now busy. A row closed by the page policy may still be precharging.
+      auto row_charge_delay = champsim::chrono::clock::duration{row_was_open ? tRP + tRCD : tRCD};
+      if (!row_was_open && bank_request[op_idx].precharge_done > current_time) {
+        row_charge_delay += bank_request[op_idx].precharge_done - current_time;
+      }
+      bank_request[op_idx] = {true,
+                              row_buffer_hit,
+                              false,
+                              bank_request[op_idx].refresh_debt,
+                              std::optional{op_row},
+                              current_time + tCAS + (row_buffer_hit ? champsim::chrono::clock::duration{} : row_charge_delay),
                               pkt};
+      remove_from_bucket(queue, pkt);
       pkt->value().scheduled = true;
       pkt->value().ready_time = champsim::chrono::clock::time_point::max();
+      sched_module_pimpl->impl_request_scheduled(pkt->value());
 
       ++progress;
     }
@@ -370,6 +767,9 @@ void MEMORY_CONTROLLER::initialize()
   using namespace champsim::data::data_literals;
   using namespace std::literals::chrono_literals;
   auto sz = this->size();
+  if (!std::empty(node.name)) {
+    fmt::print("{} ", node.name);
+  }
   if (champsim::data::gibibytes gb_sz{sz}; gb_sz > 1_GiB) {
     fmt::print("Off-chip DRAM Size: {}", gb_sz);
   } else if (champsim::data::mebibytes mb_sz{sz}; mb_sz > 1_MiB) {
@@ -381,18 +781,25 @@ void MEMORY_CONTROLLER::initialize()
   }
   fmt::print(" Channels: {} Width: {}-bit Data Rate: {} MT/s\n", std::size(channels), champsim::data::bits_per_byte * channel_width.count(),
              1us / (data_bus_period));
+
+  for (auto& chan : channels) {
+    chan.initialize();
+  }
 }
 
-void DRAM_CHANNEL::initialize() {}
+void DRAM_CHANNEL::initialize() { sched_module_pimpl->impl_initialize_dram_scheduler(); }
+
+void DRAM_CHANNEL::impl_dram_scheduler_final_stats() const { sched_module_pimpl->impl_dram_scheduler_final_stats(); }
 
 void MEMORY_CONTROLLER::begin_phase()
 {
   std::size_t chan_idx = 0;
   for (auto& chan : channels) {
     DRAM_CHANNEL::stats_type new_stats;
-    new_stats.name = "Channel " + std::to_string(chan_idx++);
+    new_stats.name = (std::empty(node.name) ? "" : node.name + " ") + "Channel " + std::to_string(chan_idx++);
     chan.sim_stats = new_stats;
     chan.warmup = warmup;
+    chan.begin_phase();
   }
 
   for (auto* ul : queues) {
@@ -403,7 +810,14 @@ void MEMORY_CONTROLLER::begin_phase()
   }
 }
 
-void DRAM_CHANNEL::begin_phase() {}
+void DRAM_CHANNEL::begin_phase()
+{
+  for (auto& rank : rank_power) {
+    rank.since = current_time;
+  }
+  sim_stats.active_standby_time.resize(std::size(rank_power));
+  sim_stats.precharge_standby_time.resize(std::size(rank_power));
+}
 
 void MEMORY_CONTROLLER::end_phase(unsigned cpu)
 {
@@ -412,7 +826,97 @@ void MEMORY_CONTROLLER::end_phase(unsigned cpu)
   }
 }
 
-void DRAM_CHANNEL::end_phase(unsigned /*cpu*/) { roi_stats = sim_stats; }
+void DRAM_CHANNEL::end_phase(unsigned /*cpu*/)
+{
+  for (std::size_t i = 0; i < std::size(rank_power); ++i) {
+    account_background(i);
+  }
+  roi_stats = sim_stats;
+}
+
+void DRAM_CHANNEL::account_row_change(std::size_t bank_index, bool was_open, bool is_open)
+{
+  if (was_open == is_open) {
+    return;
+  }
+
+  auto rank_index = bank_index / (address_mapping.bankgroups() * address_mapping.banks());
+  auto& rank = rank_power.at(rank_index);
+  if (is_open ? (rank.open_banks == 0) : (rank.open_banks == 1)) {
+    account_background(rank_index);
+  }
+  if (is_open) {
+    ++rank.open_banks;
+  } else {
+    --rank.open_banks;
+  }
+}
+
+void DRAM_CHANNEL::account_background(std::size_t rank_index)
+{
+  auto& rank = rank_power.at(rank_index);
+  auto elapsed = current_time - rank.since;
+  if (rank.open_banks > 0) {
+    sim_stats.active_standby_time.at(rank_index) += elapsed;
+    sim_stats.background_energy += command_energy.active_standby_power * static_cast<double>(elapsed.count()) / 1000.0;
+  } else {
+    sim_stats.precharge_standby_time.at(rank_index) += elapsed;
+    sim_stats.background_energy += command_energy.precharge_standby_power * static_cast<double>(elapsed.count()) / 1000.0;
+  }
+  rank.since = current_time;
+}
+
+void MEMORY_CONTROLLER::save_checkpoint(champsim::checkpoint_writer& writer) const
+{
+  writer.begin_section("DRAM");
+  writer.write(static_cast<uint64_t>(std::size(channels)));
+  for (const auto& chan : channels) {
+    writer.write(chan);
+  }
+}
+
+void MEMORY_CONTROLLER::load_checkpoint(champsim::checkpoint_reader& reader)
+{
+  reader.begin_section("DRAM");
+  reader.expect(static_cast<uint64_t>(std::size(channels)), "the number of DRAM channels");
+  for (auto& chan : channels) {
+    reader.read(chan);
+  }
+}
+
+void DRAM_CHANNEL::save_checkpoint(champsim::checkpoint_writer& writer) const
+{
+  writer.write(current_time);
+  writer.write(static_cast<uint64_t>(std::size(bank_request)));
+  for (const auto& bank : bank_request) {
+    writer.write(bank.open_row);
+    writer.write(bank.refresh_debt);
+  }
+  writer.write(refresh_row);
+  writer.write(last_refresh);
+  writer.write(refresh_group);
+}
+
+void DRAM_CHANNEL::load_checkpoint(champsim::checkpoint_reader& reader)
+{
+  reader.read(current_time);
+  reader.expect(static_cast<uint64_t>(std::size(bank_request)), "the number of DRAM banks");
+  for (auto& bank : bank_request) {
+    reader.read(bank.open_row);
+    reader.read(bank.refresh_debt);
+  }
+  reader.read(refresh_row);
+  reader.read(last_refresh);
+  reader.read(refresh_group);
+
+  for (auto& rank : rank_power) {
+    rank = rank_power_state{0, current_time};
+  }
+  for (std::size_t i = 0; i < std::size(bank_request); ++i) {
+    account_row_change(i, false, bank_request[i].open_row.has_value());
+    bank_request[i].close_time = row_close_time();
+  }
+}
 
 bool DRAM_ADDRESS_MAPPING::is_collision(champsim::address a, champsim::address b) const
 {
@@ -421,23 +925,37 @@ bool DRAM_ADDRESS_MAPPING::is_collision(champsim::address a, champsim::address b
   return (a.slice_upper(offset_bits) == b.slice_upper(offset_bits));
 }
 
+uint64_t DRAM_ADDRESS_MAPPING::collision_key(champsim::address address) const
+{
+  champsim::data::bits offset_bits = champsim::data::bits{champsim::size(get<SLICER_OFFSET_IDX>(address_slicer))};
+  return address.slice_upper(offset_bits).to<uint64_t>();
+}
+
 void DRAM_CHANNEL::check_write_collision()
 {
+  // Count the unchecked writes to each block, so that a write can see whether a later one collides with it
+  std::unordered_map<uint64_t, std::size_t> unchecked{};
+  for (const auto& entry : WQ) {
+    if (entry.has_value() && !entry->forward_checked) {
+      ++unchecked[address_mapping.collision_key(entry->address)];
+    }
+  }
+  if (std::empty(unchecked)) {
+    return;
+  }
+
   for (auto wq_it = std::begin(WQ); wq_it != std::end(WQ); ++wq_it) {
     if (wq_it->has_value() && !wq_it->value().forward_checked) {
-      auto checker = [addr_map = address_mapping, check_val = wq_it->value().address](const auto& pkt) {
-        return pkt.has_value() && addr_map.is_collision(pkt.value().address, check_val);
-      };
-
-      auto found = std::find_if(std::begin(WQ), wq_it, checker); // Forward check
-      if (found == wq_it) {
-        found = std::find_if(std::next(wq_it), std::end(WQ), checker); // Backward check
-      }
+      auto key = address_mapping.collision_key(wq_it->value().address);
+      auto later_unchecked = --unchecked.at(key);
 
-      if (found != std::end(WQ)) {
+      if (WQ_blocks.count(key) > 0 || later_unchecked > 0) {
         wq_it->reset();
       } else {
         wq_it->value().forward_checked = true;
+        decode_location(wq_it->value());
+        add_to_bucket(WQ, wq_it);
+        WQ_blocks.emplace(key, static_cast<std::size_t>(std::distance(std::begin(WQ), wq_it)));
       }
     }
   }
@@ -445,37 +963,47 @@ void DRAM_CHANNEL::check_write_collision()
 
 void DRAM_CHANNEL::check_read_collision()
 {
+  // The slots of the unchecked reads to each block, in order
+  std::unordered_map<uint64_t, std::deque<std::size_t>> unchecked{};
   for (auto rq_it = std::begin(RQ); rq_it != std::end(RQ); ++rq_it) {
     if (rq_it->has_value() && !rq_it->value().forward_checked) {
-      auto checker = [addr_map = address_mapping, check_val = rq_it->value().address](const auto& x) {
-        return x.has_value() && addr_map.is_collision(x.value().address, check_val);
-      };
+      unchecked[address_mapping.collision_key(rq_it->value().address)].push_back(static_cast<std::size_t>(std::distance(std::begin(RQ), rq_it)));
+    }
+  }
+  if (std::empty(unchecked)) {
+    return;
+  }
+
+  for (auto rq_it = std::begin(RQ); rq_it != std::end(RQ); ++rq_it) {
+    if (rq_it->has_value() && !rq_it->value().forward_checked) {
+      auto key = address_mapping.collision_key(rq_it->value().address);
+      auto slot = static_cast<std::size_t>(std::distance(std::begin(RQ), rq_it));
+      auto& later_unchecked = unchecked.at(key);
+      assert(later_unchecked.front() == slot);
+      later_unchecked.pop_front();
+
+      // Prefer a checked read before this one, then the nearest read after it
+      std::optional<std::size_t> found_slot{};
+      if (auto checked = RQ_blocks.find(key); checked != std::end(RQ_blocks)) {
+        found_slot = checked->second;
+      }
+      if (!std::empty(later_unchecked) && (!found_slot.has_value() || (*found_slot > slot && later_unchecked.front() < *found_slot))) {
+        found_slot = later_unchecked.front();
+      }
+
       // write forward
-      if (auto wq_it = std::find_if(std::begin(WQ), std::end(WQ), checker); wq_it != std::end(WQ)) {
-        response_type response{rq_it->value().address, rq_it->value().v_address, wq_it->value().data, rq_it->value().pf_metadata,
-                               rq_it->value().instr_depend_on_me};
+      if (auto wq_entry = WQ_blocks.find(key); wq_entry != std::end(WQ_blocks)) {
+        const auto& wq_pkt = WQ.at(wq_entry->second);
+        response_type response{rq_it->value().address, rq_it->value().v_address, wq_pkt->data, rq_it->value().pf_metadata, rq_it->value().instr_depend_on_me};
         for (auto* ret : rq_it->value().to_return) {
           ret->push_back(response);
         }
 
         rq_it->reset();
-
       }
-      // backwards check
-      else if (auto found = std::find_if(std::begin(RQ), rq_it, checker); found != rq_it) {
-        auto instr_copy = std::move(found->value().instr_depend_on_me);
-        auto ret_copy = std::move(found->value().to_return);
-
-        std::set_union(std::begin(instr_copy), std::end(instr_copy), std::begin(rq_it->value().instr_depend_on_me), std::end(rq_it->value().instr_depend_on_me),
-                       std::back_inserter(found->value().instr_depend_on_me));
-        std::set_union(std::begin(ret_copy), std::end(ret_copy), std::begin(rq_it->value().to_return), std::end(rq_it->value().to_return),
-                       std::back_inserter(found->value().to_return));
-
-        rq_it->reset();
-
-      }
-      // forwards check
-      else if (found = std::find_if(std::next(rq_it), std::end(RQ), checker); found != std::end(RQ)) {
+      // merge with another read to the same block
+      else if (found_slot.has_value()) {
+        auto found = std::next(std::begin(RQ), static_cast<queue_type::difference_type>(*found_slot));
         auto instr_copy = std::move(found->value().instr_depend_on_me);
         auto ret_copy = std::move(found->value().to_return);
 
@@ -487,6 +1015,9 @@ void DRAM_CHANNEL::check_read_collision()
         rq_it->reset();
       } else {
         rq_it->value().forward_checked = true;
+        decode_location(rq_it->value());
+        add_to_bucket(RQ, rq_it);
+        RQ_blocks.emplace(key, slot);
       }
     }
   }
@@ -494,21 +1025,44 @@ void DRAM_CHANNEL::check_read_collision()
 
 void MEMORY_CONTROLLER::initiate_requests()
 {
-  // Initiate read requests
+  // Requests are taken in order until one does not fit. Requests served by another controller are left for it.
+  auto initiate = [this](auto& queue, auto add) {
+    for (auto it = std::begin(queue); it != std::end(queue);) {
+      if (!owns(it->address)) {
+        ++it;
+      } else if (add(*it)) {
+        it = queue.erase(it);
+      } else {
+        break;
+      }
+    }
+  };
+
   for (auto* ul : queues) {
+    // Initiate read requests
     for (auto q : {std::ref(ul->RQ), std::ref(ul->PQ)}) {
-      auto [begin, end] = champsim::get_span_p(std::cbegin(q.get()), std::cend(q.get()), [ul, this](const auto& pkt) { return this->add_rq(pkt, ul); });
-      q.get().erase(begin, end);
+      initiate(q.get(), [ul, this](const auto& pkt) { return this->add_rq(pkt, ul); });
     }
 
     // Initiate write requests
-    auto [wq_begin, wq_end] = champsim::get_span_p(std::cbegin(ul->WQ), std::cend(ul->WQ), [this](const auto& pkt) { return this->add_wq(pkt); });
-    ul->WQ.erase(wq_begin, wq_end);
+    initiate(ul->WQ, [this](const auto& pkt) { return this->add_wq(pkt); });
+  }
+}
+
+void MEMORY_CONTROLLER::raise_request_event(const request_type& packet, bool is_write) const
+{
+  if (warmup) {
+    return;
   }
+
+  auto cycle = static_cast<uint64_t>(current_time.time_since_epoch() / clock_period);
+  auto cpu = packet.cpu;
+  auto address = packet.address;
+  handle_event<Event::DRAM_REQUEST>(cycle, cpu, is_write, address);
 }
 
 DRAM_CHANNEL::request_type::request_type(const typename champsim::channel::request_type& req)
-    : pf_metadata(req.pf_metadata), address(req.address), v_address(req.address), data(req.data), instr_depend_on_me(req.instr_depend_on_me)
+    : pf_metadata(req.pf_metadata), cpu(req.cpu), address(req.address), v_address(req.address), data(req.data), instr_depend_on_me(req.instr_depend_on_me)
 {
   asid[0] = req.asid[0];
   asid[1] = req.asid[1];
@@ -523,10 +1077,11 @@ bool MEMORY_CONTROLLER::add_rq(const request_type& packet, champsim::channel* ul
     *rq_it = DRAM_CHANNEL::request_type{packet};
     rq_it->value().forward_checked = false;
     rq_it->value().scheduled = false;
-    rq_it->value().ready_time = current_time;
+    rq_it->value().ready_time = current_time + static_cast<long>(node.extra_latency) * clock_period;
     if (packet.response_requested)
       rq_it->value().to_return = {&ul->returned};
 
+    raise_request_event(packet, false);
     return true;
   }
 
@@ -543,8 +1098,9 @@ bool MEMORY_CONTROLLER::add_wq(const request_type& packet)
     *wq_it = DRAM_CHANNEL::request_type{packet};
     wq_it->value().forward_checked = false;
     wq_it->value().scheduled = false;
-    wq_it->value().ready_time = current_time;
+    wq_it->value().ready_time = current_time + static_cast<long>(node.extra_latency) * clock_period;
 
+    raise_request_event(packet, true);
     return true;
   }
 
@@ -570,12 +1126,18 @@ unsigned long DRAM_ADDRESS_MAPPING::get_channel(champsim::address address) const
   unsigned long channel = std::get<SLICER_CHANNEL_IDX>(address_slicer(address)).to<unsigned long>();
   // channel bits should be xor'd with each row bit
   unsigned long c_bits = champsim::size(get<SLICER_CHANNEL_IDX>(address_slicer));
+  if (!swizzle) {
+    return channel;
+  }
   return (swizzle_bits(address, 1, champsim::data::bits{0}, channel, c_bits));
 }
 unsigned long DRAM_ADDRESS_MAPPING::get_rank(champsim::address address) const { return std::get<SLICER_RANK_IDX>(address_slicer(address)).to<unsigned long>(); }
 unsigned long DRAM_ADDRESS_MAPPING::get_bankgroup(champsim::address address) const
 {
   unsigned long bankgroup = std::get<SLICER_BANKGROUP_IDX>(address_slicer(address)).to<unsigned long>();
+  if (!swizzle) {
+    return bankgroup;
+  }
 
   unsigned long bg_bits = champsim::size(get<SLICER_BANKGROUP_IDX>(address_slicer));
   unsigned long bk_bits = champsim::size(get<SLICER_BANK_IDX>(address_slicer));
@@ -584,6 +1146,9 @@ unsigned long DRAM_ADDRESS_MAPPING::get_bankgroup(champsim::address address) con
 unsigned long DRAM_ADDRESS_MAPPING::get_bank(champsim::address address) const
 {
   unsigned long bank = std::get<SLICER_BANK_IDX>(address_slicer(address)).to<unsigned long>();
+  if (!swizzle) {
+    return bank;
+  }
 
   unsigned long bg_bits = champsim::size(get<SLICER_BANKGROUP_IDX>(address_slicer));
   unsigned long bk_bits = champsim::size(get<SLICER_BANK_IDX>(address_slicer));
@@ -596,8 +1161,27 @@ unsigned long DRAM_ADDRESS_MAPPING::get_column(champsim::address address) const
 {
   return std::get<SLICER_COLUMN_IDX>(address_slicer(address)).to<unsigned long>();
 }
+unsigned long DRAM_ADDRESS_MAPPING::get_controller(champsim::address address) const
+{
+  return std::get<SLICER_CONTROLLER_IDX>(address_slicer(address)).to<unsigned long>();
+}
+
+champsim::data::bytes MEMORY_CONTROLLER::size() const
+{
+  const auto controller_bits = champsim::size(get<DRAM_ADDRESS_MAPPING::SLICER_CONTROLLER_IDX>(address_mapping.address_slicer));
+  return champsim::data::bytes{(1ll << (address_mapping.address_slicer.bit_size() - controller_bits))};
+}
+
+std::pair<champsim::address, champsim::address> MEMORY_CONTROLLER::address_range() const
+{
+  return {node.base, node.base + (1ll << address_mapping.address_slicer.bit_size())};
+}
+
+bool MEMORY_CONTROLLER::owns(champsim::address address) const
+{
+  return node.base <= address && address <= node.last && address_mapping.get_controller(address) == node.index;
+}
 
-champsim::data::bytes MEMORY_CONTROLLER::size() const { return champsim::data::bytes{(1ll << address_mapping.address_slicer.bit_size())}; }
 champsim::data::bytes DRAM_CHANNEL::density() const
 {
   return champsim::data::bytes{(long long)(address_mapping.rows() * address_mapping.columns() * address_mapping.banks() * address_mapping.bankgroups())};
@@ -609,6 +1193,7 @@ std::size_t DRAM_ADDRESS_MAPPING::ranks() const { return std::size_t{1} << champ
 std::size_t DRAM_ADDRESS_MAPPING::bankgroups() const { return std::size_t{1} << champsim::size(get<SLICER_BANKGROUP_IDX>(address_slicer)); }
 std::size_t DRAM_ADDRESS_MAPPING::banks() const { return std::size_t{1} << champsim::size(get<SLICER_BANK_IDX>(address_slicer)); }
 std::size_t DRAM_ADDRESS_MAPPING::channels() const { return std::size_t{1} << champsim::size(get<SLICER_CHANNEL_IDX>(address_slicer)); }
+std::size_t DRAM_ADDRESS_MAPPING::controllers() const { return std::size_t{1} << champsim::size(get<SLICER_CONTROLLER_IDX>(address_slicer)); }
 std::size_t DRAM_CHANNEL::bank_request_capacity() const { return std::size(bank_request); }
 std::size_t DRAM_CHANNEL::bankgroup_request_capacity() const { return std::size(bankgroup_readytime); };
 
@@ -0,0 +1,203 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dram_replay.h"
+
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <fmt/core.h>
+
+namespace champsim
+{
+std::optional<dram_trace_record> parse_dram_trace_record(const std::string& line)
+{
+  std::istringstream stream{line};
+  std::string first_token;
+  if (!(stream >> first_token) || first_token.front() == '#') {
+    return std::nullopt;
+  }
+
+  auto malformed = [&line]() { return std::invalid_argument{"Malformed memory trace record: \"" + line + "\""}; };
+
+  std::string cpu_token;
+  std::string type_token;
+  std::string address_token;
+  std::string extra_token;
+  if (!(stream >> cpu_token >> type_token >> address_token) || (stream >> extra_token)) {
+    throw malformed();
+  }
+
+  auto parse_number = [&malformed](const std::string& token) {
+    if (token.front() == '-') {
+      throw malformed();
+    }
+    std::size_t consumed = 0;
+    unsigned long long value = 0;
+    try {
+      value = std::stoull(token, &consumed, 0);
+    } catch (const std::logic_error&) {
+      throw malformed();
+    }
+    if (consumed != std::size(token)) {
+      throw malformed();
+    }
+    return value;
+  };
+
+  dram_trace_record record;
+  record.cycle = parse_number(first_token);
+
+  auto cpu = parse_number(cpu_token);
+  if (cpu > std::numeric_limits<uint32_t>::max()) {
+    throw malformed();
+  }
+  record.cpu = static_cast<uint32_t>(cpu);
+
+  if (type_token == "R") {
+    record.is_write = false;
+  } else if (type_token == "W") {
+    record.is_write = true;
+  } else {
+    throw malformed();
+  }
+
+  record.address = champsim::address{parse_number(address_token)};
+  return record;
+}
+
+std::string format_dram_trace_record(const dram_trace_record& record)
+{
+  return fmt::format("{} {} {} {}", record.cycle, record.cpu, record.is_write ? 'W' : 'R', record.address);
+}
+
+phase_stats replay_dram_trace(environment& env, std::istream& trace)
+{
+  auto drams = env.dram_view();
+  if (std::empty(drams) || std::empty(drams.front().get().upper_levels())) {
+    throw std::invalid_argument{"The memory controllers have no upper level through which to replay a trace"};
+  }
+
+  champsim::channel* upper_level = drams.front().get().upper_levels().front();
+  const auto trace_period = drams.front().get().clock_period;
+  const auto time_quantum = std::min_element(std::begin(drams), std::end(drams), [](const MEMORY_CONTROLLER& lhs, const MEMORY_CONTROLLER& rhs) {
+                              return lhs.clock_period < rhs.clock_period;
+                            })->get().clock_period;
+
+  for (MEMORY_CONTROLLER& dram : drams) {
+    dram.initialize();
+    dram.warmup = false;
+    dram.begin_phase();
+  }
+
+  std::string line;
+  auto next_record = [&trace, &line]() -> std::optional<dram_trace_record> {
+    while (std::getline(trace, line)) {
+      if (auto record = parse_dram_trace_record(line); record.has_value()) {
+        return record;
+      }
+    }
+    return std::nullopt;
+  };
+
+  auto is_drained = [&drams, upper_level]() {
+    auto is_occupied = [](const auto& entry) {
+      return entry.has_value();
+    };
+    auto channel_is_drained = [is_occupied](const DRAM_CHANNEL& chan) {
+      return std::none_of(std::begin(chan.RQ), std::end(chan.RQ), is_occupied) && std::none_of(std::begin(chan.WQ), std::end(chan.WQ), is_occupied);
+    };
+    auto dram_is_drained = [channel_is_drained](const MEMORY_CONTROLLER& dram) {
+      return std::all_of(std::begin(dram.channels), std::end(dram.channels), channel_is_drained);
+    };
+    return std::empty(upper_level->RQ) && std::empty(upper_level->WQ) && std::all_of(std::begin(drams), std::end(drams), dram_is_drained);
+  };
+
+  champsim::chrono::clock global_clock;
+  std::deque<std::pair<champsim::address, champsim::chrono::clock::time_point>> outstanding_reads;
+  uint64_t reads = 0;
+  uint64_t writes = 0;
+  uint64_t returned_reads = 0;
+  champsim::chrono::clock::duration total_read_latency{};
+
+  // The trace is replayed relative to its first record
+  auto pending = next_record();
+  const auto first_cycle = pending.has_value() ? pending->cycle : 0;
+
+  while (pending.has_value() || !is_drained()) {
+    global_clock.tick(time_quantum);
+
+    while (pending.has_value()
+           && champsim::chrono::clock::time_point{} + static_cast<long>(pending->cycle - first_cycle) * trace_period <= global_clock.now()) {
+      champsim::channel::request_type request;
+      request.address = pending->address;
+      request.v_address = pending->address;
+      request.cpu = pending->cpu;
+      request.type = pending->is_write ? access_type::WRITE : access_type::LOAD;
+      request.response_requested = !pending->is_write;
+
+      if (!(pending->is_write ? upper_level->add_wq(request) : upper_level->add_rq(request))) {
+        break;
+      }
+
+      if (pending->is_write) {
+        ++writes;
+      } else {
+        ++reads;
+        outstanding_reads.emplace_back(pending->address, global_clock.now());
+      }
+      pending = next_record();
+    }
+
+    for (MEMORY_CONTROLLER& dram : drams) {
+      dram.operate_on(global_clock);
+    }
+
+    for (const auto& response : upper_level->returned) {
+      auto issued = std::find_if(std::begin(outstanding_reads), std::end(outstanding_reads),
+                                 [addr = response.address](const auto& entry) { return entry.first == addr; });
+      if (issued != std::end(outstanding_reads)) {
+        total_read_latency += global_clock.now() - issued->second;
+        ++returned_reads;
+        outstanding_reads.erase(issued);
+      }
+    }
+    upper_level->returned.clear();
+  }
+
+  for (MEMORY_CONTROLLER& dram : drams) {
+    dram.end_phase(0);
+  }
+
+  fmt::print("DRAM replay complete reads: {} writes: {} cycles: {} average read latency: {:.4g} cycles\n", reads, writes,
+             global_clock.now().time_since_epoch() / trace_period,
+             returned_reads > 0 ? static_cast<double>(total_read_latency.count()) / static_cast<double>(trace_period.count() * returned_reads) : 0.0);
+
+  phase_stats stats;
+  stats.name = "DRAM replay";
+
+  for (const MEMORY_CONTROLLER& dram : drams) {
+    std::transform(std::begin(dram.channels), std::end(dram.channels), std::back_inserter(stats.sim_dram_stats),
+                   [](const DRAM_CHANNEL& chan) { return chan.sim_stats; });
+    std::transform(std::begin(dram.channels), std::end(dram.channels), std::back_inserter(stats.roi_dram_stats),
+                   [](const DRAM_CHANNEL& chan) { return chan.roi_stats; });
+  }
+
+  return stats;
+}
+} // namespace champsim
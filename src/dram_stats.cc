@@ -1,5 +1,18 @@
 #include "dram_stats.h"
 
+#include <algorithm>
+
+namespace
+{
+void subtract_each(std::vector<champsim::chrono::picoseconds>& lhs, const std::vector<champsim::chrono::picoseconds>& rhs)
+{
+  lhs.resize(std::max(std::size(lhs), std::size(rhs)));
+  for (std::size_t i = 0; i < std::size(rhs); ++i) {
+    lhs[i] -= rhs[i];
+  }
+}
+} // namespace
+
 dram_stats operator-(dram_stats lhs, dram_stats rhs)
 {
   lhs.dbus_cycle_congested -= rhs.dbus_cycle_congested;
@@ -9,5 +22,18 @@ dram_stats operator-(dram_stats lhs, dram_stats rhs)
   lhs.RQ_ROW_BUFFER_HIT -= rhs.RQ_ROW_BUFFER_HIT;
   lhs.RQ_ROW_BUFFER_MISS -= rhs.RQ_ROW_BUFFER_MISS;
   lhs.WQ_FULL -= rhs.WQ_FULL;
+  lhs.refresh_stall_cycles -= rhs.refresh_stall_cycles;
+  lhs.ACT -= rhs.ACT;
+  lhs.PRE -= rhs.PRE;
+  lhs.RD -= rhs.RD;
+  lhs.WR -= rhs.WR;
+  lhs.REF -= rhs.REF;
+  subtract_each(lhs.active_standby_time, rhs.active_standby_time);
+  subtract_each(lhs.precharge_standby_time, rhs.precharge_standby_time);
+  lhs.activate_energy -= rhs.activate_energy;
+  lhs.read_energy -= rhs.read_energy;
+  lhs.write_energy -= rhs.write_energy;
+  lhs.refresh_energy -= rhs.refresh_energy;
+  lhs.background_energy -= rhs.background_energy;
   return lhs;
 }
@@ -0,0 +1,91 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "functional_warmup.h"
+
+#include "cache.h"
+#include "ooo_cpu.h"
+#include "ptw.h"
+
+namespace champsim
+{
+functional_hierarchy::functional_hierarchy(environment& env)
+    : lower([this](champsim::channel* queue, const champsim::channel::request_type& packet) { return this->access(queue, packet); })
+{
+  for (CACHE& cache : env.cache_view()) {
+    for (auto* ul : cache.upper_levels) {
+      caches.insert_or_assign(ul, &cache);
+    }
+  }
+
+  for (PageTableWalker& ptw : env.ptw_view()) {
+    for (auto* ul : ptw.upper_levels) {
+      walkers.insert_or_assign(ul, &ptw);
+    }
+  }
+}
+
+champsim::channel::response_type functional_hierarchy::access(champsim::channel* queue, const champsim::channel::request_type& packet)
+{
+  if (auto cache = caches.find(queue); cache != std::end(caches)) {
+    return cache->second->functional_access(packet, lower);
+  }
+
+  if (auto ptw = walkers.find(queue); ptw != std::end(walkers)) {
+    return ptw->second->functional_access(packet, lower);
+  }
+
+  // Memory returns the block as it was requested
+  return champsim::channel::response_type{packet.address, packet.v_address, packet.data, packet.pf_metadata, packet.instr_depend_on_me};
+}
+
+void functional_hierarchy::execute(O3_CPU& cpu, ooo_model_instr& instr)
+{
+  cpu.do_init_instruction(instr);
+  cpu.do_dib_update(instr);
+
+  auto make_packet = [&cpu, &instr](champsim::address v_address, access_type type) {
+    champsim::channel::request_type packet;
+    packet.address = v_address;
+    packet.v_address = v_address;
+    packet.is_translated = false;
+    packet.cpu = cpu.cpu;
+    packet.type = type;
+    packet.instr_id = instr.instr_id;
+    packet.ip = instr.ip;
+    packet.response_requested = (type != access_type::WRITE);
+    return packet;
+  };
+
+  // Consecutive instructions in the same block share a fetch
+  if (cpu.cpu >= std::size(last_fetch)) {
+    last_fetch.resize(cpu.cpu + 1);
+  }
+  if (champsim::block_number fetch_block{instr.ip}; last_fetch.at(cpu.cpu) != fetch_block) {
+    access(cpu.L1I_bus.lower_channel(), make_packet(instr.ip, access_type::LOAD));
+    last_fetch.at(cpu.cpu) = fetch_block;
+  }
+
+  for (auto src_mem : instr.source_memory) {
+    access(cpu.L1D_bus.lower_channel(), make_packet(src_mem, access_type::LOAD));
+  }
+  for (auto dest_mem : instr.destination_memory) {
+    access(cpu.L1D_bus.lower_channel(), make_packet(dest_mem, access_type::WRITE));
+  }
+
+  ++cpu.num_retired;
+}
+} // namespace champsim
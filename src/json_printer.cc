@@ -36,6 +36,9 @@ void to_json(nlohmann::json& j, const O3_CPU::stats_type& stats)
   j = nlohmann::json{{"instructions", stats.instrs()},
                      {"cycles", stats.cycles()},
                      {"Avg ROB occupancy at mispredict", std::ceil(stats.total_rob_occupancy_at_branch_mispredict) / std::ceil(total_mispredictions)},
+                     {"front-end stall cycles", stats.front_end_stall_cycles},
+                     {"Avg FTQ occupancy", std::ceil(stats.total_ftq_occupancy) / std::ceil(stats.cycles())},
+                     {"wrong-path instructions", stats.wrong_path_instrs},
                      {"mispredict", mpki}};
 }
 
@@ -76,12 +79,33 @@ void to_json(nlohmann::json& j, const CACHE::stats_type& stats)
 
 void to_json(nlohmann::json& j, const DRAM_CHANNEL::stats_type stats)
 {
+  std::vector<champsim::chrono::picoseconds::rep> active_standby_time;
+  std::vector<champsim::chrono::picoseconds::rep> precharge_standby_time;
+  for (auto time : stats.active_standby_time) {
+    active_standby_time.push_back(time.count());
+  }
+  for (auto time : stats.precharge_standby_time) {
+    precharge_standby_time.push_back(time.count());
+  }
+
   j = nlohmann::json{{"RQ ROW_BUFFER_HIT", stats.RQ_ROW_BUFFER_HIT},
                      {"RQ ROW_BUFFER_MISS", stats.RQ_ROW_BUFFER_MISS},
                      {"WQ ROW_BUFFER_HIT", stats.WQ_ROW_BUFFER_HIT},
                      {"WQ ROW_BUFFER_MISS", stats.WQ_ROW_BUFFER_MISS},
                      {"AVG DBUS CONGESTED CYCLE", (std::ceil(stats.dbus_cycle_congested) / std::ceil(stats.dbus_count_congested))},
-                     {"REFRESHES ISSUED", stats.refresh_cycles}};
+                     {"REFRESHES ISSUED", stats.refresh_cycles},
+                     {"REFRESH STALL CYCLES", stats.refresh_stall_cycles},
+                     {"COMMANDS", {{"ACT", stats.ACT}, {"PRE", stats.PRE}, {"RD", stats.RD}, {"WR", stats.WR}}},
+                     {"BANK REFRESHES", stats.REF},
+                     {"ACTIVE STANDBY TIME (ps)", active_standby_time},
+                     {"PRECHARGE STANDBY TIME (ps)", precharge_standby_time},
+                     {"ENERGY (pJ)",
+                      {{"activate", stats.activate_energy},
+                       {"read", stats.read_energy},
+                       {"write", stats.write_energy},
+                       {"refresh", stats.refresh_energy},
+                       {"background", stats.background_energy},
+                       {"total", stats.total_energy()}}}};
 }
 
 namespace champsim
@@ -24,10 +24,12 @@
 
 #include "cache.h" // for CACHE
 #include "champsim.h"
+#include "checkpoint.h"
 #ifndef CHAMPSIM_TEST_BUILD
 #include "core_inst.inc"
 #endif
 #include "defaults.hpp"
+#include "dram_replay.h"
 #include "environment.h"
 #include "event_listeners.h"
 #include "ooo_cpu.h" // for O3_CPU
@@ -38,7 +40,7 @@
 
 namespace champsim
 {
-std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces);
+std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces, const run_options& options);
 }
 
 #ifndef CHAMPSIM_TEST_BUILD
@@ -60,11 +62,17 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
   CLI::App app{"A microarchitecture simulator for research and education"};
 
   bool knob_cloudsuite{false};
+  bool knob_op_class{false};
+  bool knob_async_traces{false};
+  uint64_t skip_instructions = 0;
   long long warmup_instructions = 0;
   long long simulation_instructions = std::numeric_limits<long long>::max();
   std::string json_file_name;
   std::vector<std::string> requested_listeners;
   std::vector<std::string> trace_names;
+  std::string capture_dram_trace_name;
+  std::string dram_replay_name;
+  champsim::run_options run_options;
 
   auto set_heartbeat_callback = [&](auto) {
     for (O3_CPU& cpu : gen_environment.cpu_view()) {
@@ -72,8 +80,27 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
     }
   };
 
-  app.add_flag("-c,--cloudsuite", knob_cloudsuite, "Read all traces using the cloudsuite format");
+  auto set_cache_only_callback = [&](auto) {
+    for (O3_CPU& cpu : gen_environment.cpu_view()) {
+      cpu.cache_only = true;
+    }
+  };
+
+  auto* cloudsuite_opt = app.add_flag("-c,--cloudsuite", knob_cloudsuite, "Read all traces using the cloudsuite format");
+  app.add_flag("--op-class-traces", knob_op_class, "Read all traces using the format that records the op class of each instruction")->excludes(cloudsuite_opt);
+  app.add_flag("--async-traces", knob_async_traces, "Decompress and decode each trace on a background thread");
   app.add_flag("--hide-heartbeat", set_heartbeat_callback, "Hide the heartbeat output");
+  auto set_wrong_path_callback = [&](auto) {
+    for (O3_CPU& cpu : gen_environment.cpu_view()) {
+      cpu.wrong_path = true;
+    }
+  };
+
+  app.add_flag("--cache-only", set_cache_only_callback,
+               "Bypass the core pipeline and issue each instruction's fetch and memory accesses directly to the caches, for fast exploration of the cache "
+               "hierarchy");
+  app.add_flag("--wrong-path", set_wrong_path_callback,
+               "Fetch and execute instructions down the wrong path after a branch misprediction, replaying them from the code seen so far in the trace");
   auto* warmup_instr_option = app.add_option("-w,--warmup-instructions", warmup_instructions, "The number of instructions in the warmup phase");
   auto* deprec_warmup_instr_option =
       app.add_option("--warmup_instructions", warmup_instructions, "[deprecated] use --warmup-instructions instead")->excludes(warmup_instr_option);
@@ -81,18 +108,79 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
                                           "The number of instructions in the detailed phase. If not specified, run to the end of the trace.");
   auto* deprec_sim_instr_option =
       app.add_option("--simulation_instructions", simulation_instructions, "[deprecated] use --simulation-instructions instead")->excludes(sim_instr_option);
+  app.add_option("--skip-instructions", skip_instructions,
+                 "The number of instructions at the beginning of each trace to skip over before the warmup phase. The trace index is used if there is one.");
 
   auto* json_option =
       app.add_option("--json", json_file_name, "The name of the file to receive JSON output. If no name is specified, stdout will be used")->expected(0, 1);
 
   app.add_option("--listeners", requested_listeners, "A list of the listeners to be attached to the run");
 
-  app.add_option("traces", trace_names, "The paths to the traces")->required()->expected(NUM_CPUS)->check(CLI::ExistingFile);
+  app.add_option("--threads", run_options.num_threads, "The number of host threads used to simulate the cores in parallel")->check(CLI::PositiveNumber);
+  app.add_option("--sync-quantum", run_options.sync_quantum,
+                 "The number of cycles the cores may run ahead of the shared cache and memory in parallel mode. A quantum of 1 is identical to a serial run.")
+      ->check(CLI::PositiveNumber);
+
+  app.add_option("--save-checkpoint", run_options.save_checkpoint, "Save the warm state of the simulator to this file at the end of the warmup phase");
+  app.add_option("--load-checkpoint", run_options.load_checkpoint, "Restore the warm state of the simulator from this file instead of running the warmup phase")
+      ->check(CLI::ExistingFile);
+  app.add_flag("--functional-warmup", run_options.functional_warmup,
+               "Warm the predictors, caches, and page tables functionally, without modeling time, during the warmup phase");
+
+  app.add_option("--capture-dram-trace", capture_dram_trace_name, "Write every request that reaches the memory controllers after warmup to this file");
+  auto* dram_replay_option = app.add_option("--dram-replay", dram_replay_name,
+                                            "Replay a memory trace into the memory controllers alone, instead of simulating the cores with traces")
+                                 ->check(CLI::ExistingFile);
+
+  auto* traces_option =
+      app.add_option("traces", trace_names, "The paths to the traces")->expected(NUM_CPUS)->check(CLI::ExistingFile)->excludes(dram_replay_option);
 
   CLI11_PARSE(app, argc, argv);
 
+  if (traces_option->count() == 0 && dram_replay_option->count() == 0) {
+    fmt::print(stderr, "{} traces are required, or a memory trace with --dram-replay\n", NUM_CPUS);
+    return 1;
+  }
+
+  std::ofstream capture_dram_trace_file;
+  if (!capture_dram_trace_name.empty()) {
+    capture_dram_trace_file.open(capture_dram_trace_name);
+    std::get<DramTrace>(listeners).trace_out = &capture_dram_trace_file;
+    requested_listeners.emplace_back(DramTrace::cli_key);
+  }
+
   init_event_listeners(requested_listeners);
 
+  if (dram_replay_option->count() > 0) {
+    std::ifstream dram_replay_file{dram_replay_name};
+    std::vector<champsim::phase_stats> phase_stats;
+    try {
+      phase_stats.push_back(champsim::replay_dram_trace(gen_environment, dram_replay_file));
+    } catch (const std::invalid_argument& err) {
+      fmt::print(stderr, "{}\n", err.what());
+      return 1;
+    }
+
+    champsim::plain_printer{std::cout}.print(phase_stats);
+
+    for (const MEMORY_CONTROLLER& dram : gen_environment.dram_view()) {
+      for (const auto& chan : dram.channels) {
+        chan.impl_dram_scheduler_final_stats();
+      }
+    }
+
+    if (json_option->count() > 0) {
+      if (json_file_name.empty()) {
+        champsim::json_printer{std::cout}.print(phase_stats);
+      } else {
+        std::ofstream json_file{json_file_name};
+        champsim::json_printer{json_file}.print(phase_stats);
+      }
+    }
+
+    return 0;
+  }
+
   const bool warmup_given = (warmup_instr_option->count() > 0) || (deprec_warmup_instr_option->count() > 0);
   const bool simulation_given = (sim_instr_option->count() > 0) || (deprec_sim_instr_option->count() > 0);
 
@@ -110,10 +198,16 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
     warmup_instructions = simulation_instructions / 5;
   }
 
+  champsim::tracereader_options trace_options;
+  trace_options.cloudsuite = knob_cloudsuite;
+  trace_options.op_class = knob_op_class;
+  trace_options.repeat = simulation_given;
+  trace_options.async = knob_async_traces;
+  trace_options.skip_instructions = skip_instructions;
+
   std::vector<champsim::tracereader> traces;
-  std::transform(
-      std::begin(trace_names), std::end(trace_names), std::back_inserter(traces),
-      [knob_cloudsuite, repeat = simulation_given, i = uint8_t(0)](auto name) mutable { return get_tracereader(name, i++, knob_cloudsuite, repeat); });
+  std::transform(std::begin(trace_names), std::end(trace_names), std::back_inserter(traces),
+                 [&trace_options, i = uint8_t(0)](auto name) mutable { return get_tracereader(name, i++, trace_options); });
 
   std::vector<champsim::phase_info> phases{
       {champsim::phase_info{"Warmup", true, warmup_instructions, std::vector<std::size_t>(std::size(trace_names), 0), trace_names},
@@ -126,7 +220,13 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
   fmt::print("\n*** ChampSim Multicore Out-of-Order Simulator ***\nWarmup Instructions: {}\nSimulation Instructions: {}\nNumber of CPUs: {}\nPage size: {}\n\n",
              phases.at(0).length, phases.at(1).length, std::size(gen_environment.cpu_view()), PAGE_SIZE);
 
-  auto phase_stats = champsim::main(gen_environment, phases, traces);
+  std::vector<champsim::phase_stats> phase_stats;
+  try {
+    phase_stats = champsim::main(gen_environment, phases, traces, run_options);
+  } catch (const champsim::checkpoint_error& err) {
+    fmt::print(stderr, "{}\n", err.what());
+    return 1;
+  }
 
   fmt::print("\nChampSim completed all CPUs\n\n");
 
@@ -140,6 +240,12 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
     cache.impl_replacement_final_stats();
   }
 
+  for (const MEMORY_CONTROLLER& dram : gen_environment.dram_view()) {
+    for (const auto& chan : dram.channels) {
+      chan.impl_dram_scheduler_final_stats();
+    }
+  }
+
   if (json_option->count() > 0) {
     if (json_file_name.empty()) {
       champsim::json_printer{std::cout}.print(phase_stats);
@@ -0,0 +1,81 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mmap_tracereader.h"
+
+#include <cerrno>
+#include <system_error>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+champsim::mapped_file::mapped_file(const std::string& fname)
+{
+  int fd = ::open(fname.c_str(), O_RDONLY); // NOLINT(cppcoreguidelines-pro-type-vararg)
+  if (fd < 0) {
+    throw std::system_error{errno, std::generic_category(), "Could not open " + fname};
+  }
+
+  struct stat file_status {
+  };
+  if (::fstat(fd, &file_status) < 0) {
+    auto err = errno;
+    ::close(fd);
+    throw std::system_error{err, std::generic_category(), "Could not find the size of " + fname};
+  }
+  m_size = static_cast<std::size_t>(file_status.st_size);
+
+  // An empty file cannot be mapped, but it is a valid (empty) trace
+  if (m_size > 0) {
+    void* addr = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+      auto err = errno;
+      ::close(fd);
+      throw std::system_error{err, std::generic_category(), "Could not map " + fname};
+    }
+    m_data = static_cast<const std::byte*>(addr);
+
+    // These are only hints, so failures are ignored
+    ::madvise(addr, m_size, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+    ::madvise(addr, m_size, MADV_HUGEPAGE);
+#endif
+  }
+
+  ::close(fd);
+}
+
+champsim::mapped_file::~mapped_file()
+{
+  if (m_data != nullptr) {
+    ::munmap(const_cast<std::byte*>(m_data), m_size); // NOLINT(cppcoreguidelines-pro-type-const-cast)
+  }
+}
+
+champsim::mapped_file::mapped_file(mapped_file&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0))
+{
+}
+
+champsim::mapped_file& champsim::mapped_file::operator=(mapped_file&& other) noexcept
+{
+  // The old mapping is released when other is destroyed
+  std::swap(m_data, other.m_data);
+  std::swap(m_size, other.m_size);
+  return *this;
+}
@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <iterator>
 #include <numeric>
 #include <fmt/chrono.h>
 #include <fmt/core.h>
@@ -33,7 +34,15 @@
 
 long O3_CPU::operate()
 {
+  if (cache_only) {
+    return operate_cache_only();
+  }
+
   long progress{0};
+  if (front_end_stalled()) {
+    ++sim_stats.front_end_stall_cycles;
+  }
+
   progress += retire_rob();                    // retire
   progress += complete_inflight_instruction(); // finalize execution
   progress += execute_instruction();           // execute instructions
@@ -48,10 +57,121 @@ long O3_CPU::operate()
   progress += fetch_instruction(); // fetch
   progress += check_dib();
   initialize_instruction();
+  progress += predict_fetch_targets();
+
+  sim_stats.total_ftq_occupancy += std::size(ftq_block_lengths);
 
   return progress;
 }
 
+void O3_CPU::skip_cycles(long count)
+{
+  // Skipped cycles do no work, so the front end is stalled in each of them exactly when it is stalled now
+  if (front_end_stalled()) {
+    sim_stats.front_end_stall_cycles += static_cast<uint64_t>(count);
+  }
+  sim_stats.total_ftq_occupancy += static_cast<uint64_t>(count) * std::size(ftq_block_lengths);
+}
+
+bool O3_CPU::front_end_stalled() const { return !cache_only && std::empty(DISPATCH_BUFFER) && std::size(ROB) < ROB_SIZE; }
+
+champsim::chrono::clock::time_point O3_CPU::next_event() const
+{
+  const auto next_cycle = current_time + clock_period;
+
+  if (cache_only) {
+    // The only wait with no known end is for a load to return when too many are outstanding
+    if (!std::empty(L1I_bus.lower_level->returned) || !std::empty(L1D_bus.lower_level->returned)) {
+      return next_cycle;
+    }
+    if (std::empty(input_queue)) {
+      return champsim::chrono::clock::time_point::max();
+    }
+    const auto& head = input_queue.front();
+    bool awaits_load = head.fetch_issued && head.completed_mem_ops < std::size(head.source_memory) && std::size(cache_only_outstanding_loads) >= std::size(LQ);
+    return awaits_load ? champsim::chrono::clock::time_point::max() : next_cycle;
+  }
+
+  // Work that does not wait on a timer
+  auto needs_fetch = [](const ooo_model_instr& x) {
+    return !x.dib_checked || !x.fetch_issued;
+  };
+  if (!std::empty(L1I_bus.lower_level->returned) || !std::empty(L1D_bus.lower_level->returned) || (!std::empty(ROB) && ROB.front().completed)
+      || !std::empty(ready_to_execute)
+      || std::any_of(std::begin(IFETCH_BUFFER), std::end(IFETCH_BUFFER), needs_fetch)) {
+    return next_cycle;
+  }
+
+  // Work that becomes ready at a known time. Work that waits on register or memory dependencies is woken by the completion of another instruction.
+  auto next = champsim::chrono::clock::time_point::max();
+  auto consider = [&next](champsim::chrono::clock::time_point time) {
+    next = std::min(next, time);
+  };
+
+  if (!std::empty(executing)) {
+    consider(executing.top().first);
+  }
+  for (auto pos : finished_executing) {
+    if (const auto* rob_entry = rob_entry_at(pos); rob_entry != nullptr && !rob_entry->completed && rob_entry->completed_mem_ops == rob_entry->num_mem_ops()) {
+      consider(rob_entry->ready_time);
+    }
+  }
+
+  // Follow the scheduler's window
+  auto [window_begin, search_bw] = scheduler_window();
+  for (auto rob_it = std::next(std::begin(ROB), static_cast<long>(window_begin)); rob_it != std::end(ROB) && search_bw.has_remaining(); ++rob_it) {
+    if (reg_allocator.count_free_registers() < registers_needed(*rob_it)) {
+      break;
+    }
+    if (!rob_it->scheduled) {
+      consider(rob_it->ready_time);
+    }
+    if (!rob_it->executed) {
+      search_bw.consume();
+    }
+  }
+
+  const auto complete_id = std::empty(ROB) ? std::numeric_limits<uint64_t>::max() : ROB.front().instr_id;
+  for (const auto& sq_entry : SQ) {
+    if (!sq_entry.fetch_issued || LSQ_ENTRY::precedes(complete_id)(sq_entry)) {
+      consider(sq_entry.ready_time);
+    }
+  }
+  for (auto slot : lq_ready_slots) {
+    consider(LQ.at(slot)->ready_time + champsim::chrono::picoseconds{1}); // loads issue strictly after they become ready
+  }
+
+  if (!std::empty(DISPATCH_BUFFER) && std::size(ROB) != ROB_SIZE
+      && (std::size(lq_free_slots) >= std::size(DISPATCH_BUFFER.front().source_memory))
+      && ((std::size(DISPATCH_BUFFER.front().destination_memory) + std::size(SQ)) <= SQ_SIZE)) {
+    consider(DISPATCH_BUFFER.front().ready_time);
+  }
+
+  if (std::size(DISPATCH_BUFFER) < DISPATCH_BUFFER_SIZE) {
+    for (const auto* buffer : {&DIB_HIT_BUFFER, &DECODE_BUFFER}) {
+      if (!std::empty(*buffer)) {
+        consider(buffer->front().ready_time);
+      }
+    }
+  }
+
+  if (std::size(DIB_HIT_BUFFER) < DIB_HIT_BUFFER_SIZE && std::size(DECODE_BUFFER) < DECODE_BUFFER_SIZE) {
+    for (auto it = std::begin(IFETCH_BUFFER); it != std::end(IFETCH_BUFFER) && it->fetch_completed; ++it) {
+      consider(it->ready_time);
+    }
+  }
+
+  const bool predict_has_room = FTQ_SIZE > 0 ? std::size(ftq_block_lengths) < FTQ_SIZE : std::size(IFETCH_BUFFER) < IFETCH_BUFFER_SIZE;
+  if ((FTQ_SIZE > 0 && !std::empty(FTQ) && std::size(IFETCH_BUFFER) < IFETCH_BUFFER_SIZE) || (predict_has_room && wrong_path_next.has_value())) {
+    return next_cycle;
+  }
+  if (predict_has_room && !std::empty(input_queue)) {
+    consider(fetch_resume_time);
+  }
+
+  return std::max(next, next_cycle);
+}
+
 void O3_CPU::initialize()
 {
   // BRANCH PREDICTOR & BTB
@@ -86,25 +206,99 @@ void O3_CPU::end_phase(unsigned finished_cpu)
   }
 }
 
+void O3_CPU::check_checkpoint_support() const
+{
+  if (!branch_module_pimpl->impl_branch_predictor_has_checkpoint()) {
+    throw champsim::checkpoint_error{"The branch predictor of CPU " + std::to_string(cpu) + " does not support checkpoints"};
+  }
+  if (!btb_module_pimpl->impl_btb_has_checkpoint()) {
+    throw champsim::checkpoint_error{"The BTB of CPU " + std::to_string(cpu) + " does not support checkpoints"};
+  }
+}
+
+void O3_CPU::save_checkpoint(champsim::checkpoint_writer& writer) const
+{
+  check_checkpoint_support();
+  writer.begin_section("CPU " + std::to_string(cpu));
+  writer.write(num_retired);
+  writer.write(DIB);
+  branch_module_pimpl->impl_branch_predictor_save_checkpoint(writer);
+  btb_module_pimpl->impl_btb_save_checkpoint(writer);
+}
+
+void O3_CPU::load_checkpoint(champsim::checkpoint_reader& reader)
+{
+  check_checkpoint_support();
+  reader.begin_section("CPU " + std::to_string(cpu));
+  reader.read(num_retired);
+  reader.read(DIB);
+  branch_module_pimpl->impl_branch_predictor_load_checkpoint(reader);
+  btb_module_pimpl->impl_btb_load_checkpoint(reader);
+}
+
 void O3_CPU::initialize_instruction()
 {
   champsim::bandwidth instrs_to_read_this_cycle{
       std::min(FETCH_WIDTH, champsim::bandwidth::maximum_type{static_cast<long>(IFETCH_BUFFER_SIZE - std::size(IFETCH_BUFFER))})};
 
+  if (FTQ_SIZE > 0) {
+    // Fetch from the head block of the fetch target queue. These instructions were predicted when they entered it.
+    while (instrs_to_read_this_cycle.has_remaining() && !std::empty(ftq_block_lengths)) {
+      instrs_to_read_this_cycle.consume();
+
+      IFETCH_BUFFER.push_back(std::move(FTQ.front()));
+      FTQ.pop_front();
+
+      IFETCH_BUFFER.back().ready_time = current_time;
+
+      if (--ftq_block_lengths.front() == 0) {
+        ftq_block_lengths.pop_front();
+        break; // one fetch block per cycle
+      }
+    }
+    return;
+  }
+
   bool stop_fetch = false;
-  while (current_time >= fetch_resume_time && instrs_to_read_this_cycle.has_remaining() && !stop_fetch && !std::empty(input_queue)) {
+  while (instrs_to_read_this_cycle.has_remaining() && !stop_fetch && next_predicted_instruction() != nullptr) {
     instrs_to_read_this_cycle.consume();
 
-    stop_fetch = do_init_instruction(input_queue.front());
-
     // Add to IFETCH_BUFFER
-    IFETCH_BUFFER.push_back(input_queue.front());
-    input_queue.pop_front();
-
+    stop_fetch = take_predicted_instruction(IFETCH_BUFFER);
     IFETCH_BUFFER.back().ready_time = current_time;
   }
 }
 
+long O3_CPU::predict_fetch_targets()
+{
+  const auto* next = next_predicted_instruction();
+  if (FTQ_SIZE == 0 || std::size(ftq_block_lengths) >= FTQ_SIZE || next == nullptr) {
+    return 0;
+  }
+
+  // A fetch block ends at the end of a cache block, or at a branch that is predicted taken or mispredicted
+  const champsim::block_number block{next->ip};
+  std::size_t length = 0;
+  bool stop_fetch = false;
+  while (!stop_fetch && (next = next_predicted_instruction()) != nullptr && champsim::block_number{next->ip} == block) {
+    stop_fetch = take_predicted_instruction(FTQ);
+    ++length;
+  }
+  ftq_block_lengths.push_back(length);
+
+  // Prefetch the block unless the previous fetch block was in it. A prefetch that does not fit in the queue is dropped.
+  if (ftq_last_prefetch != block) {
+    CacheBus::request_type pf_packet;
+    pf_packet.v_address = FTQ.back().ip;
+    pf_packet.instr_id = FTQ.back().instr_id;
+    pf_packet.ip = FTQ.back().ip;
+    L1I_bus.issue_prefetch(pf_packet);
+    ftq_last_prefetch = block;
+  }
+
+  return 1;
+}
+
 namespace
 {
 void do_stack_pointer_folding(ooo_model_instr& arch_instr)
@@ -157,6 +351,10 @@ bool O3_CPU::do_predict_branch(ooo_model_instr& arch_instr)
         fetch_resume_time = champsim::chrono::clock::time_point::max();
         stop_fetch = true;
         arch_instr.branch_mispredicted = true;
+
+        if (wrong_path) {
+          begin_wrong_path(arch_instr.branch_prediction ? predicted_branch_target : code_image.at(arch_instr.ip.to<uint64_t>()).fall_through);
+        }
       }
     } else {
       stop_fetch = arch_instr.branch_taken; // if correctly predicted taken, then we can't fetch anymore instructions this cycle
@@ -171,6 +369,10 @@ bool O3_CPU::do_predict_branch(ooo_model_instr& arch_instr)
 
 bool O3_CPU::do_init_instruction(ooo_model_instr& arch_instr)
 {
+  if (wrong_path) {
+    learn_code_image(arch_instr);
+  }
+
   // fast warmup eliminates register dependencies between instructions branch predictor, cache contents, and prefetchers are still warmed up
   if (warmup) {
     arch_instr.source_registers.clear();
@@ -181,6 +383,180 @@ bool O3_CPU::do_init_instruction(ooo_model_instr& arch_instr)
   return do_predict_branch(arch_instr);
 }
 
+/*
+ * The front end takes instructions from the input queue unless it is waiting on a misprediction, in which case it takes them from the wrong
+ * path, if there is one.
+ */
+ooo_model_instr* O3_CPU::next_predicted_instruction()
+{
+  if (current_time >= fetch_resume_time && !std::empty(input_queue)) {
+    return &input_queue.front();
+  }
+  if (wrong_path_next.has_value()) {
+    return &wrong_path_next.value();
+  }
+  return nullptr;
+}
+
+bool O3_CPU::take_predicted_instruction(champsim::ring_buffer<ooo_model_instr>& buffer)
+{
+  if (current_time >= fetch_resume_time && !std::empty(input_queue)) {
+    bool stop_fetch = do_init_instruction(input_queue.front());
+    buffer.push_back(std::move(input_queue.front()));
+    input_queue.pop_front();
+    return stop_fetch;
+  }
+
+  // Wrong-path instructions follow the path they took when they were learned, and do not consult or train the branch predictor
+  buffer.push_back(std::move(wrong_path_next.value()));
+  ++sim_stats.wrong_path_instrs;
+  begin_wrong_path(wrong_path_successor);
+  return buffer.back().branch_taken;
+}
+
+void O3_CPU::learn_code_image(const ooo_model_instr& instr)
+{
+  if (code_image_last_ip.has_value()) {
+    auto& last = code_image.at(code_image_last_ip->to<uint64_t>());
+    if (!last.instr.branch_taken) {
+      last.fall_through = instr.ip;
+    }
+  }
+
+  if (auto [entry, inserted] = code_image.try_emplace(instr.ip.to<uint64_t>(), code_image_entry{instr}); !inserted) {
+    entry->second.instr = instr;
+  }
+  code_image_last_ip = instr.ip;
+}
+
+void O3_CPU::begin_wrong_path(champsim::address ip)
+{
+  wrong_path_next.reset();
+
+  auto entry = code_image.find(ip.to<uint64_t>());
+  if (ip == champsim::address{} || entry == std::end(code_image)) {
+    return;
+  }
+
+  auto& instr = wrong_path_next.emplace(entry->second.instr);
+  instr.instr_id = wrong_path_instr_id++;
+  ::do_stack_pointer_folding(instr);
+  wrong_path_successor = instr.branch_taken ? instr.branch_target : entry->second.fall_through;
+}
+
+void O3_CPU::resolve_wrong_path(const ooo_model_instr& branch)
+{
+  if (wrong_path) {
+    wrong_path_next.reset();
+    wrong_path_squash_after = branch.instr_id;
+  }
+}
+
+void O3_CPU::squash_wrong_path()
+{
+  if (!wrong_path_squash_after.has_value()) {
+    return;
+  }
+  const auto younger = [id = wrong_path_squash_after.value()](const auto& x) {
+    return x.instr_id > id;
+  };
+  const auto is_younger_load = [younger](const std::optional<LSQ_ENTRY>& x) {
+    return x.has_value() && younger(*x);
+  };
+  wrong_path_squash_after.reset();
+
+  // The front end
+  while (!std::empty(FTQ) && younger(FTQ.back())) {
+    FTQ.pop_back();
+    if (--ftq_block_lengths.back() == 0) {
+      ftq_block_lengths.pop_back();
+    }
+  }
+  for (auto* buffer : {&IFETCH_BUFFER, &DIB_HIT_BUFFER, &DECODE_BUFFER, &DISPATCH_BUFFER}) {
+    buffer->erase(std::remove_if(std::begin(*buffer), std::end(*buffer), younger), std::end(*buffer));
+  }
+
+  // The load queue. Loads that were issued are dropped when they return.
+  for (auto& sq_entry : SQ) {
+    auto& dependents = sq_entry.lq_depend_on_me;
+    dependents.erase(std::remove_if(std::begin(dependents), std::end(dependents), is_younger_load), std::end(dependents));
+  }
+  auto ready_end = std::remove_if(std::begin(lq_ready_slots), std::end(lq_ready_slots), [&](auto slot) { return is_younger_load(LQ.at(slot)); });
+  lq_ready_slots.erase(ready_end, std::end(lq_ready_slots));
+  for (auto it = std::begin(lq_issued_slots_by_block); it != std::end(lq_issued_slots_by_block);) {
+    it = is_younger_load(LQ.at(it->second)) ? lq_issued_slots_by_block.erase(it) : std::next(it);
+  }
+  for (std::size_t slot = 0; slot < std::size(LQ); ++slot) {
+    if (is_younger_load(LQ[slot])) {
+      release_lq_entry(slot);
+    }
+  }
+
+  // The store queue, which is in program order. The youngest remaining store to each address is found again.
+  auto sq_squash_begin = std::find_if(std::begin(SQ), std::end(SQ), younger);
+  std::vector<uint64_t> stored_addresses;
+  for (auto sq_it = sq_squash_begin; sq_it != std::end(SQ); ++sq_it) {
+    auto stores = sq_stores_by_address.find(sq_it->virtual_address.to<uint64_t>());
+    assert(stores != std::end(sq_stores_by_address));
+    if (--stores->second.second == 0) {
+      sq_stores_by_address.erase(stores);
+    } else {
+      stored_addresses.push_back(stores->first);
+    }
+  }
+  SQ.erase(sq_squash_begin, std::end(SQ));
+  std::sort(std::begin(stored_addresses), std::end(stored_addresses));
+  stored_addresses.erase(std::unique(std::begin(stored_addresses), std::end(stored_addresses)), std::end(stored_addresses));
+  for (auto address : stored_addresses) {
+    // A later squashed store to the same address may have removed the last of its stores
+    auto stores = sq_stores_by_address.find(address);
+    if (stores == std::end(sq_stores_by_address)) {
+      continue;
+    }
+    auto youngest = std::find_if(std::rbegin(SQ), std::rend(SQ), [address](const auto& x) { return x.virtual_address.template to<uint64_t>() == address; });
+    assert(youngest != std::rend(SQ));
+    stores->second.first = youngest->instr_id;
+  }
+
+  // The ROB. The registers renamed on the wrong path are freed, and the frontend RAT is rebuilt from the instructions that remain.
+  auto rob_squash_begin = std::find_if(std::begin(ROB), std::end(ROB), younger);
+  const auto squash_position = rob_head_position + static_cast<rob_position>(std::distance(std::begin(ROB), rob_squash_begin));
+  for (auto rob_it = rob_squash_begin; rob_it != std::end(ROB); ++rob_it) {
+    if (rob_it->scheduled) {
+      std::for_each(std::begin(rob_it->destination_registers), std::end(rob_it->destination_registers),
+                    [this](auto dreg) { reg_allocator.free_register(dreg); });
+      if (!rob_it->executed) {
+        --scheduled_unexecuted;
+      }
+    }
+  }
+  ROB.erase(rob_squash_begin, std::end(ROB));
+
+  reg_allocator.squash_consumers(squash_position);
+  reg_allocator.reset_frontend_RAT();
+  for (auto rob_it = std::begin(ROB); rob_it != std::end(ROB) && rob_it->scheduled; ++rob_it) {
+    std::for_each(std::begin(rob_it->destination_registers), std::end(rob_it->destination_registers),
+                  [this](auto dreg) { reg_allocator.restore_dest_register(dreg); });
+  }
+
+  // Forget the positions of the squashed instructions, which will be reused
+  auto is_squashed = [squash_position](rob_position pos) {
+    return pos >= squash_position;
+  };
+  ready_to_execute.erase(std::remove_if(std::begin(ready_to_execute), std::end(ready_to_execute), is_squashed), std::end(ready_to_execute));
+  finished_executing.erase(std::remove_if(std::begin(finished_executing), std::end(finished_executing), is_squashed), std::end(finished_executing));
+  while (!std::empty(scheduled_register_demand) && is_squashed(scheduled_register_demand.back().first)) {
+    scheduled_register_demand.pop_back();
+  }
+  decltype(executing) still_executing;
+  for (; !std::empty(executing); executing.pop()) {
+    if (!is_squashed(executing.top().second)) {
+      still_executing.push(executing.top());
+    }
+  }
+  executing = std::move(still_executing);
+}
+
 long O3_CPU::check_dib()
 {
   // scan through IFETCH_BUFFER to find instructions that hit in the decoded instruction buffer
@@ -247,7 +623,7 @@ long O3_CPU::fetch_instruction()
   return progress;
 }
 
-bool O3_CPU::do_fetch_instruction(std::deque<ooo_model_instr>::iterator begin, std::deque<ooo_model_instr>::iterator end)
+bool O3_CPU::do_fetch_instruction(champsim::ring_buffer<ooo_model_instr>::iterator begin, champsim::ring_buffer<ooo_model_instr>::iterator end)
 {
   CacheBus::request_type fetch_packet;
   fetch_packet.v_address = begin->ip;
@@ -356,6 +732,7 @@ long O3_CPU::decode_instruction()
         db_entry.branch_mispredicted = 0;
         // pay misprediction penalty
         this->fetch_resume_time = this->current_time + BRANCH_MISPREDICT_PENALTY;
+        this->resolve_wrong_path(db_entry);
       }
     }
     // Add to dispatch
@@ -375,10 +752,12 @@ long O3_CPU::decode_instruction()
 
   long progress{std::distance(dib_hit_buffer_begin, dib_hit_buffer_end) + std::distance(decode_buffer_begin, decode_buffer_end)};
 
-  std::merge(dib_hit_buffer_begin, dib_hit_buffer_end, decode_buffer_begin, decode_buffer_end, std::back_inserter(DISPATCH_BUFFER),
+  std::merge(std::make_move_iterator(dib_hit_buffer_begin), std::make_move_iterator(dib_hit_buffer_end), std::make_move_iterator(decode_buffer_begin),
+             std::make_move_iterator(decode_buffer_end), std::back_inserter(DISPATCH_BUFFER),
              ooo_model_instr::program_order);
   DECODE_BUFFER.erase(decode_buffer_begin, decode_buffer_end);
   DIB_HIT_BUFFER.erase(dib_hit_buffer_begin, dib_hit_buffer_end);
+  squash_wrong_path();
 
   return progress;
 }
@@ -392,8 +771,7 @@ long O3_CPU::dispatch_instruction()
   // dispatch DISPATCH_WIDTH instructions into the ROB
   while (available_dispatch_bandwidth.has_remaining() && !std::empty(DISPATCH_BUFFER) && DISPATCH_BUFFER.front().ready_time <= current_time
          && std::size(ROB) != ROB_SIZE
-         && ((std::size_t)std::count_if(std::begin(LQ), std::end(LQ), [](const auto& lq_entry) { return !lq_entry.has_value(); })
-             >= std::size(DISPATCH_BUFFER.front().source_memory))
+         && (std::size(lq_free_slots) >= std::size(DISPATCH_BUFFER.front().source_memory))
          && ((std::size(DISPATCH_BUFFER.front().destination_memory) + std::size(SQ)) <= SQ_SIZE)) {
     ROB.push_back(std::move(DISPATCH_BUFFER.front()));
     DISPATCH_BUFFER.pop_front();
@@ -406,27 +784,86 @@ long O3_CPU::dispatch_instruction()
   return available_dispatch_bandwidth.amount_consumed();
 }
 
-long O3_CPU::schedule_instruction()
+ooo_model_instr* O3_CPU::rob_entry_at(rob_position pos) { return const_cast<ooo_model_instr*>(std::as_const(*this).rob_entry_at(pos)); }
+
+const ooo_model_instr* O3_CPU::rob_entry_at(rob_position pos) const
+{
+  if (pos < rob_head_position || pos - rob_head_position >= std::size(ROB)) {
+    return nullptr;
+  }
+  return &ROB[static_cast<std::size_t>(pos - rob_head_position)];
+}
+
+unsigned long O3_CPU::registers_needed(const ooo_model_instr& instr) const
+{
+  auto sources_to_allocate = std::count_if(std::begin(instr.source_registers), std::end(instr.source_registers),
+                                           [&alloc = std::as_const(reg_allocator)](auto srcreg) { return !alloc.isAllocated(srcreg); });
+  return static_cast<unsigned long>(sources_to_allocate) + std::size(instr.destination_registers);
+}
+
+/*
+ * The scheduler examines the ROB from its head. It stops after it has passed SCHEDULER_SIZE instructions that have not executed, or at the
+ * first instruction for which there are too few free physical registers. Because instructions are scheduled in program order, the scheduled
+ * instructions are a prefix of the ROB, and the part of the search that passes over them is determined by the number of them that have not
+ * executed and the greatest number of registers any of them would need.
+ *
+ * Returns the index in the ROB at which the search continues, and the search bandwidth that remains there.
+ */
+std::pair<std::size_t, champsim::bandwidth> O3_CPU::scheduler_window() const
 {
   champsim::bandwidth search_bw{SCHEDULER_SIZE};
+  search_bw.consume(std::min(scheduled_unexecuted, search_bw.amount_remaining()));
+
+  auto most_needed = std::empty(scheduled_register_demand) ? 0ul : scheduled_register_demand.front().second;
+  if (!search_bw.has_remaining() || reg_allocator.count_free_registers() < most_needed) {
+    return {std::size(ROB), search_bw};
+  }
+
+  auto first_unscheduled = std::partition_point(std::begin(ROB), std::end(ROB), [](const auto& x) { return x.scheduled; });
+  return {static_cast<std::size_t>(std::distance(std::begin(ROB), first_unscheduled)), search_bw};
+}
+
+void O3_CPU::track_register_demand(rob_position pos)
+{
+  auto needed = registers_needed(*rob_entry_at(pos));
+  while (!std::empty(scheduled_register_demand) && scheduled_register_demand.back().second <= needed) {
+    scheduled_register_demand.pop_back();
+  }
+  scheduled_register_demand.emplace_back(pos, needed);
+}
+
+long O3_CPU::schedule_instruction()
+{
+  auto [window_begin, search_bw] = scheduler_window();
   int progress{0};
-  for (auto rob_it = std::begin(ROB); rob_it != std::end(ROB) && search_bw.has_remaining(); ++rob_it) {
+  for (auto pos = window_begin; pos < std::size(ROB) && search_bw.has_remaining(); ++pos) {
+    auto& rob_entry = ROB[pos];
     // if there aren't enough physical registers available for the next instruction, stop scheduling
-    unsigned long sources_to_allocate = std::count_if(rob_it->source_registers.begin(), rob_it->source_registers.end(),
-                                                      [&alloc = std::as_const(reg_allocator)](auto srcreg) { return !alloc.isAllocated(srcreg); });
-    if (reg_allocator.count_free_registers() < (sources_to_allocate + rob_it->destination_registers.size())) {
+    if (reg_allocator.count_free_registers() < registers_needed(rob_entry)) {
       break;
     }
-    if (!rob_it->scheduled && rob_it->ready_time <= current_time) {
-      do_scheduling(*rob_it);
+    if (!rob_entry.scheduled && rob_entry.ready_time <= current_time) {
+      do_scheduling(rob_entry);
+      ++scheduled_unexecuted;
+      track_register_demand(rob_head_position + pos);
+      await_sources(rob_head_position + pos);
       ++progress;
     }
 
-    if (!rob_it->executed) {
+    if (!rob_entry.executed) {
       search_bw.consume();
     }
   }
 
+  // Renaming may have mapped new architectural registers, which lowers the demand of instructions that were already scheduled
+  if (register_demand_generation != reg_allocator.mapping_generation()) {
+    register_demand_generation = reg_allocator.mapping_generation();
+    scheduled_register_demand.clear();
+    for (std::size_t pos = 0; pos < std::size(ROB) && ROB[pos].scheduled; ++pos) {
+      track_register_demand(rob_head_position + pos);
+    }
+  }
+
   return progress;
 }
 
@@ -446,40 +883,110 @@ void O3_CPU::do_scheduling(ooo_model_instr& instr)
   instr.scheduled = true;
 }
 
+void O3_CPU::await_sources(rob_position pos)
+{
+  const auto& instr = *rob_entry_at(pos);
+  auto invalid_src = std::find_if_not(std::begin(instr.source_registers), std::end(instr.source_registers),
+                                      [&alloc = std::as_const(reg_allocator)](auto srcreg) { return alloc.isValid(srcreg); });
+  if (invalid_src != std::end(instr.source_registers)) {
+    // The instruction is examined again when this register becomes valid
+    reg_allocator.wait_for(*invalid_src, pos);
+  } else {
+    ready_to_execute.insert(std::upper_bound(std::begin(ready_to_execute), std::end(ready_to_execute), pos), pos);
+  }
+}
+
+void O3_CPU::wake_consumers()
+{
+  for (auto pos : reg_allocator.woken_consumers()) {
+    if (auto* rob_entry = rob_entry_at(pos); rob_entry != nullptr && rob_entry->scheduled && !rob_entry->executed) {
+      await_sources(pos);
+    }
+  }
+  reg_allocator.clear_woken_consumers();
+}
+
 long O3_CPU::execute_instruction()
 {
   champsim::bandwidth exec_bw{EXEC_WIDTH};
-  for (auto rob_it = std::begin(ROB); rob_it != std::end(ROB) && exec_bw.has_remaining(); ++rob_it) {
-    if (rob_it->scheduled && !rob_it->executed && rob_it->ready_time <= current_time) {
-      bool ready = std::all_of(std::begin(rob_it->source_registers), std::end(rob_it->source_registers),
-                               [&alloc = std::as_const(reg_allocator)](auto srcreg) { return alloc.isValid(srcreg); });
-      if (ready) {
-        do_execution(*rob_it);
-        exec_bw.consume();
+  auto waiting_end = std::begin(ready_to_execute); // instructions whose functional units are busy stay ready, in program order
+  auto ready_it = std::begin(ready_to_execute);
+  for (; ready_it != std::end(ready_to_execute) && exec_bw.has_remaining(); ++ready_it) {
+    if (auto* rob_entry = rob_entry_at(*ready_it); rob_entry != nullptr && !rob_entry->executed) {
+      if (!reserve_functional_unit(*rob_entry)) {
+        *waiting_end++ = *ready_it;
+        continue;
       }
+      do_execution(*rob_entry);
+      --scheduled_unexecuted;
+      executing.emplace(rob_entry->ready_time, *ready_it);
+      exec_bw.consume();
     }
   }
+  ready_to_execute.erase(waiting_end, ready_it);
 
   return exec_bw.amount_consumed();
 }
 
+champsim::op_class O3_CPU::execution_class(const ooo_model_instr& instr)
+{
+  if (instr.op_class != champsim::op_class::unknown) {
+    return instr.op_class;
+  }
+
+  // Traces without op classes are classified by their operands
+  if (!std::empty(instr.source_memory)) {
+    return champsim::op_class::load;
+  }
+  if (!std::empty(instr.destination_memory)) {
+    return champsim::op_class::store;
+  }
+  if (instr.is_branch) {
+    return champsim::op_class::branch;
+  }
+  return champsim::op_class::alu;
+}
+
+bool O3_CPU::reserve_functional_unit(const ooo_model_instr& instr)
+{
+  auto& pool = functional_units.at(champsim::to_underlying(execution_class(instr)));
+  if (warmup || std::empty(pool.free_at)) {
+    return true;
+  }
+
+  auto unit = std::find_if(std::begin(pool.free_at), std::end(pool.free_at), [time = current_time](auto free_at) { return free_at <= time; });
+  if (unit == std::end(pool.free_at)) {
+    return false;
+  }
+
+  *unit = current_time + (pool.pipelined ? clock_period : pool.latency);
+  return true;
+}
+
 void O3_CPU::do_execution(ooo_model_instr& instr)
 {
+  const auto latency = warmup ? champsim::chrono::clock::duration{} : functional_units.at(champsim::to_underlying(execution_class(instr))).latency;
   instr.executed = true;
-  instr.ready_time = current_time + (warmup ? champsim::chrono::clock::duration{} : EXEC_LATENCY);
+  instr.ready_time = current_time + latency;
 
   // Mark LQ entries as ready to translate
-  for (auto& lq_entry : LQ) {
-    if (lq_entry.has_value() && lq_entry->instr_id == instr.instr_id) {
-      lq_entry->ready_time = current_time + (warmup ? champsim::chrono::clock::duration{} : EXEC_LATENCY);
+  auto [lq_begin, lq_end] = lq_slots_by_instr_id.equal_range(instr.instr_id);
+  for (auto lq_it = lq_begin; lq_it != lq_end; ++lq_it) {
+    auto& lq_entry = LQ.at(lq_it->second);
+    lq_entry->ready_time = current_time + latency;
+
+    // Loads that wait on a store are finished by the store instead
+    if (lq_entry->producer_id == std::numeric_limits<uint64_t>::max()) {
+      lq_ready_slots.insert(std::upper_bound(std::begin(lq_ready_slots), std::end(lq_ready_slots), lq_it->second), lq_it->second);
     }
   }
 
   // Mark SQ entries as ready to translate
-  for (auto& sq_entry : SQ) {
-    if (sq_entry.instr_id == instr.instr_id) {
-      sq_entry.ready_time = current_time + (warmup ? champsim::chrono::clock::duration{} : EXEC_LATENCY);
-    }
+  // The SQ is in program order
+  auto sq_begin = std::partition_point(std::begin(SQ), std::end(SQ), LSQ_ENTRY::precedes(instr.instr_id));
+  auto sq_end = std::find_if_not(sq_begin, std::end(SQ), LSQ_ENTRY::matches_id(instr.instr_id));
+  for (auto sq_it = sq_begin; sq_it != sq_end; ++sq_it) {
+    sq_it->ready_time = current_time + latency;
   }
 
   if constexpr (champsim::debug_print) {
@@ -491,18 +998,19 @@ void O3_CPU::do_memory_scheduling(ooo_model_instr& instr)
 {
   // load
   for (auto& smem : instr.source_memory) {
-    auto q_entry = std::find_if_not(std::begin(LQ), std::end(LQ), [](const auto& lq_entry) { return lq_entry.has_value(); });
-    assert(q_entry != std::end(LQ));
+    assert(!std::empty(lq_free_slots));
+    const auto slot = lq_free_slots.top();
+    lq_free_slots.pop();
+    auto q_entry = std::next(std::begin(LQ), static_cast<long>(slot));
     q_entry->emplace(smem, instr.instr_id, instr.ip, instr.asid); // add it to the load queue
+    lq_slots_by_instr_id.emplace(instr.instr_id, slot);
 
     // Check for forwarding
-    auto sq_it = std::max_element(std::begin(SQ), std::end(SQ), [smem](const auto& lhs, const auto& rhs) {
-      return lhs.virtual_address != smem || (rhs.virtual_address == smem && LSQ_ENTRY::program_order(lhs, rhs));
-    });
-    if (sq_it != std::end(SQ) && sq_it->virtual_address == smem) {
+    auto sq_it = youngest_store_to(smem);
+    if (sq_it != std::end(SQ)) {
       if (sq_it->fetch_issued) { // Store already executed
         (*q_entry)->finish(instr);
-        q_entry->reset();
+        release_lq_entry(slot);
       } else {
         assert(sq_it->instr_id < instr.instr_id);      // The found SQ entry is a prior store
         sq_it->lq_depend_on_me.emplace_back(*q_entry); // Forward the load when the store finishes
@@ -518,6 +1026,9 @@ void O3_CPU::do_memory_scheduling(ooo_model_instr& instr)
   // store
   for (auto& dmem : instr.destination_memory) {
     SQ.emplace_back(dmem, instr.instr_id, instr.ip, instr.asid); // add it to the store queue
+    auto& [youngest_id, store_count] = sq_stores_by_address[dmem.to<uint64_t>()];
+    youngest_id = instr.instr_id;
+    ++store_count;
   }
 
   if constexpr (champsim::debug_print) {
@@ -547,20 +1058,31 @@ long O3_CPU::operate_lsq()
 
   auto [complete_begin, complete_end] = champsim::get_span_p(std::cbegin(SQ), std::cend(SQ), store_bw, do_complete);
   store_bw.consume(std::distance(complete_begin, complete_end));
+  std::for_each(complete_begin, complete_end, [this](const auto& sq_entry) {
+    auto stores = this->sq_stores_by_address.find(sq_entry.virtual_address.template to<uint64_t>());
+    assert(stores != std::end(this->sq_stores_by_address));
+    if (--stores->second.second == 0) {
+      this->sq_stores_by_address.erase(stores);
+    }
+  });
   SQ.erase(complete_begin, complete_end);
 
   champsim::bandwidth load_bw{LQ_WIDTH};
 
-  for (auto& lq_entry : LQ) {
-    if (load_bw.has_remaining() && lq_entry.has_value() && lq_entry->producer_id == std::numeric_limits<uint64_t>::max() && !lq_entry->fetch_issued
-        && lq_entry->ready_time < current_time) {
-      auto success = execute_load(*lq_entry);
-      if (success) {
-        load_bw.consume();
-        lq_entry->fetch_issued = true;
-      }
+  // Issue the ready loads in slot order, keeping those that could not issue
+  auto still_ready = std::begin(lq_ready_slots);
+  for (auto slot : lq_ready_slots) {
+    auto& lq_entry = LQ.at(slot);
+    if (load_bw.has_remaining() && lq_entry->ready_time < current_time && execute_load(*lq_entry)) {
+      load_bw.consume();
+      lq_entry->fetch_issued = true;
+      lq_issued_slots_by_block.emplace(champsim::block_number{lq_entry->virtual_address}.to<uint64_t>(), slot);
+    } else {
+      *still_ready = slot;
+      ++still_ready;
     }
   }
+  lq_ready_slots.erase(still_ready, std::end(lq_ready_slots));
 
   return store_bw.amount_consumed() + load_bw.amount_consumed();
 }
@@ -579,10 +1101,36 @@ void O3_CPU::do_finish_store(const LSQ_ENTRY& sq_entry)
     assert(dependent->producer_id == sq_entry.instr_id);
 
     dependent->finish(std::begin(ROB), std::end(ROB));
-    dependent.reset();
+    release_lq_entry(static_cast<std::size_t>(std::distance(LQ.data(), &dependent)));
   }
 }
 
+std::deque<LSQ_ENTRY>::iterator O3_CPU::youngest_store_to(champsim::address addr)
+{
+  auto stores = sq_stores_by_address.find(addr.to<uint64_t>());
+  if (stores == std::end(sq_stores_by_address)) {
+    return std::end(SQ);
+  }
+
+  // The SQ is in program order, and no younger store has this address
+  auto sq_begin = std::partition_point(std::begin(SQ), std::end(SQ), LSQ_ENTRY::precedes(stores->second.first));
+  auto sq_it = std::find_if(sq_begin, std::end(SQ), [addr](const auto& x) { return x.virtual_address == addr; });
+  assert(sq_it != std::end(SQ));
+  return sq_it;
+}
+
+void O3_CPU::release_lq_entry(std::size_t slot)
+{
+  auto& lq_entry = LQ.at(slot);
+  assert(lq_entry.has_value());
+
+  auto [id_begin, id_end] = lq_slots_by_instr_id.equal_range(lq_entry->instr_id);
+  lq_slots_by_instr_id.erase(std::find_if(id_begin, id_end, [slot](const auto& x) { return x.second == slot; }));
+
+  lq_entry.reset();
+  lq_free_slots.push(slot);
+}
+
 bool O3_CPU::do_complete_store(const LSQ_ENTRY& sq_entry)
 {
   CacheBus::request_type data_packet;
@@ -617,24 +1165,47 @@ void O3_CPU::do_complete_execution(ooo_model_instr& instr)
     // mark physical register's data as valid
     reg_allocator.complete_dest_register(dreg);
   }
+  wake_consumers();
 
   instr.completed = true;
 
   if (instr.branch_mispredicted) {
     fetch_resume_time = current_time + BRANCH_MISPREDICT_PENALTY;
+    resolve_wrong_path(instr);
   }
 }
 
 long O3_CPU::complete_inflight_instruction()
 {
+  // Collect the executed instructions whose latency has elapsed
+  while (!std::empty(executing) && executing.top().first <= current_time) {
+    auto pos = executing.top().second;
+    executing.pop();
+
+    if (auto* rob_entry = rob_entry_at(pos); rob_entry != nullptr && !rob_entry->completed) {
+      if (rob_entry->ready_time > current_time) {
+        executing.emplace(rob_entry->ready_time, pos);
+      } else {
+        finished_executing.insert(std::upper_bound(std::begin(finished_executing), std::end(finished_executing), pos), pos);
+      }
+    }
+  }
+
   // update ROB entries with completed executions
   champsim::bandwidth complete_bw{EXEC_WIDTH};
-  for (auto rob_it = std::begin(ROB); rob_it != std::end(ROB) && complete_bw.has_remaining(); ++rob_it) {
-    if (rob_it->executed && !rob_it->completed && (rob_it->ready_time <= current_time) && rob_it->completed_mem_ops == rob_it->num_mem_ops()) {
-      do_complete_execution(*rob_it);
+  for (auto finished_it = std::begin(finished_executing); finished_it != std::end(finished_executing) && complete_bw.has_remaining();) {
+    auto* rob_entry = rob_entry_at(*finished_it);
+    if (rob_entry == nullptr || rob_entry->completed) {
+      finished_it = finished_executing.erase(finished_it);
+    } else if ((rob_entry->ready_time <= current_time) && rob_entry->completed_mem_ops == rob_entry->num_mem_ops()) {
+      do_complete_execution(*rob_entry);
       complete_bw.consume();
+      finished_it = finished_executing.erase(finished_it);
+    } else {
+      ++finished_it;
     }
   }
+  squash_wrong_path();
 
   return complete_bw.amount_consumed();
 }
@@ -648,7 +1219,7 @@ long O3_CPU::handle_memory_return()
     auto& l1i_entry = L1I_bus.lower_level->returned.front();
 
     while (fetch_bw.has_remaining() && !l1i_entry.instr_depend_on_me.empty()) {
-      auto fetched = std::find_if(std::begin(IFETCH_BUFFER), std::end(IFETCH_BUFFER), ooo_model_instr::matches_id(l1i_entry.instr_depend_on_me.front()));
+      auto fetched = ooo_model_instr::find_id(std::begin(IFETCH_BUFFER), std::end(IFETCH_BUFFER), l1i_entry.instr_depend_on_me.front());
       if (fetched != std::end(IFETCH_BUFFER) && champsim::block_number{fetched->ip} == champsim::block_number{l1i_entry.v_address} && fetched->fetch_issued) {
         fetched->fetch_completed = true;
         fetch_bw.consume();
@@ -671,13 +1242,13 @@ long O3_CPU::handle_memory_return()
 
   auto l1d_it = std::begin(L1D_bus.lower_level->returned);
   for (champsim::bandwidth l1d_bw{L1D_BANDWIDTH}; l1d_bw.has_remaining() && l1d_it != std::end(L1D_bus.lower_level->returned); l1d_bw.consume(), ++l1d_it) {
-    for (auto& lq_entry : LQ) {
-      if (lq_entry.has_value() && lq_entry->fetch_issued && champsim::block_number{lq_entry->virtual_address} == champsim::block_number{l1d_it->v_address}) {
-        lq_entry->finish(std::begin(ROB), std::end(ROB));
-        lq_entry.reset();
-        ++progress;
-      }
+    auto [issued_begin, issued_end] = lq_issued_slots_by_block.equal_range(champsim::block_number{l1d_it->v_address}.to<uint64_t>());
+    for (auto issued_it = issued_begin; issued_it != issued_end; ++issued_it) {
+      LQ.at(issued_it->second)->finish(std::begin(ROB), std::end(ROB));
+      release_lq_entry(issued_it->second);
+      ++progress;
     }
+    lq_issued_slots_by_block.erase(issued_begin, issued_end);
     ++progress;
   }
   L1D_bus.lower_level->returned.erase(std::begin(L1D_bus.lower_level->returned), l1d_it);
@@ -708,12 +1279,94 @@ long O3_CPU::retire_rob()
   handle_event<Event::RETIRE>(cpu, retire_begin, retire_end, cycles);
 
   auto retire_count = std::distance(retire_begin, retire_end);
+  rob_head_position += static_cast<rob_position>(retire_count);
+  while (!std::empty(scheduled_register_demand) && scheduled_register_demand.front().first < rob_head_position) {
+    scheduled_register_demand.pop_front();
+  }
   num_retired += retire_count;
   ROB.erase(retire_begin, retire_end);
 
   return retire_count;
 }
 
+long O3_CPU::operate_cache_only()
+{
+  long progress{0};
+
+  // A returned block completes every outstanding load to it, since the L1D may have merged them
+  for (const auto& response : L1D_bus.lower_level->returned) {
+    auto outstanding_end =
+        std::remove(std::begin(cache_only_outstanding_loads), std::end(cache_only_outstanding_loads), champsim::block_number{response.v_address});
+    cache_only_outstanding_loads.erase(outstanding_end, std::end(cache_only_outstanding_loads));
+    ++progress;
+  }
+  L1D_bus.lower_level->returned.clear();
+
+  progress += static_cast<long>(std::size(L1I_bus.lower_level->returned));
+  L1I_bus.lower_level->returned.clear();
+
+  champsim::bandwidth issue_bandwidth{FETCH_WIDTH};
+  champsim::ring_buffer<ooo_model_instr>::const_iterator retire_begin = std::cbegin(input_queue);
+  champsim::ring_buffer<ooo_model_instr>::const_iterator retire_end = retire_begin;
+  for (auto it = std::begin(input_queue); issue_bandwidth.has_remaining() && it != std::end(input_queue) && issue_cache_only(*it); ++it) {
+    issue_bandwidth.consume();
+    ++retire_end;
+  }
+
+  uint64_t cycles = current_time.time_since_epoch() / clock_period;
+  handle_event<Event::RETIRE>(cpu, retire_begin, retire_end, cycles);
+
+  auto retire_count = std::distance(retire_begin, retire_end);
+  num_retired += retire_count;
+  input_queue.erase(retire_begin, retire_end);
+
+  return progress + retire_count;
+}
+
+bool O3_CPU::issue_cache_only(ooo_model_instr& instr)
+{
+  if (!instr.fetch_issued) {
+    if (champsim::block_number fetch_block{instr.ip}; cache_only_last_fetch != fetch_block) {
+      CacheBus::request_type fetch_packet;
+      fetch_packet.v_address = instr.ip;
+      fetch_packet.instr_id = instr.instr_id;
+      fetch_packet.ip = instr.ip;
+      fetch_packet.response_requested = false;
+      if (!L1I_bus.issue_read(fetch_packet)) {
+        return false;
+      }
+      cache_only_last_fetch = fetch_block;
+    }
+    instr.fetch_issued = true;
+  }
+
+  // The memory operations are issued in order, and completed_mem_ops counts those already issued
+  while (instr.completed_mem_ops < instr.num_mem_ops()) {
+    CacheBus::request_type data_packet;
+    data_packet.instr_id = instr.instr_id;
+    data_packet.ip = instr.ip;
+
+    if (instr.completed_mem_ops < std::size(instr.source_memory)) {
+      if (std::size(cache_only_outstanding_loads) >= std::size(LQ)) {
+        return false;
+      }
+      data_packet.v_address = instr.source_memory.at(instr.completed_mem_ops);
+      if (!L1D_bus.issue_read(data_packet)) {
+        return false;
+      }
+      cache_only_outstanding_loads.emplace_back(data_packet.v_address);
+    } else {
+      data_packet.v_address = instr.destination_memory.at(instr.completed_mem_ops - std::size(instr.source_memory));
+      if (!L1D_bus.issue_write(data_packet)) {
+        return false;
+      }
+    }
+    ++instr.completed_mem_ops;
+  }
+
+  return true;
+}
+
 void O3_CPU::impl_initialize_branch_predictor() const { branch_module_pimpl->impl_initialize_branch_predictor(); }
 
 void O3_CPU::impl_last_branch_result(champsim::address ip, champsim::address target, bool taken, uint8_t branch_type) const
@@ -791,9 +1444,9 @@ LSQ_ENTRY::LSQ_ENTRY(champsim::address addr, champsim::program_ordered<LSQ_ENTRY
 {
 }
 
-void LSQ_ENTRY::finish(std::deque<ooo_model_instr>::iterator begin, std::deque<ooo_model_instr>::iterator end) const
+void LSQ_ENTRY::finish(champsim::ring_buffer<ooo_model_instr>::iterator begin, champsim::ring_buffer<ooo_model_instr>::iterator end) const
 {
-  auto rob_entry = std::partition_point(begin, end, ooo_model_instr::precedes(this->instr_id));
+  auto rob_entry = ooo_model_instr::find_id(begin, end, this->instr_id);
   assert(rob_entry != end);
   finish(*rob_entry);
 }
@@ -831,3 +1484,14 @@ bool CacheBus::issue_write(request_type data_packet)
 
   return lower_level->add_wq(data_packet);
 }
+
+bool CacheBus::issue_prefetch(request_type data_packet)
+{
+  data_packet.address = data_packet.v_address;
+  data_packet.is_translated = false;
+  data_packet.cpu = cpu;
+  data_packet.type = access_type::PREFETCH;
+  data_packet.response_requested = false;
+
+  return lower_level->add_pq(data_packet);
+}
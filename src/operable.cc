@@ -30,6 +30,17 @@ long champsim::operable::operate_on(const champsim::chrono::clock& clock)
   return progress;
 }
 
+void champsim::operable::skip_to(const champsim::chrono::clock& clock)
+{
+  if (current_time < clock.now()) {
+    auto count = (clock.now() - current_time + clock_period - champsim::chrono::picoseconds{1}) / clock_period;
+    current_time += count * clock_period;
+    skip_cycles(count);
+  }
+}
+
+champsim::chrono::clock::time_point champsim::operable::next_event() const { return current_time + clock_period; }
+
 long champsim::operable::_operate()
 {
   current_time += clock_period;
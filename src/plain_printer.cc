@@ -62,6 +62,9 @@ std::vector<std::string> champsim::plain_printer::format(O3_CPU::stats_type stat
                                 ::print_ratio(std::kilo::num * stats.branch_type_misses.value_or(idx, 0), stats.instrs())));
   }
 
+  lines.push_back(fmt::format("{} Front-End Stall Cycles: {} Average FTQ Occupancy: {} Wrong-Path Instructions: {}", stats.name,
+                              stats.front_end_stall_cycles, ::print_ratio(stats.total_ftq_occupancy, stats.cycles()), stats.wrong_path_instrs));
+
   return lines;
 }
 
@@ -141,6 +144,21 @@ std::vector<std::string> champsim::plain_printer::format(DRAM_CHANNEL::stats_typ
     lines.push_back(fmt::format("{} REFRESHES ISSUED: {:10}", stats.name, stats.refresh_cycles));
   else
     lines.push_back(fmt::format("{} REFRESHES ISSUED: -", stats.name));
+  if (stats.refresh_stall_cycles > 0)
+    lines.push_back(fmt::format("  READS STALLED BY REFRESH: {:10} cycles", stats.refresh_stall_cycles));
+
+  if (stats.ACT + stats.RD + stats.WR + stats.REF > 0) {
+    lines.push_back(fmt::format("{} COMMANDS ACT: {} PRE: {} RD: {} WR: {}", stats.name, stats.ACT, stats.PRE, stats.RD, stats.WR));
+    lines.push_back(fmt::format("  BANK REFRESHES: {}", stats.REF));
+    for (std::size_t rank = 0; rank < std::size(stats.active_standby_time) && rank < std::size(stats.precharge_standby_time); ++rank) {
+      lines.push_back(fmt::format("  RANK {} STANDBY (ns) ACTIVE: {} PRECHARGE: {}", rank,
+                                  std::chrono::duration_cast<champsim::chrono::nanoseconds>(stats.active_standby_time[rank]).count(),
+                                  std::chrono::duration_cast<champsim::chrono::nanoseconds>(stats.precharge_standby_time[rank]).count()));
+    }
+    lines.push_back(fmt::format("  ENERGY (nJ) ACT: {:.4g} RD: {:.4g} WR: {:.4g} REF: {:.4g} BACKGROUND: {:.4g} TOTAL: {:.4g}", stats.activate_energy / 1000,
+                                stats.read_energy / 1000, stats.write_energy / 1000, stats.refresh_energy / 1000, stats.background_energy / 1000,
+                                stats.total_energy() / 1000));
+  }
 
   return lines;
 }
@@ -16,6 +16,7 @@
 
 #include "ptw.h"
 
+#include <algorithm>
 #include <cmath>
 #include <numeric>
 #include <fmt/chrono.h>
@@ -53,7 +54,7 @@ PageTableWalker::mshr_type::mshr_type(const request_type& req, std::size_t level
   asid[1] = req.asid[1];
 }
 
-auto PageTableWalker::handle_read(const request_type& handle_pkt, channel_type* ul) -> std::optional<mshr_type>
+auto PageTableWalker::begin_walk(const request_type& handle_pkt) -> mshr_type
 {
   pscl_entry walk_init = {handle_pkt.v_address, CR3_addr, std::size(pscl)};
   std::vector<std::optional<pscl_entry>> pscl_hits;
@@ -68,13 +69,19 @@ auto PageTableWalker::handle_read(const request_type& handle_pkt, channel_type*
   mshr_type fwd_mshr{handle_pkt, walk_init.level};
   fwd_mshr.address = champsim::address{champsim::splice(champsim::page_number{walk_init.ptw_addr}, champsim::page_offset{walk_offset})};
   fwd_mshr.v_address = handle_pkt.address;
+  return fwd_mshr;
+}
+
+auto PageTableWalker::handle_read(const request_type& handle_pkt, channel_type* ul) -> std::optional<mshr_type>
+{
+  mshr_type fwd_mshr = begin_walk(handle_pkt);
   if (handle_pkt.response_requested) {
     fwd_mshr.to_return = {&ul->returned};
   }
 
   if constexpr (champsim::debug_print) {
-    fmt::print("[{}] {} address: {} v_address: {} pt_page_offset: {} translation_level: {} cycle: {}\n", NAME, __func__, fwd_mshr.address, handle_pkt.v_address,
-               walk_offset.to<int>(), walk_init.level, current_time.time_since_epoch() / clock_period);
+    fmt::print("[{}] {} address: {} v_address: {} translation_level: {} cycle: {}\n", NAME, __func__, fwd_mshr.address, handle_pkt.v_address,
+               fwd_mshr.translation_level, current_time.time_since_epoch() / clock_period);
   }
 
   return step_translation(fwd_mshr);
@@ -100,6 +107,16 @@ auto PageTableWalker::handle_fill(const mshr_type& fill_mshr) -> std::optional<m
 }
 
 auto PageTableWalker::step_translation(const mshr_type& source) -> std::optional<mshr_type>
+{
+  bool success = lower_level->add_rq(translation_packet(source));
+  if (success) {
+    return source;
+  }
+
+  return std::nullopt;
+}
+
+auto PageTableWalker::translation_packet(const mshr_type& source) -> request_type
 {
   request_type packet;
   packet.address = source.address;
@@ -111,12 +128,23 @@ auto PageTableWalker::step_translation(const mshr_type& source) -> std::optional
   packet.is_translated = true;
   packet.type = access_type::TRANSLATION;
 
-  bool success = lower_level->add_rq(packet);
-  if (success) {
-    return source;
+  return packet;
+}
+
+auto PageTableWalker::functional_access(const request_type& packet, const champsim::functional_access& lower) -> response_type
+{
+  mshr_type walk = begin_walk(packet);
+  for (; walk.translation_level > 0; --walk.translation_level) {
+    lower(lower_level, translation_packet(walk));
+
+    auto ppage = vmem->get_pte_pa(walk.cpu, champsim::page_number{walk.v_address}, walk.translation_level).first;
+    pscl.at(std::size(pscl) - walk.translation_level).fill({walk.v_address, ppage, walk.translation_level});
+    walk.address = ppage;
   }
+  lower(lower_level, translation_packet(walk));
 
-  return std::nullopt;
+  auto ppage = vmem->va_to_pa(walk.cpu, champsim::page_number{walk.v_address}).first;
+  return response_type{walk.v_address, walk.v_address, champsim::address{ppage}, walk.pf_metadata, walk.instr_depend_on_me};
 }
 
 long PageTableWalker::operate()
@@ -180,6 +208,23 @@ long PageTableWalker::operate()
   return progress;
 }
 
+champsim::chrono::clock::time_point PageTableWalker::next_event() const
+{
+  auto next_cycle = current_time + clock_period;
+  if (!std::empty(lower_level->returned)
+      || std::any_of(std::cbegin(upper_levels), std::cend(upper_levels), [](const auto* ul) { return !std::empty(ul->RQ); })) {
+    return next_cycle;
+  }
+
+  auto next = champsim::chrono::clock::time_point::max();
+  for (const auto* queue : {&finished, &completed}) {
+    for (const auto& entry : *queue) {
+      next = std::min(next, entry.data.ready_time());
+    }
+  }
+  return std::max(next, next_cycle);
+}
+
 void PageTableWalker::finish_packet(const response_type& packet)
 {
   auto finish_step = [this](auto mshr_entry) {
@@ -222,6 +267,24 @@ void PageTableWalker::finish_packet(const response_type& packet)
   MSHR.erase(std::begin(MSHR), last_finished);
 }
 
+void PageTableWalker::save_checkpoint(champsim::checkpoint_writer& writer) const
+{
+  writer.begin_section(NAME);
+  writer.write(static_cast<uint64_t>(std::size(pscl)));
+  for (const auto& cache : pscl) {
+    writer.write(cache);
+  }
+}
+
+void PageTableWalker::load_checkpoint(champsim::checkpoint_reader& reader)
+{
+  reader.begin_section(NAME);
+  reader.expect(static_cast<uint64_t>(std::size(pscl)), "the number of paging structure caches in " + NAME);
+  for (auto& cache : pscl) {
+    reader.read(cache);
+  }
+}
+
 void PageTableWalker::begin_phase()
 {
   for (auto* ul : upper_levels) {
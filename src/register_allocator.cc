@@ -1,5 +1,6 @@
 #include "register_allocator.h"
 
+#include <algorithm>
 #include <cassert>
 
 RegisterAllocator::RegisterAllocator(size_t num_physical_registers)
@@ -9,6 +10,7 @@ RegisterAllocator::RegisterAllocator(size_t num_physical_registers)
     free_registers.push(static_cast<PHYSICAL_REGISTER_ID>(i));
   }
   physical_register_file = std::vector<physical_register>(num_physical_registers, {0, 0, false, false});
+  consumers.resize(num_physical_registers);
   frontend_RAT.fill(-1); // default value for no mapping
   backend_RAT.fill(-1);
 }
@@ -19,6 +21,9 @@ PHYSICAL_REGISTER_ID RegisterAllocator::rename_dest_register(int16_t reg, champs
 
   PHYSICAL_REGISTER_ID phys_reg = free_registers.front();
   free_registers.pop();
+  if (frontend_RAT[reg] < 0) {
+    ++mapping_generation_;
+  }
   frontend_RAT[reg] = phys_reg;
   physical_register_file.at(phys_reg) = {(uint16_t)reg, producer_id, false, true}; // arch_reg_index, valid, busy
 
@@ -34,6 +39,7 @@ PHYSICAL_REGISTER_ID RegisterAllocator::rename_src_register(int16_t reg)
     // (common due to the traces being slices in the middle of a program)
     phys = free_registers.front();
     free_registers.pop();
+    ++mapping_generation_;
     frontend_RAT[reg] = phys;
     backend_RAT[reg] = phys;                                          // we assume this register's last write has been committed
     physical_register_file.at(phys) = {(uint16_t)reg, 0, true, true}; // arch_reg_index, producing_inst_id, valid, busy
@@ -46,6 +52,10 @@ void RegisterAllocator::complete_dest_register(PHYSICAL_REGISTER_ID physreg)
 {
   // mark the physical register as valid
   physical_register_file.at(physreg).valid = true;
+
+  auto& waiting = consumers.at(static_cast<std::size_t>(physreg));
+  woken.insert(std::end(woken), std::begin(waiting), std::end(waiting));
+  waiting.clear();
 }
 
 void RegisterAllocator::retire_dest_register(PHYSICAL_REGISTER_ID physreg)
@@ -66,9 +76,16 @@ void RegisterAllocator::retire_dest_register(PHYSICAL_REGISTER_ID physreg)
 void RegisterAllocator::free_register(PHYSICAL_REGISTER_ID physreg)
 {
   physical_register_file.at(physreg) = {255, 0, false, false}; // arch_reg_index, producing_inst_id, valid, busy
+  consumers.at(static_cast<std::size_t>(physreg)).clear();
   free_registers.push(physreg);
 }
 
+void RegisterAllocator::wait_for(PHYSICAL_REGISTER_ID physreg, uint64_t consumer)
+{
+  assert(!isValid(physreg));
+  consumers.at(static_cast<std::size_t>(physreg)).push_back(consumer);
+}
+
 bool RegisterAllocator::isValid(PHYSICAL_REGISTER_ID physreg) const { return physical_register_file.at(physreg).valid; }
 
 bool RegisterAllocator::isAllocated(PHYSICAL_REGISTER_ID archreg) const { return frontend_RAT[archreg] != -1; }
@@ -80,11 +97,24 @@ int RegisterAllocator::count_reg_dependencies(const ooo_model_instr& instr) cons
   return static_cast<int>(std::count_if(std::begin(instr.source_registers), std::end(instr.source_registers), [this](auto reg) { return !isValid(reg); }));
 }
 
+void RegisterAllocator::squash_consumers(uint64_t first_squashed)
+{
+  auto is_squashed = [first_squashed](auto consumer) {
+    return consumer >= first_squashed;
+  };
+  for (auto& waiting : consumers) {
+    waiting.erase(std::remove_if(std::begin(waiting), std::end(waiting), is_squashed), std::end(waiting));
+  }
+  woken.erase(std::remove_if(std::begin(woken), std::end(woken), is_squashed), std::end(woken));
+}
+
+void RegisterAllocator::restore_dest_register(PHYSICAL_REGISTER_ID physreg) { frontend_RAT[physical_register_file.at(physreg).arch_reg_index] = physreg; }
+
 void RegisterAllocator::reset_frontend_RAT()
 {
+  // Registers allocated by wrong-path instructions are freed by the core when it squashes them
   std::copy(std::begin(backend_RAT), std::end(backend_RAT), std::begin(frontend_RAT));
-  // once wrong path is implemented:
-  // find registers allocated by wrong-path instructions and free them
+  ++mapping_generation_;
 }
 
 void RegisterAllocator::print_deadlock()
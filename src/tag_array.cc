@@ -0,0 +1,125 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "tag_array.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+constexpr std::size_t word_bits = std::numeric_limits<uint64_t>::digits;
+
+std::size_t lowest_set_bit(uint64_t word)
+{
+  assert(word != 0);
+#if defined(__GNUC__)
+  return static_cast<std::size_t>(__builtin_ctzll(word));
+#else
+  std::size_t retval = 0;
+  while ((word & 1) == 0) {
+    word >>= 1;
+    ++retval;
+  }
+  return retval;
+#endif
+}
+} // namespace
+
+champsim::tag_array::tag_array(std::size_t num_sets, std::size_t num_ways)
+    : num_way(num_ways), words_per_set((num_ways + word_bits - 1) / word_bits), tags(num_sets * num_ways), valid_bits(num_sets * words_per_set)
+{
+}
+
+void champsim::tag_array::assign(std::size_t index, uint64_t tag, bool valid)
+{
+  assert(index < std::size(tags));
+  tags[index] = tag;
+
+  const auto set = index / num_way;
+  const auto way = index % num_way;
+  auto& word = valid_bits[set * words_per_set + way / word_bits];
+  const auto bit = uint64_t{1} << (way % word_bits);
+  word = valid ? (word | bit) : (word & ~bit);
+}
+
+uint64_t champsim::tag_array::match_mask(std::size_t set, std::size_t word, uint64_t tag) const
+{
+  const auto first_way = word * word_bits;
+  const auto count = std::min(num_way - first_way, word_bits);
+  const uint64_t* set_tags = std::data(tags) + set * num_way + first_way;
+
+  uint64_t mask = 0;
+  std::size_t i = 0;
+#if defined(__AVX2__)
+  const auto needle = _mm256_set1_epi64x(static_cast<long long>(tag));
+  for (; i + 4 <= count; i += 4) {
+    const auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(set_tags + i));
+    const auto bits = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(chunk, needle)));
+    mask |= static_cast<uint64_t>(bits) << i;
+  }
+#elif defined(__SSE4_1__)
+  const auto needle = _mm_set1_epi64x(static_cast<long long>(tag));
+  for (; i + 2 <= count; i += 2) {
+    const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(set_tags + i));
+    const auto bits = _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpeq_epi64(chunk, needle)));
+    mask |= static_cast<uint64_t>(bits) << i;
+  }
+#endif
+  for (; i < count; ++i) {
+    mask |= static_cast<uint64_t>(set_tags[i] == tag) << i;
+  }
+  return mask;
+}
+
+std::size_t champsim::tag_array::find_valid(std::size_t set, uint64_t tag) const
+{
+  for (std::size_t word = 0; word < words_per_set; ++word) {
+    if (auto mask = match_mask(set, word, tag) & valid_bits[set * words_per_set + word]; mask != 0) {
+      return word * word_bits + lowest_set_bit(mask);
+    }
+  }
+  return num_way;
+}
+
+std::size_t champsim::tag_array::find(std::size_t set, uint64_t tag) const
+{
+  for (std::size_t word = 0; word < words_per_set; ++word) {
+    if (auto mask = match_mask(set, word, tag); mask != 0) {
+      return word * word_bits + lowest_set_bit(mask);
+    }
+  }
+  return num_way;
+}
+
+std::size_t champsim::tag_array::find_invalid(std::size_t set) const
+{
+  for (std::size_t word = 0; word < words_per_set; ++word) {
+    auto mask = ~valid_bits[set * words_per_set + word];
+    if (const auto count = std::min(num_way - word * word_bits, word_bits); count < word_bits) {
+      mask &= (uint64_t{1} << count) - 1;
+    }
+    if (mask != 0) {
+      return word * word_bits + lowest_set_bit(mask);
+    }
+  }
+  return num_way;
+}
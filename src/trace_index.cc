@@ -0,0 +1,363 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "trace_index.h"
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <istream>
+#include <limits>
+#include <lzma.h>
+#include <ostream>
+#include <stdexcept>
+#include <string_view>
+#include <zlib.h>
+#include <fmt/core.h>
+
+namespace
+{
+constexpr std::size_t CHUNK = (1 << 16);
+constexpr uint64_t DEFLATE_WINDOW = (1 << 15);
+constexpr std::string_view index_magic = "champsim-trace-index";
+constexpr int index_version = 1;
+
+bool ends_with(std::string_view str, std::string_view suffix)
+{
+  return std::size(str) >= std::size(suffix) && str.substr(std::size(str) - std::size(suffix)) == suffix;
+}
+
+champsim::trace_index build_xz_index(const std::string& trace_name)
+{
+  std::ifstream file{trace_name, std::ios::binary};
+  lzma_stream strm = LZMA_STREAM_INIT;
+  lzma_index* file_index = nullptr;
+  if (::lzma_file_info_decoder(&strm, &file_index, std::numeric_limits<uint64_t>::max(), std::filesystem::file_size(trace_name)) != LZMA_OK) {
+    throw std::runtime_error{"Could not read the index of " + trace_name};
+  }
+
+  std::array<uint8_t, CHUNK> in_buf;
+  lzma_ret ret = LZMA_OK;
+  while (ret == LZMA_OK) {
+    if (strm.avail_in == 0) {
+      file.read(reinterpret_cast<char*>(std::data(in_buf)), std::size(in_buf)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+      strm.next_in = std::data(in_buf);
+      strm.avail_in = static_cast<std::size_t>(file.gcount());
+    }
+
+    ret = ::lzma_code(&strm, LZMA_RUN);
+    if (ret == LZMA_SEEK_NEEDED) {
+      file.clear();
+      file.seekg(static_cast<std::streamoff>(strm.seek_pos));
+      strm.avail_in = 0;
+      ret = LZMA_OK;
+    }
+  }
+  ::lzma_end(&strm);
+
+  if (ret != LZMA_STREAM_END) {
+    throw std::runtime_error{"Could not read the index of " + trace_name};
+  }
+
+  // Only the first stream is decompressed by the trace reader
+  champsim::trace_index retval;
+  retval.format = champsim::trace_index::format_type::xz;
+  lzma_index_iter iter;
+  ::lzma_index_iter_init(&iter, file_index);
+  while (!::lzma_index_iter_next(&iter, LZMA_INDEX_ITER_BLOCK) && iter.stream.number == 1) {
+    retval.check = static_cast<uint32_t>(iter.stream.flags->check);
+    retval.compressed_end = iter.block.compressed_file_offset + iter.block.total_size;
+    retval.entries.push_back(
+        {iter.block.uncompressed_file_offset, iter.block.compressed_file_offset, iter.block.unpadded_size, iter.block.uncompressed_size, 0});
+  }
+  ::lzma_index_end(file_index, nullptr);
+
+  return retval;
+}
+
+/*
+ * A byte-aligned deflate block boundary is a restart point if none of the data after it refers to data before it.
+ * Back-references reach at most one window, so it is enough to decode one window's worth of data from the boundary without an error.
+ */
+bool is_gzip_restart_point(const std::string& trace_name, uint64_t compressed_offset)
+{
+  std::ifstream file{trace_name, std::ios::binary};
+  file.seekg(static_cast<std::streamoff>(compressed_offset));
+
+  z_stream strm{};
+  if (::inflateInit2(&strm, -15) != Z_OK) {
+    return false;
+  }
+
+  std::array<unsigned char, CHUNK> in_buf;
+  std::array<unsigned char, CHUNK> out_buf;
+  int ret = Z_OK;
+  while (ret == Z_OK && strm.total_out < DEFLATE_WINDOW) {
+    if (strm.avail_in == 0) {
+      file.read(reinterpret_cast<char*>(std::data(in_buf)), std::size(in_buf)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+      strm.next_in = std::data(in_buf);
+      strm.avail_in = static_cast<uInt>(file.gcount());
+      if (strm.avail_in == 0) {
+        break;
+      }
+    }
+    strm.next_out = std::data(out_buf);
+    strm.avail_out = static_cast<uInt>(std::size(out_buf));
+    ret = ::inflate(&strm, Z_NO_FLUSH);
+  }
+  ::inflateEnd(&strm);
+
+  return ret == Z_STREAM_END || (ret == Z_OK && strm.total_out >= DEFLATE_WINDOW);
+}
+
+champsim::trace_index build_gzip_index(const std::string& trace_name, uint64_t spacing)
+{
+  std::ifstream file{trace_name, std::ios::binary};
+  z_stream strm{};
+  if (::inflateInit2(&strm, 15 + 16) != Z_OK) {
+    throw std::runtime_error{"Could not decompress " + trace_name};
+  }
+
+  champsim::trace_index retval;
+  retval.format = champsim::trace_index::format_type::gzip;
+
+  // The CRC-32 and length of the data between consecutive restart points
+  std::vector<uint32_t> segment_crc{static_cast<uint32_t>(::crc32(0, nullptr, 0))};
+  std::vector<uint64_t> segment_length{0};
+
+  std::array<unsigned char, CHUNK> in_buf;
+  std::array<unsigned char, CHUNK> out_buf;
+  int ret = Z_OK;
+  while (ret != Z_STREAM_END) {
+    if (strm.avail_in == 0) {
+      file.read(reinterpret_cast<char*>(std::data(in_buf)), std::size(in_buf)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+      strm.next_in = std::data(in_buf);
+      strm.avail_in = static_cast<uInt>(file.gcount());
+      if (strm.avail_in == 0) {
+        ::inflateEnd(&strm);
+        throw std::runtime_error{"The trace " + trace_name + " ended unexpectedly"};
+      }
+    }
+
+    strm.next_out = std::data(out_buf);
+    strm.avail_out = static_cast<uInt>(std::size(out_buf));
+    ret = ::inflate(&strm, Z_BLOCK);
+    if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR) {
+      ::inflateEnd(&strm);
+      throw std::runtime_error{"Could not decompress " + trace_name};
+    }
+
+    auto produced = std::size(out_buf) - strm.avail_out;
+    segment_crc.back() = static_cast<uint32_t>(::crc32(segment_crc.back(), std::data(out_buf), static_cast<uInt>(produced)));
+    segment_length.back() += produced;
+
+    // Stopped at the end of a block that is not the last, with no bits of the next block already consumed
+    bool at_aligned_boundary = (strm.data_type & 128) != 0 && (strm.data_type & 64) == 0 && (strm.data_type & 7) == 0;
+    if (ret == Z_OK && at_aligned_boundary && strm.total_out > 0 && segment_length.back() >= std::max<uint64_t>(spacing, 1)
+        && is_gzip_restart_point(trace_name, strm.total_in)) {
+      retval.entries.push_back({strm.total_out, strm.total_in, 0, 0, 0});
+      segment_crc.push_back(static_cast<uint32_t>(::crc32(0, nullptr, 0)));
+      segment_length.push_back(0);
+    }
+  }
+
+  // The gzip trailer holds 4 bytes of CRC-32 and 4 bytes of length
+  retval.compressed_end = strm.total_in - 8;
+  ::inflateEnd(&strm);
+
+  // Each restart point needs the CRC-32 of the data from it to the end, for the synthesized trailer
+  auto crc = segment_crc.back();
+  auto length = segment_length.back();
+  for (auto i = std::size(retval.entries); i-- > 0;) {
+    retval.entries.at(i).crc = crc;
+    retval.entries.at(i).uncompressed_size = length;
+    crc = static_cast<uint32_t>(::crc32_combine(segment_crc.at(i), crc, static_cast<z_off_t>(length)));
+    length += segment_length.at(i);
+  }
+
+  return retval;
+}
+
+std::string xz_prefix(const champsim::trace_index& index)
+{
+  lzma_stream_flags flags{};
+  flags.version = 0;
+  flags.check = static_cast<lzma_check>(index.check);
+
+  std::string retval(LZMA_STREAM_HEADER_SIZE, '\0');
+  if (::lzma_stream_header_encode(&flags, reinterpret_cast<uint8_t*>(std::data(retval))) != LZMA_OK) { // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    throw std::runtime_error{"The trace index has an unsupported integrity check"};
+  }
+  return retval;
+}
+
+// The index and footer of a stream made of the blocks from the restart point onward
+std::string xz_suffix(const champsim::trace_index& index, const champsim::trace_index::entry& start)
+{
+  lzma_index* stream_index = ::lzma_index_init(nullptr);
+  for (const auto& entry : index.entries) {
+    if (entry.compressed_offset >= start.compressed_offset
+        && ::lzma_index_append(stream_index, nullptr, entry.compressed_size, entry.uncompressed_size) != LZMA_OK) {
+      ::lzma_index_end(stream_index, nullptr);
+      throw std::runtime_error{"The trace index has an invalid block"};
+    }
+  }
+
+  auto index_size = ::lzma_index_size(stream_index);
+  std::string retval(index_size + LZMA_STREAM_HEADER_SIZE, '\0');
+  auto* out = reinterpret_cast<uint8_t*>(std::data(retval)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  std::size_t out_pos = 0;
+  ::lzma_index_buffer_encode(stream_index, out, &out_pos, index_size);
+  ::lzma_index_end(stream_index, nullptr);
+
+  lzma_stream_flags flags{};
+  flags.version = 0;
+  flags.check = static_cast<lzma_check>(index.check);
+  flags.backward_size = index_size;
+  if (::lzma_stream_footer_encode(&flags, out + index_size) != LZMA_OK) { // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    throw std::runtime_error{"The trace index has an unsupported integrity check"};
+  }
+  return retval;
+}
+
+std::string little_endian_bytes(uint32_t value)
+{
+  std::string retval;
+  for (int i = 0; i < 4; ++i) {
+    retval.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+  }
+  return retval;
+}
+} // namespace
+
+auto champsim::trace_index::restart_point(uint64_t uncompressed_offset) const -> std::optional<entry>
+{
+  auto found = std::upper_bound(std::cbegin(entries), std::cend(entries), uncompressed_offset,
+                                [](uint64_t offset, const entry& point) { return offset < point.uncompressed_offset; });
+  if (found == std::cbegin(entries)) {
+    return std::nullopt;
+  }
+  return *std::prev(found);
+}
+
+std::string champsim::trace_index_name(const std::string& trace_name) { return trace_name + ".idx"; }
+
+champsim::trace_index champsim::build_trace_index(const std::string& trace_name, uint64_t spacing)
+{
+  if (ends_with(trace_name, "xz")) {
+    return build_xz_index(trace_name);
+  }
+  if (ends_with(trace_name, "gz")) {
+    return build_gzip_index(trace_name, spacing);
+  }
+  throw std::runtime_error{"Only xz and gzip traces can be indexed: " + trace_name};
+}
+
+void champsim::write_trace_index(std::ostream& out, const trace_index& index)
+{
+  out << index_magic << ' ' << index_version << '\n';
+  out << (index.format == trace_index::format_type::xz ? "xz" : "gzip") << ' ' << index.check << ' ' << index.compressed_end << '\n';
+  for (const auto& entry : index.entries) {
+    out << entry.uncompressed_offset << ' ' << entry.compressed_offset << ' ' << entry.compressed_size << ' ' << entry.uncompressed_size << ' ' << entry.crc
+        << '\n';
+  }
+}
+
+champsim::trace_index champsim::read_trace_index(std::istream& in)
+{
+  std::string magic;
+  int version = 0;
+  std::string format;
+  trace_index retval;
+  in >> magic >> version >> format >> retval.check >> retval.compressed_end;
+  if (!in || magic != index_magic || version != index_version || (format != "xz" && format != "gzip")) {
+    throw std::runtime_error{"The trace index is not in a recognized format"};
+  }
+  retval.format = (format == "xz") ? trace_index::format_type::xz : trace_index::format_type::gzip;
+
+  trace_index::entry entry;
+  while (in >> entry.uncompressed_offset >> entry.compressed_offset >> entry.compressed_size >> entry.uncompressed_size >> entry.crc) {
+    retval.entries.push_back(entry);
+  }
+  return retval;
+}
+
+std::optional<champsim::trace_index> champsim::load_trace_index(const std::string& trace_name)
+{
+  std::ifstream index_file{trace_index_name(trace_name)};
+  if (!index_file) {
+    return std::nullopt;
+  }
+
+  auto retval = read_trace_index(index_file);
+  bool stale = retval.compressed_end > std::filesystem::file_size(trace_name)
+               || !std::is_sorted(std::cbegin(retval.entries), std::cend(retval.entries),
+                                  [](const auto& lhs, const auto& rhs) { return lhs.uncompressed_offset < rhs.uncompressed_offset; });
+  if (stale) {
+    fmt::print("WARNING: ignoring the index {}, which does not match the trace\n", trace_index_name(trace_name));
+    return std::nullopt;
+  }
+  return retval;
+}
+
+champsim::spliced_ifstream::spliced_ifstream(const std::string& fname)
+    : file(fname, std::ios::binary), file_remaining(std::numeric_limits<uint64_t>::max())
+{
+}
+
+champsim::spliced_ifstream::spliced_ifstream(const std::string& fname, const trace_index& index, const trace_index::entry& start)
+    : file(fname, std::ios::binary), file_remaining(index.compressed_end - start.compressed_offset)
+{
+  file.seekg(static_cast<std::streamoff>(start.compressed_offset));
+  if (index.format == trace_index::format_type::xz) {
+    prefix = xz_prefix(index);
+    suffix = xz_suffix(index, start);
+  } else {
+    // A minimal gzip member header: deflate, no flags, no timestamp, unknown OS
+    prefix = std::string{'\x1f', '\x8b', '\x08', '\x00', '\x00', '\x00', '\x00', '\x00', '\x00', '\xff'};
+    suffix = little_endian_bytes(start.crc) + little_endian_bytes(static_cast<uint32_t>(start.uncompressed_size));
+  }
+}
+
+auto champsim::spliced_ifstream::read(char* s, std::streamsize count) -> spliced_ifstream&
+{
+  gcount_ = 0;
+  auto take = [&](const char* src, std::size_t available) {
+    auto size = std::min<std::size_t>(available, static_cast<std::size_t>(count - gcount_));
+    std::copy_n(src, size, std::next(s, gcount_));
+    gcount_ += static_cast<std::streamsize>(size);
+    return size;
+  };
+
+  prefix_pos += take(std::next(std::data(prefix), static_cast<std::ptrdiff_t>(prefix_pos)), std::size(prefix) - prefix_pos);
+
+  if (gcount_ < count && file_remaining > 0 && file) {
+    auto size = static_cast<std::streamsize>(std::min<uint64_t>(file_remaining, static_cast<uint64_t>(count - gcount_)));
+    file.read(std::next(s, gcount_), size);
+    gcount_ += file.gcount();
+    file_remaining -= static_cast<uint64_t>(file.gcount());
+    if (file.gcount() < size) {
+      file_remaining = 0;
+    }
+  }
+
+  if (file_remaining == 0 || !file) {
+    suffix_pos += take(std::next(std::data(suffix), static_cast<std::ptrdiff_t>(suffix_pos)), std::size(suffix) - suffix_pos);
+  }
+
+  fail_ = (gcount_ < count);
+  return *this;
+}
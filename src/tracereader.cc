@@ -16,11 +16,16 @@
 
 #include "tracereader.h"
 
+#include <filesystem>
 #include <fstream>
 #include <string>
 
+#include "async_tracereader.h"
 #include "inf_stream.h"
+#include "mmap_tracereader.h"
 #include "repeatable.h"
+#include "trace_index.h"
+#include "util/type_traits.h"
 
 namespace champsim
 {
@@ -32,41 +37,121 @@ ooo_model_instr apply_branch_target(ooo_model_instr branch, const ooo_model_inst
   return branch;
 }
 
-template <template <class, class> typename R, typename T>
-champsim::tracereader get_tracereader_for_type(std::string fname, uint8_t cpu)
+template <typename R>
+champsim::tracereader make_tracereader(R&& reader, bool async)
+{
+  if (async) {
+    return champsim::tracereader{champsim::async_tracereader<R>{std::forward<R>(reader)}};
+  }
+  return champsim::tracereader{std::forward<R>(reader)};
+}
+
+// The reader that holds the trace file, inside any repeatable wrapper
+template <typename R>
+auto& innermost_reader(R& reader)
+{
+  if constexpr (champsim::is_specialization_v<R, champsim::repeatable>) {
+    return reader.intern_;
+  } else {
+    return reader;
+  }
+}
+
+template <template <class, class> typename R, typename T, typename Tag>
+champsim::tracereader get_compressed_tracereader(const std::string& fname, uint8_t cpu, const tracereader_options& options)
+{
+  using stream_type = champsim::inf_istream<Tag, champsim::spliced_ifstream>;
+  R<T, stream_type> reader{cpu, fname};
+
+  if (options.skip_instructions > 0) {
+    auto& base = innermost_reader(reader);
+    uint64_t skip_bytes = options.skip_instructions * sizeof(T);
+    if (auto index = champsim::load_trace_index(fname); index.has_value()) {
+      if (auto point = index->restart_point(skip_bytes); point.has_value()) {
+        base = champsim::bulk_tracereader<T, stream_type>{cpu, stream_type{champsim::spliced_ifstream{fname, index.value(), point.value()}}};
+        skip_bytes -= point->uncompressed_offset;
+      }
+    }
+    base.discard(skip_bytes);
+  }
+
+  return make_tracereader(std::move(reader), options.async);
+}
+
+template <typename T, typename R>
+champsim::tracereader get_uncompressed_tracereader(R&& reader, const tracereader_options& options)
+{
+  if (options.skip_instructions > 0) {
+    auto& base = innermost_reader(reader);
+    if constexpr (champsim::is_specialization_v<std::decay_t<decltype(base)>, champsim::mmap_tracereader>) {
+      base.skip(options.skip_instructions);
+    } else {
+      base.discard(options.skip_instructions * sizeof(T));
+    }
+  }
+
+  return make_tracereader(std::forward<R>(reader), options.async);
+}
+
+template <template <class, class> typename R, template <class> typename M, typename T>
+champsim::tracereader get_tracereader_for_type(std::string fname, uint8_t cpu, const tracereader_options& options)
 {
   if (bool is_gzip_compressed = (fname.substr(std::size(fname) - 2) == "gz"); is_gzip_compressed) {
-    return champsim::tracereader{R<T, champsim::inf_istream<champsim::decomp_tags::gzip_tag_t<>>>(cpu, fname)};
+    return get_compressed_tracereader<R, T, champsim::decomp_tags::gzip_tag_t<>>(fname, cpu, options);
   }
 
   if (bool is_lzma_compressed = (fname.substr(std::size(fname) - 2) == "xz"); is_lzma_compressed) {
-    return champsim::tracereader{R<T, champsim::inf_istream<champsim::decomp_tags::lzma_tag_t<>>>(cpu, fname)};
+    return get_compressed_tracereader<R, T, champsim::decomp_tags::lzma_tag_t<>>(fname, cpu, options);
   }
 
   if (bool is_bzip2_compressed = (fname.substr(std::size(fname) - 3) == "bz2"); is_bzip2_compressed) {
-    return champsim::tracereader{R<T, champsim::inf_istream<champsim::decomp_tags::bzip2_tag_t>>(cpu, fname)};
+    return get_compressed_tracereader<R, T, champsim::decomp_tags::bzip2_tag_t>(fname, cpu, options);
   }
 
-  return champsim::tracereader{R<T, std::ifstream>(cpu, fname)};
+  // Uncompressed traces are read in place, unless they cannot be mapped (for example, if they are pipes)
+  if (std::filesystem::is_regular_file(fname)) {
+    return get_uncompressed_tracereader<T>(M<T>(cpu, fname), options);
+  }
+
+  return get_uncompressed_tracereader<T>(R<T, std::ifstream>(cpu, fname), options);
 }
 } // namespace champsim
 
 template <typename T, typename S>
 using repeatable_reader_t = champsim::repeatable<champsim::bulk_tracereader<T, S>, uint8_t, std::string>;
 
+template <typename T>
+using repeatable_mmap_reader_t = champsim::repeatable<champsim::mmap_tracereader<T>, uint8_t, std::string>;
+
 champsim::tracereader get_tracereader(const std::string& fname, uint8_t cpu, bool is_cloudsuite, bool repeat)
 {
-  if (is_cloudsuite && repeat) {
-    return champsim::get_tracereader_for_type<repeatable_reader_t, cloudsuite_instr>(fname, cpu);
+  champsim::tracereader_options options;
+  options.cloudsuite = is_cloudsuite;
+  options.repeat = repeat;
+  return get_tracereader(fname, cpu, options);
+}
+
+champsim::tracereader get_tracereader(const std::string& fname, uint8_t cpu, const champsim::tracereader_options& options)
+{
+  if (options.op_class && options.repeat) {
+    return champsim::get_tracereader_for_type<repeatable_reader_t, repeatable_mmap_reader_t, op_class_instr>(fname, cpu, options);
+  }
+
+  if (options.op_class && !options.repeat) {
+    return champsim::get_tracereader_for_type<champsim::bulk_tracereader, champsim::mmap_tracereader, op_class_instr>(fname, cpu, options);
+  }
+
+  if (options.cloudsuite && options.repeat) {
+    return champsim::get_tracereader_for_type<repeatable_reader_t, repeatable_mmap_reader_t, cloudsuite_instr>(fname, cpu, options);
   }
 
-  if (is_cloudsuite && !repeat) {
-    return champsim::get_tracereader_for_type<champsim::bulk_tracereader, cloudsuite_instr>(fname, cpu);
+  if (options.cloudsuite && !options.repeat) {
+    return champsim::get_tracereader_for_type<champsim::bulk_tracereader, champsim::mmap_tracereader, cloudsuite_instr>(fname, cpu, options);
   }
 
-  if (!is_cloudsuite && repeat) {
-    return champsim::get_tracereader_for_type<repeatable_reader_t, input_instr>(fname, cpu);
+  if (!options.cloudsuite && options.repeat) {
+    return champsim::get_tracereader_for_type<repeatable_reader_t, repeatable_mmap_reader_t, input_instr>(fname, cpu, options);
   }
 
-  return champsim::get_tracereader_for_type<champsim::bulk_tracereader, input_instr>(fname, cpu);
+  return champsim::get_tracereader_for_type<champsim::bulk_tracereader, champsim::mmap_tracereader, input_instr>(fname, cpu, options);
 }
@@ -17,6 +17,7 @@
 #include "vmem.h"
 
 #include <cassert>
+#include <set>
 #include <fmt/core.h>
 
 #include "champsim.h"
@@ -26,8 +27,8 @@
 using namespace champsim::data::data_literals;
 
 VirtualMemory::VirtualMemory(champsim::data::bytes page_table_page_size, std::size_t page_table_levels, champsim::chrono::clock::duration minor_penalty,
-                             MEMORY_CONTROLLER& dram_, std::optional<uint64_t> randomization_seed_)
-    : randomization_seed(randomization_seed_), dram(dram_), minor_fault_penalty(minor_penalty), pt_levels(page_table_levels),
+                             std::vector<std::reference_wrapper<MEMORY_CONTROLLER>> dram_, std::optional<uint64_t> randomization_seed_)
+    : randomization_seed(randomization_seed_), dram(std::move(dram_)), minor_fault_penalty(minor_penalty), pt_levels(page_table_levels),
       pte_page_size(page_table_page_size),
       next_pte_page(
           champsim::dynamic_extent{champsim::data::bits{LOG2_PAGE_SIZE}, champsim::data::bits{champsim::lg2(champsim::data::bytes{pte_page_size}.count())}}, 0)
@@ -41,13 +42,23 @@ VirtualMemory::VirtualMemory(champsim::data::bytes page_table_page_size, std::si
   if (required_bits > champsim::address::bits) {
     fmt::print("[VMEM] WARNING: virtual memory configuration would require {} bits of addressing.\n", required_bits); // LCOV_EXCL_LINE
   }
-  if (required_bits > champsim::data::bits{champsim::lg2(dram.size().count())}) {
+  champsim::data::bytes dram_size{0};
+  for (const MEMORY_CONTROLLER& controller : dram) {
+    dram_size += controller.size();
+  }
+  if (required_bits > champsim::data::bits{champsim::lg2(dram_size.count())}) {
     fmt::print("[VMEM] WARNING: physical memory size is smaller than virtual memory size.\n"); // LCOV_EXCL_LINE
   }
   populate_pages();
   shuffle_pages();
 }
 
+VirtualMemory::VirtualMemory(champsim::data::bytes page_table_page_size, std::size_t page_table_levels, champsim::chrono::clock::duration minor_penalty,
+                             MEMORY_CONTROLLER& dram_, std::optional<uint64_t> randomization_seed_)
+    : VirtualMemory(page_table_page_size, page_table_levels, minor_penalty, std::vector{std::ref(dram_)}, randomization_seed_)
+{
+}
+
 VirtualMemory::VirtualMemory(champsim::data::bytes page_table_page_size, std::size_t page_table_levels, champsim::chrono::clock::duration minor_penalty,
                              MEMORY_CONTROLLER& dram_)
     : VirtualMemory(page_table_page_size, page_table_levels, minor_penalty, dram_, {})
@@ -56,15 +67,22 @@ VirtualMemory::VirtualMemory(champsim::data::bytes page_table_page_size, std::si
 
 void VirtualMemory::populate_pages()
 {
-  assert(dram.size() > 1_MiB);
-  ppage_free_list.resize(((dram.size() - 1_MiB) / PAGE_SIZE).count());
-  assert(ppage_free_list.size() != 0);
-  champsim::page_number base_address =
-      champsim::page_number{champsim::lowest_address_for_size(std::max<champsim::data::mebibytes>(champsim::data::bytes{PAGE_SIZE}, 1_MiB))};
-  for (auto it = ppage_free_list.begin(); it != ppage_free_list.end(); it++) {
-    *it = base_address;
-    base_address++;
+  // Each tier of memory controllers shares one range
+  std::set<std::pair<champsim::address, champsim::address>> ranges;
+  for (const MEMORY_CONTROLLER& controller : dram) {
+    ranges.insert(controller.address_range());
+  }
+
+  // The first megabyte is not allocated
+  const champsim::page_number lowest_page{
+      champsim::lowest_address_for_size(std::max<champsim::data::mebibytes>(champsim::data::bytes{PAGE_SIZE}, 1_MiB))};
+  ppage_free_list.clear();
+  for (auto [first, end] : ranges) {
+    for (auto page = std::max(champsim::page_number{first}, lowest_page); page < champsim::page_number{end}; page++) {
+      ppage_free_list.push_back(page);
+    }
   }
+  assert(ppage_free_list.size() != 0);
 }
 
 void VirtualMemory::shuffle_pages()
@@ -153,3 +171,56 @@ std::pair<champsim::address, champsim::chrono::clock::duration> VirtualMemory::g
 
   return {paddr, penalty};
 }
+
+void VirtualMemory::save_checkpoint(champsim::checkpoint_writer& writer) const
+{
+  writer.begin_section("virtual memory");
+  writer.write(vpage_to_ppage_map);
+
+  // The extent of each page table key is determined by its level
+  writer.write(static_cast<uint64_t>(std::size(page_table)));
+  for (const auto& [key, paddr] : page_table) {
+    const auto& [cpu_num, level, vslice] = key;
+    writer.write(cpu_num);
+    writer.write(level);
+    writer.write(vslice.to<uint64_t>());
+    writer.write(paddr);
+  }
+
+  // Pages are only ever taken from the front of the free list, so the number that remain identifies it
+  writer.write(static_cast<uint64_t>(std::size(ppage_free_list)));
+  writer.write(active_pte_page);
+  writer.write(next_pte_page);
+}
+
+void VirtualMemory::load_checkpoint(champsim::checkpoint_reader& reader)
+{
+  reader.begin_section("virtual memory");
+  reader.read(vpage_to_ppage_map);
+
+  uint64_t page_table_size{};
+  reader.read(page_table_size);
+  page_table.clear();
+  for (uint64_t i = 0; i < page_table_size; ++i) {
+    uint32_t cpu_num{};
+    uint32_t level{};
+    uint64_t vslice{};
+    champsim::address paddr{};
+    reader.read(cpu_num);
+    reader.read(level);
+    reader.read(vslice);
+    reader.read(paddr);
+
+    champsim::dynamic_extent pte_table_entry_extent{champsim::address::bits, shamt(level + 1)};
+    page_table.try_emplace({cpu_num, level, champsim::address_slice{pte_table_entry_extent, vslice}}, paddr);
+  }
+
+  uint64_t free_pages{};
+  reader.read(free_pages);
+  if (free_pages > std::size(ppage_free_list)) {
+    throw champsim::checkpoint_error{"The checkpoint does not match this configuration: the physical memory size differs"};
+  }
+  ppage_free_list.erase(std::begin(ppage_free_list), std::next(std::begin(ppage_free_list), static_cast<long>(std::size(ppage_free_list) - free_pages)));
+  reader.read(active_pte_page);
+  reader.read(next_pte_page);
+}
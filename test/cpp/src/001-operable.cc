@@ -60,3 +60,36 @@ TEST_CASE("An operable with a scale greater than 2 skips multiple cycles")
 
   REQUIRE(uut.count == num_cycles / 4);
 }
+
+TEST_CASE("An operable must operate every cycle by default")
+{
+  champsim::chrono::clock::duration period{100};
+  mock_operable uut{period};
+  uut.current_time += 3 * period;
+
+  REQUIRE(uut.next_event() == uut.current_time + period);
+}
+
+TEST_CASE("An operable that skips to a clock advances without operating")
+{
+  struct skip_counting_operable : mock_operable {
+    using mock_operable::mock_operable;
+    long skipped = 0;
+    void skip_cycles(long count) final { skipped += count; }
+  };
+
+  champsim::chrono::clock global_clock{};
+  champsim::chrono::clock::duration period{150};
+  skip_counting_operable uut{period};
+
+  global_clock.tick(champsim::chrono::picoseconds{1000});
+  uut.skip_to(global_clock);
+
+  CHECK(uut.count == 0);
+  CHECK(uut.skipped == 7);
+  CHECK(uut.current_time == champsim::chrono::clock::time_point{} + 7 * period);
+
+  global_clock.tick(champsim::chrono::picoseconds{100});
+  uut.operate_on(global_clock);
+  REQUIRE(uut.count == 1);
+}
@@ -0,0 +1,164 @@
+#include <catch.hpp>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "cache.h"
+#include "core_parallel.h"
+#include "defaults.hpp"
+#include "environment.h"
+#include "instr.h"
+#include "mocks.hpp"
+#include "ooo_cpu.h"
+#include "tracereader.h"
+
+namespace
+{
+/*
+ * Two cores, each with a private L1I and L1D, sharing a last-level cache
+ */
+struct two_core_environment final : public champsim::environment {
+  std::vector<champsim::channel> channels{std::vector<champsim::channel>(8)};
+  do_nothing_MRC mock_memory{10};
+  std::array<do_nothing_MRC, 4> mock_translators{};
+  std::vector<CACHE> caches;
+  std::vector<O3_CPU> cores;
+
+  two_core_environment()
+  {
+    caches.reserve(5);
+    caches.emplace_back(champsim::cache_builder{champsim::defaults::default_llc}
+                            .name("010-LLC")
+                            .upper_levels({&channels.at(0), &channels.at(1), &channels.at(2), &channels.at(3)})
+                            .lower_level(&mock_memory.queues));
+    for (std::size_t i = 0; i < 2; ++i) {
+      caches.emplace_back(champsim::cache_builder{champsim::defaults::default_l1i}
+                              .name("010-L1I-" + std::to_string(i))
+                              .upper_levels({&channels.at(4 + 2 * i)})
+                              .lower_translate(&mock_translators.at(2 * i).queues)
+                              .lower_level(&channels.at(2 * i)));
+      caches.emplace_back(champsim::cache_builder{champsim::defaults::default_l1d}
+                              .name("010-L1D-" + std::to_string(i))
+                              .upper_levels({&channels.at(5 + 2 * i)})
+                              .lower_translate(&mock_translators.at(2 * i + 1).queues)
+                              .lower_level(&channels.at(2 * i + 1)));
+    }
+
+    cores.reserve(2);
+    for (uint32_t i = 0; i < 2; ++i) {
+      cores.emplace_back(champsim::core_builder{champsim::defaults::default_core}
+                             .index(i)
+                             .fetch_queues(&channels.at(4 + 2 * i))
+                             .data_queues(&channels.at(5 + 2 * i))
+                             .l1i(&caches.at(1 + 2 * i)));
+    }
+  }
+
+  std::vector<std::reference_wrapper<O3_CPU>> cpu_view() final { return {std::begin(cores), std::end(cores)}; }
+  std::vector<std::reference_wrapper<CACHE>> cache_view() final { return {std::begin(caches), std::end(caches)}; }
+  std::vector<std::reference_wrapper<PageTableWalker>> ptw_view() final { return {}; }
+  std::vector<std::reference_wrapper<MEMORY_CONTROLLER>> dram_view() final { return {}; }
+  std::vector<std::reference_wrapper<champsim::operable>> operable_view() final
+  {
+    std::vector<std::reference_wrapper<champsim::operable>> retval{std::begin(cores), std::end(cores)};
+    retval.insert(std::end(retval), std::begin(caches), std::end(caches));
+    retval.insert(std::end(retval), std::begin(mock_translators), std::end(mock_translators));
+    retval.emplace_back(mock_memory);
+    return retval;
+  }
+};
+
+std::vector<champsim::tracereader> make_traces()
+{
+  std::vector<champsim::tracereader> traces;
+  for (uint8_t cpu = 0; cpu < 2; ++cpu) {
+    traces.emplace_back([cpu, i = uint64_t{0}]() mutable {
+      ++i;
+      return champsim::test::instruction_with_ip_and_source_memory(champsim::address{0x400000 + 4 * i},
+                                                                    champsim::address{0x10000000 * (cpu + 1u) + 64 * (i % 4096)});
+    });
+  }
+  return traces;
+}
+
+void run(champsim::environment& env, champsim::core_parallel_engine& engine, long steps)
+{
+  for (champsim::operable& op : env.operable_view()) {
+    op.initialize();
+    op.warmup = false;
+    op.begin_phase();
+  }
+
+  auto traces = make_traces();
+  champsim::chrono::clock global_clock;
+  const auto period = env.cpu_view().front().get().clock_period;
+  for (long i = 0; i < steps; i += engine.quantum()) {
+    global_clock.tick(period * engine.quantum());
+    engine.do_quantum(traces, {0, 1}, global_clock, period);
+  }
+}
+} // namespace
+
+TEST_CASE("The core-parallel engine keeps only per-core caches private")
+{
+  two_core_environment env;
+  champsim::core_parallel_engine uut{env, 2, 1};
+
+  CHECK(uut.num_workers() == 2);
+  CHECK(uut.is_private(env.cores.at(0)));
+  CHECK(uut.is_private(env.cores.at(1)));
+  CHECK_FALSE(uut.is_private(env.caches.at(0)));
+  for (std::size_t i = 1; i < std::size(env.caches); ++i) {
+    CHECK(uut.is_private(env.caches.at(i)));
+  }
+  CHECK_FALSE(uut.is_private(env.mock_memory));
+}
+
+TEST_CASE("The core-parallel engine does not use more workers than cores")
+{
+  two_core_environment env;
+  champsim::core_parallel_engine uut{env, 16, 1};
+  REQUIRE(uut.num_workers() == 2);
+}
+
+TEST_CASE("A core-parallel run with a quantum of one matches a single-threaded run")
+{
+  constexpr long steps = 2000;
+  two_core_environment serial_env;
+  champsim::core_parallel_engine serial{serial_env, 1, 1};
+  run(serial_env, serial, steps);
+
+  two_core_environment parallel_env;
+  champsim::core_parallel_engine parallel{parallel_env, 2, 1};
+  run(parallel_env, parallel, steps);
+
+  for (std::size_t i = 0; i < 2; ++i) {
+    CHECK(serial_env.cores.at(i).num_retired > 0);
+    CHECK(parallel_env.cores.at(i).num_retired == serial_env.cores.at(i).num_retired);
+    CHECK(parallel_env.cores.at(i).sim_stats.instrs() == serial_env.cores.at(i).sim_stats.instrs());
+  }
+  for (std::size_t i = 0; i < std::size(serial_env.caches); ++i) {
+    CHECK(parallel_env.caches.at(i).sim_stats.hits.total() == serial_env.caches.at(i).sim_stats.hits.total());
+    CHECK(parallel_env.caches.at(i).sim_stats.misses.total() == serial_env.caches.at(i).sim_stats.misses.total());
+  }
+}
+
+TEST_CASE("A core-parallel run with a larger quantum is deterministic")
+{
+  constexpr long steps = 2000;
+  constexpr long quantum = 8;
+  two_core_environment first_env;
+  champsim::core_parallel_engine first{first_env, 1, quantum};
+  run(first_env, first, steps);
+
+  two_core_environment second_env;
+  champsim::core_parallel_engine second{second_env, 2, quantum};
+  run(second_env, second, steps);
+
+  for (std::size_t i = 0; i < 2; ++i) {
+    CHECK(first_env.cores.at(i).num_retired > 0);
+    CHECK(second_env.cores.at(i).num_retired == first_env.cores.at(i).num_retired);
+    CHECK(second_env.cores.at(i).current_time == first_env.cores.at(i).current_time);
+  }
+}
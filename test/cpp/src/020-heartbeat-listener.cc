@@ -18,7 +18,7 @@ TEST_CASE("The heartbeat listener prints one line after 10M instructions retired
     uut.handle_event<Event::BEGIN_PHASE>(in_warmup);
     
     for (int i = 0; i < 5000000; ++i) {
-        std::deque<ooo_model_instr> fake_instructions{{ooo_model_instr(0, input_instr()), ooo_model_instr(0, input_instr())}};
+        champsim::ring_buffer<ooo_model_instr> fake_instructions{{ooo_model_instr(0, input_instr()), ooo_model_instr(0, input_instr())}};
         uint32_t cpu = 0;
         uint64_t curr_cycles = i;
         auto cb = std::cbegin(fake_instructions);
@@ -52,7 +52,8 @@ TEST_CASE("The heartbeat listener prints cumulative and heartbeat IPC correctly
       
         // warmup behavior (4 IPC)
         if (i < 4000000) {
-          std::deque<ooo_model_instr> fake_instructions{{ooo_model_instr(0, input_instr()), ooo_model_instr(0, input_instr()), ooo_model_instr(0, input_instr()), ooo_model_instr(0, input_instr())}};
+          champsim::ring_buffer<ooo_model_instr> fake_instructions{
+              {ooo_model_instr(0, input_instr()), ooo_model_instr(0, input_instr()), ooo_model_instr(0, input_instr()), ooo_model_instr(0, input_instr())}};
           uint32_t cpu = 0;
           uint64_t curr_cycles = i;
           auto cb = std::cbegin(fake_instructions);
@@ -60,7 +61,7 @@ TEST_CASE("The heartbeat listener prints cumulative and heartbeat IPC correctly
           uut.handle_event<Event::RETIRE>(cpu, cb, ce, curr_cycles);
         } else {
           // simulation behavior (2 IPC)
-          std::deque<ooo_model_instr> fake_instructions{{ooo_model_instr(0, input_instr()), ooo_model_instr(0, input_instr())}};
+          champsim::ring_buffer<ooo_model_instr> fake_instructions{{ooo_model_instr(0, input_instr()), ooo_model_instr(0, input_instr())}};
           uint32_t cpu = 0;
           uint64_t curr_cycles = i;
           auto cb = std::cbegin(fake_instructions);
@@ -95,7 +96,7 @@ TEST_CASE("The heartbeat listener prints correctly with multiple CPUs") {
     for (int i = 0; i < 5000000; ++i) {
         
         // simulation behavior (2 IPC)
-        std::deque<ooo_model_instr> fake_instructions{{ooo_model_instr(0, input_instr()), ooo_model_instr(0, input_instr())}};
+        champsim::ring_buffer<ooo_model_instr> fake_instructions{{ooo_model_instr(0, input_instr()), ooo_model_instr(0, input_instr())}};
         uint32_t cpu = 0;
         uint64_t curr_cycles = i;
         auto cb = std::cbegin(fake_instructions);
@@ -0,0 +1,119 @@
+#include <catch.hpp>
+
+#include <array>
+#include <deque>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "checkpoint.h"
+#include "util/lru_table.h"
+
+namespace
+{
+struct type_with_getters {
+  unsigned int value;
+
+  auto index() const { return value; }
+
+  auto tag() const { return value; }
+};
+} // namespace
+
+TEST_CASE("Values written to a checkpoint are read back unchanged")
+{
+  std::vector<int> vec{1, 2, 3};
+  std::deque<long> deq{4, 5};
+  std::map<std::pair<uint32_t, uint64_t>, std::string> mapping{{{0, 0xdead}, "beef"}, {{1, 0xcafe}, "babe"}};
+  std::optional<uint64_t> engaged{0xfeed};
+  std::optional<uint64_t> disengaged{};
+  std::array<std::vector<bool>, 2> nested{std::vector<bool>{true, false, true}, std::vector<bool>{}};
+
+  std::stringstream stream;
+  champsim::checkpoint_writer writer{stream};
+  writer.begin_section("test");
+  writer.write(vec);
+  writer.write(deq);
+  writer.write(mapping);
+  writer.write(engaged);
+  writer.write(disengaged);
+  writer.write(nested);
+
+  std::vector<int> vec_in{7};
+  std::deque<long> deq_in{};
+  std::map<std::pair<uint32_t, uint64_t>, std::string> mapping_in{{{2, 0}, "stale"}};
+  std::optional<uint64_t> engaged_in{};
+  std::optional<uint64_t> disengaged_in{1};
+  std::array<std::vector<bool>, 2> nested_in{};
+
+  champsim::checkpoint_reader reader{stream};
+  reader.begin_section("test");
+  reader.read(vec_in);
+  reader.read(deq_in);
+  reader.read(mapping_in);
+  reader.read(engaged_in);
+  reader.read(disengaged_in);
+  reader.read(nested_in);
+
+  CHECK(vec_in == vec);
+  CHECK(deq_in == deq);
+  CHECK(mapping_in == mapping);
+  CHECK(engaged_in == engaged);
+  CHECK(disengaged_in == disengaged);
+  CHECK(nested_in == nested);
+}
+
+TEST_CASE("A checkpoint with a different section name is rejected")
+{
+  std::stringstream stream;
+  champsim::checkpoint_writer writer{stream};
+  writer.begin_section("LLC");
+
+  champsim::checkpoint_reader reader{stream};
+  REQUIRE_THROWS_AS(reader.begin_section("L2C"), champsim::checkpoint_error);
+}
+
+TEST_CASE("A truncated checkpoint is rejected")
+{
+  std::stringstream stream;
+  champsim::checkpoint_writer writer{stream};
+  writer.write(uint32_t{2016});
+
+  champsim::checkpoint_reader reader{stream};
+  uint64_t value{};
+  REQUIRE_THROWS_AS(reader.read(value), champsim::checkpoint_error);
+}
+
+TEST_CASE("An lru_table restored from a checkpoint keeps its contents")
+{
+  champsim::lru_table<::type_with_getters> uut{4, 2};
+  uut.fill({0x11});
+  uut.fill({0x22});
+
+  std::stringstream stream;
+  champsim::checkpoint_writer writer{stream};
+  writer.write(uut);
+
+  champsim::lru_table<::type_with_getters> restored{4, 2};
+  champsim::checkpoint_reader reader{stream};
+  reader.read(restored);
+
+  CHECK(restored.check_hit({0x11}).has_value());
+  CHECK(restored.check_hit({0x22}).has_value());
+  CHECK_FALSE(restored.check_hit({0x33}).has_value());
+}
+
+TEST_CASE("An lru_table of a different size cannot be restored")
+{
+  champsim::lru_table<::type_with_getters> uut{4, 2};
+
+  std::stringstream stream;
+  champsim::checkpoint_writer writer{stream};
+  writer.write(uut);
+
+  champsim::lru_table<::type_with_getters> restored{8, 2};
+  champsim::checkpoint_reader reader{stream};
+  REQUIRE_THROWS_AS(reader.read(restored), champsim::checkpoint_error);
+}
@@ -0,0 +1,87 @@
+#include <catch.hpp>
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+#include "instruction.h"
+#include "util/inline_vector.h"
+
+namespace
+{
+input_instr full_trace_record(unsigned long long seed)
+{
+  input_instr record{};
+  record.ip = 0x400000 + 4 * seed;
+  for (auto& reg : record.destination_registers) {
+    reg = static_cast<unsigned char>(10 + seed % 4);
+  }
+  for (auto& reg : record.source_registers) {
+    reg = static_cast<unsigned char>(20 + seed % 4);
+  }
+  for (auto& mem : record.destination_memory) {
+    mem = 0x10000000 + 0x40 * seed;
+  }
+  for (auto& mem : record.source_memory) {
+    mem = 0x20000000 + 0x40 * seed;
+  }
+  return record;
+}
+} // namespace
+
+TEST_CASE("An inline_vector behaves like a vector within its capacity")
+{
+  champsim::inline_vector<int, 4> uut{1, 2, 3};
+  STATIC_REQUIRE(std::is_trivially_copyable_v<decltype(uut)>);
+  REQUIRE(std::size(uut) == 3);
+  REQUIRE_THAT(uut, Catch::Matchers::RangeEquals(std::vector{1, 2, 3}));
+
+  uut.push_back(4);
+  REQUIRE(uut.back() == 4);
+  REQUIRE_THROWS_AS(uut.push_back(5), std::length_error);
+  REQUIRE_THROWS_AS(uut.at(4), std::out_of_range);
+
+  uut.erase(std::remove(std::begin(uut), std::end(uut), 2), std::end(uut));
+  REQUIRE_THAT(uut, Catch::Matchers::RangeEquals(std::vector{1, 3, 4}));
+  REQUIRE(uut == champsim::inline_vector<int, 4>{1, 3, 4});
+  REQUIRE(uut != champsim::inline_vector<int, 4>{1, 3});
+
+  uut.clear();
+  REQUIRE_THAT(uut, Catch::Matchers::IsEmpty());
+}
+
+TEST_CASE("Instructions own no heap storage, so they do not allocate when they are decoded, copied, or moved")
+{
+  // A type that owned heap storage would need a destructor to free it
+  STATIC_REQUIRE(std::is_trivially_copyable_v<ooo_model_instr>);
+  STATIC_REQUIRE(std::is_trivially_destructible_v<ooo_model_instr>);
+
+  std::vector<ooo_model_instr> decoded;
+  for (unsigned long long i = 0; i < 64; ++i) {
+    ooo_model_instr instr{0, full_trace_record(i)};
+    auto copy = instr;
+    decoded.push_back(std::move(copy));
+  }
+
+  REQUIRE(std::size(decoded.back().source_memory) == NUM_INSTR_SOURCES);
+  REQUIRE(std::size(decoded.back().destination_memory) == NUM_INSTR_DESTINATIONS);
+}
+
+TEST_CASE("Instruction decode benchmark")
+{
+  std::vector<input_instr> records;
+  for (unsigned long long i = 0; i < 4096; ++i) {
+    records.push_back(full_trace_record(i));
+  }
+  std::vector<ooo_model_instr> decoded;
+  decoded.reserve(std::size(records));
+
+  BENCHMARK("Decode and move 4096 trace records")
+  {
+    decoded.clear();
+    for (const auto& record : records) {
+      decoded.push_back(ooo_model_instr{0, record});
+    }
+    return std::size(decoded);
+  };
+}
@@ -0,0 +1,144 @@
+#include <catch.hpp>
+
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "instruction.h"
+#include "util/ring_buffer.h"
+
+SCENARIO("A ring buffer keeps its elements in order as it wraps around")
+{
+  GIVEN("A ring buffer with a reserved capacity")
+  {
+    champsim::ring_buffer<int> uut;
+    uut.reserve(4);
+    REQUIRE(uut.capacity() == 4);
+
+    WHEN("More elements than its capacity pass through it")
+    {
+      std::vector<int> popped;
+      for (int i = 0; i < 10; ++i) {
+        uut.push_back(i);
+        if (std::size(uut) == 3) {
+          popped.push_back(uut.front());
+          uut.pop_front();
+        }
+      }
+
+      THEN("The elements leave in the order they entered, and the storage is not reallocated")
+      {
+        REQUIRE(popped == std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7});
+        REQUIRE(std::vector<int>(std::begin(uut), std::end(uut)) == std::vector<int>{8, 9});
+        REQUIRE(uut.capacity() == 4);
+      }
+    }
+
+    WHEN("An iterator is taken, and an earlier element is removed")
+    {
+      uut.push_back(1);
+      uut.push_back(2);
+      uut.push_back(3);
+      auto it = std::next(std::begin(uut));
+      uut.pop_front();
+      uut.push_back(4);
+
+      THEN("The iterator still refers to its element") { REQUIRE(*it == 2); }
+    }
+
+    WHEN("More elements than its capacity are held")
+    {
+      for (int i = 0; i < 9; ++i) {
+        uut.push_back(i);
+      }
+
+      THEN("It grows")
+      {
+        REQUIRE(std::size(uut) == 9);
+        REQUIRE(uut.capacity() >= 9);
+        REQUIRE(uut.at(8) == 8);
+        REQUIRE_THROWS_AS(uut.at(9), std::out_of_range);
+      }
+    }
+  }
+}
+
+SCENARIO("Elements can be erased from and inserted into a ring buffer")
+{
+  GIVEN("A ring buffer whose elements wrap around its storage")
+  {
+    champsim::ring_buffer<std::string> uut;
+    uut.reserve(8);
+    for (int i = 0; i < 6; ++i) {
+      uut.push_back("x");
+      uut.pop_front();
+    }
+    for (int i = 0; i < 6; ++i) {
+      uut.push_back(std::to_string(i));
+    }
+
+    WHEN("A prefix is erased")
+    {
+      uut.erase(std::cbegin(uut), std::next(std::cbegin(uut), 2));
+      THEN("The rest remain") { REQUIRE(std::vector<std::string>(std::begin(uut), std::end(uut)) == std::vector<std::string>{"2", "3", "4", "5"}); }
+    }
+
+    WHEN("A range in the middle is erased")
+    {
+      auto next = uut.erase(std::next(std::cbegin(uut), 1), std::next(std::cbegin(uut), 3));
+      THEN("The later elements move down")
+      {
+        REQUIRE(*next == "3");
+        REQUIRE(std::vector<std::string>(std::begin(uut), std::end(uut)) == std::vector<std::string>{"0", "3", "4", "5"});
+      }
+    }
+
+    WHEN("A range is inserted in the middle")
+    {
+      std::vector<std::string> to_insert{"a", "b"};
+      uut.insert(std::next(std::cbegin(uut), 2), std::begin(to_insert), std::end(to_insert));
+      THEN("It is placed before the given position")
+      {
+        REQUIRE(std::vector<std::string>(std::begin(uut), std::end(uut)) == std::vector<std::string>{"0", "1", "a", "b", "2", "3", "4", "5"});
+      }
+    }
+  }
+}
+
+SCENARIO("Instructions can be found by their ID in a ring buffer")
+{
+  GIVEN("A ring buffer of instructions with consecutive IDs")
+  {
+    champsim::ring_buffer<ooo_model_instr> uut;
+    for (uint64_t id = 100; id < 110; ++id) {
+      uut.push_back(ooo_model_instr{0, input_instr{}});
+      uut.back().instr_id = id;
+    }
+
+    THEN("Each is found")
+    {
+      for (uint64_t id = 100; id < 110; ++id) {
+        auto found = ooo_model_instr::find_id(std::begin(uut), std::end(uut), id);
+        REQUIRE(found != std::end(uut));
+        REQUIRE(found->instr_id == id);
+      }
+    }
+
+    THEN("IDs outside the buffer are not found")
+    {
+      REQUIRE(ooo_model_instr::find_id(std::begin(uut), std::end(uut), 99) == std::end(uut));
+      REQUIRE(ooo_model_instr::find_id(std::begin(uut), std::end(uut), 110) == std::end(uut));
+    }
+
+    WHEN("An instruction is removed from the middle")
+    {
+      uut.erase(std::next(std::cbegin(uut), 4));
+
+      THEN("The later instructions are still found")
+      {
+        REQUIRE(ooo_model_instr::find_id(std::begin(uut), std::end(uut), 104) == std::end(uut));
+        REQUIRE(ooo_model_instr::find_id(std::begin(uut), std::end(uut), 107)->instr_id == 107);
+      }
+    }
+  }
+}
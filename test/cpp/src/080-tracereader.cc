@@ -62,3 +62,24 @@ TEST_CASE("A tracereader can read the byte representation of an input_instr")
   REQUIRE_THAT(inst1.destination_memory, Catch::Matchers::IsEmpty());
   REQUIRE_THAT(inst1.source_memory, Catch::Matchers::IsEmpty());
 }
+
+TEST_CASE("A tracereader can read the op class of each instruction")
+{
+  std::array<op_class_instr, 2> records{};
+  records[0].ip = 0x1000;
+  records[0].op_class = static_cast<unsigned char>(champsim::op_class::fp);
+  records[1].ip = 0x1004;
+  records[1].op_class = std::numeric_limits<unsigned char>::max();
+
+  std::string bytes(sizeof(records), '\0');
+  std::memcpy(std::data(bytes), std::data(records), sizeof(records));
+
+  champsim::bulk_tracereader<op_class_instr, std::istringstream> uut{0, std::istringstream{bytes}};
+  auto inst0 = uut();
+  REQUIRE(inst0.ip == champsim::address{0x1000});
+  REQUIRE(inst0.op_class == champsim::op_class::fp);
+
+  auto inst1 = uut();
+  REQUIRE(inst1.ip == champsim::address{0x1004});
+  REQUIRE(inst1.op_class == champsim::op_class::unknown);
+}
@@ -0,0 +1,64 @@
+#include <catch.hpp>
+#include <stdexcept>
+#include <vector>
+
+#include "async_tracereader.h"
+#include "tracereader.h"
+
+namespace
+{
+struct counting_reader {
+  uint64_t count;
+  uint64_t next = 0;
+
+  explicit counting_reader(uint64_t c) : count(c) {}
+
+  [[nodiscard]] bool eof() const { return next >= count; }
+
+  ooo_model_instr operator()()
+  {
+    input_instr instr{};
+    instr.ip = 0x400000 + 4 * (next++);
+    return ooo_model_instr{0, instr};
+  }
+};
+
+struct throwing_reader {
+  ooo_model_instr operator()() { throw std::runtime_error{"The trace is corrupt"}; }
+};
+} // namespace
+
+TEST_CASE("An asynchronous tracereader returns the instructions of the wrapped reader in order")
+{
+  constexpr uint64_t length = 1000;
+  champsim::async_tracereader<counting_reader> uut{counting_reader{length}, 64, 2};
+
+  std::vector<uint64_t> ips;
+  while (!uut.eof()) {
+    ips.push_back(uut().ip.to<uint64_t>());
+  }
+
+  REQUIRE(std::size(ips) == length);
+  for (uint64_t i = 0; i < length; ++i) {
+    CHECK(ips.at(i) == 0x400000 + 4 * i);
+  }
+}
+
+TEST_CASE("An asynchronous tracereader can wrap a reader that never ends")
+{
+  champsim::tracereader uut{champsim::async_tracereader{[]() {
+                              return ooo_model_instr{0, input_instr{}};
+                            }, 16, 2}};
+
+  for (int i = 0; i < 100; ++i) {
+    REQUIRE_FALSE(uut.eof());
+    (void)uut();
+  }
+  // The reader is destroyed while the decoder is waiting for space
+}
+
+TEST_CASE("An asynchronous tracereader passes errors to the simulation thread")
+{
+  champsim::async_tracereader<throwing_reader> uut{throwing_reader{}};
+  REQUIRE_THROWS_AS(uut(), std::runtime_error);
+}
@@ -0,0 +1,83 @@
+#include <catch.hpp>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "mmap_tracereader.h"
+#include "trace_instruction.h"
+#include "tracereader.h"
+
+namespace
+{
+std::vector<input_instr> make_records(std::size_t count)
+{
+  std::vector<input_instr> records;
+  for (std::size_t i = 0; i < count; ++i) {
+    input_instr record{};
+    record.ip = 0x400000 + 0x40 * i;
+    if (i % 3 == 0) {
+      // A direct jump
+      record.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+    } else {
+      record.destination_registers[0] = 12;
+      record.source_memory[0] = 0x10000000 + 0x100 * i;
+    }
+    records.push_back(record);
+  }
+  return records;
+}
+
+std::filesystem::path write_trace(const std::vector<input_instr>& records, const std::string& name)
+{
+  auto path = std::filesystem::temp_directory_path() / name;
+  std::ofstream out{path, std::ios::binary};
+  out.write(reinterpret_cast<const char*>(std::data(records)), static_cast<std::streamsize>(std::size(records) * sizeof(input_instr)));
+  return path;
+}
+} // namespace
+
+TEST_CASE("A memory-mapped tracereader matches the stream tracereader")
+{
+  auto records = make_records(1000);
+  auto path = write_trace(records, "087-mmap-tracereader.champsimtrace");
+
+  champsim::bulk_tracereader<input_instr, std::ifstream> expected{0, path.string()};
+  champsim::mmap_tracereader<input_instr> uut{0, path.string()};
+
+  std::size_t count = 0;
+  while (!expected.eof()) {
+    REQUIRE_FALSE(uut.eof());
+    auto expected_instr = expected();
+    auto uut_instr = uut();
+    CHECK(uut_instr.ip == expected_instr.ip);
+    CHECK(uut_instr.is_branch == expected_instr.is_branch);
+    CHECK(uut_instr.branch_target == expected_instr.branch_target);
+    CHECK(uut_instr.source_memory == expected_instr.source_memory);
+    ++count;
+  }
+
+  CHECK(uut.eof());
+  CHECK(count == std::size(records) - 1);
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("A memory-mapped tracereader of an empty file is at its end")
+{
+  auto path = write_trace({}, "087-mmap-tracereader-empty.champsimtrace");
+  champsim::mmap_tracereader<input_instr> uut{0, path.string()};
+  CHECK(uut.eof());
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("A memory-mapped tracereader can be restarted by a repeatable")
+{
+  auto records = make_records(10);
+  auto path = write_trace(records, "087-mmap-tracereader-repeat.champsimtrace");
+  auto uut = get_tracereader(path.string(), 0, false, true);
+
+  for (std::size_t i = 0; i < 2 * std::size(records); ++i) {
+    auto instr = uut();
+    CHECK(instr.ip == champsim::address{records.at(i % (std::size(records) - 1)).ip});
+  }
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,157 @@
+#include <catch.hpp>
+#include <filesystem>
+#include <fstream>
+#include <lzma.h>
+#include <sstream>
+#include <vector>
+#include <zlib.h>
+
+#include "trace_index.h"
+#include "trace_instruction.h"
+#include "tracereader.h"
+
+namespace
+{
+constexpr std::size_t num_records = 20000;
+constexpr std::size_t chunk_records = 1500;
+
+std::vector<input_instr> make_records()
+{
+  std::vector<input_instr> records;
+  for (std::size_t i = 0; i < num_records; ++i) {
+    input_instr record{};
+    record.ip = 0x400000 + 4 * i;
+    if (i % 5 == 0) {
+      record.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+    }
+    records.push_back(record);
+  }
+  return records;
+}
+
+std::string as_bytes(const std::vector<input_instr>& records)
+{
+  return std::string{reinterpret_cast<const char*>(std::data(records)), std::size(records) * sizeof(input_instr)};
+}
+
+// Compress with a new xz block every chunk
+std::string compress_xz(const std::string& data)
+{
+  lzma_stream strm = LZMA_STREAM_INIT;
+  REQUIRE(::lzma_easy_encoder(&strm, 0, LZMA_CHECK_CRC64) == LZMA_OK);
+
+  std::string retval;
+  std::vector<uint8_t> out_buf(1 << 16);
+  auto run = [&](lzma_action action) {
+    lzma_ret ret;
+    do {
+      strm.next_out = std::data(out_buf);
+      strm.avail_out = std::size(out_buf);
+      ret = ::lzma_code(&strm, action);
+      retval.append(reinterpret_cast<const char*>(std::data(out_buf)), std::size(out_buf) - strm.avail_out);
+    } while (ret == LZMA_OK && (action != LZMA_RUN || strm.avail_in > 0));
+  };
+
+  for (std::size_t pos = 0; pos < std::size(data); pos += chunk_records * sizeof(input_instr)) {
+    auto size = std::min(chunk_records * sizeof(input_instr), std::size(data) - pos);
+    strm.next_in = reinterpret_cast<const uint8_t*>(std::data(data) + pos);
+    strm.avail_in = size;
+    run(LZMA_RUN);
+    run(LZMA_FULL_FLUSH);
+  }
+  run(LZMA_FINISH);
+  ::lzma_end(&strm);
+  return retval;
+}
+
+// Compress with a full flush every chunk
+std::string compress_gzip(const std::string& data)
+{
+  z_stream strm{};
+  REQUIRE(::deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) == Z_OK);
+
+  std::string retval;
+  std::vector<unsigned char> out_buf(1 << 16);
+  for (std::size_t pos = 0; pos < std::size(data); pos += chunk_records * sizeof(input_instr)) {
+    auto size = std::min(chunk_records * sizeof(input_instr), std::size(data) - pos);
+    bool last = (pos + size == std::size(data));
+    strm.next_in = reinterpret_cast<unsigned char*>(const_cast<char*>(std::data(data) + pos));
+    strm.avail_in = static_cast<uInt>(size);
+    do {
+      strm.next_out = std::data(out_buf);
+      strm.avail_out = static_cast<uInt>(std::size(out_buf));
+      ::deflate(&strm, last ? Z_FINISH : Z_FULL_FLUSH);
+      retval.append(reinterpret_cast<const char*>(std::data(out_buf)), std::size(out_buf) - strm.avail_out);
+    } while (strm.avail_out == 0);
+  }
+  ::deflateEnd(&strm);
+  return retval;
+}
+
+std::string write_trace(const std::string& contents, const std::string& name)
+{
+  auto path = std::filesystem::temp_directory_path() / name;
+  std::ofstream out{path, std::ios::binary};
+  out.write(std::data(contents), static_cast<std::streamsize>(std::size(contents)));
+  return path.string();
+}
+} // namespace
+
+TEST_CASE("A trace index allows a trace to be entered partway through")
+{
+  auto records = make_records();
+  auto [name, contents] = GENERATE_REF(table<std::string, std::string>({{"088-trace-index.champsimtrace.xz", compress_xz(as_bytes(records))},
+                                                                         {"088-trace-index.champsimtrace.gz", compress_gzip(as_bytes(records))}}));
+  auto trace_name = write_trace(contents, name);
+
+  auto index = champsim::build_trace_index(trace_name, 1);
+  CHECK(std::size(index.entries) >= num_records / chunk_records - 1);
+
+  std::stringstream index_text;
+  champsim::write_trace_index(index_text, index);
+  auto reread = champsim::read_trace_index(index_text);
+  CHECK(std::size(reread.entries) == std::size(index.entries));
+
+  {
+    std::ofstream index_file{champsim::trace_index_name(trace_name)};
+    champsim::write_trace_index(index_file, index);
+  }
+
+  auto with_index = GENERATE(true, false);
+  if (!with_index) {
+    std::filesystem::remove(champsim::trace_index_name(trace_name));
+  }
+
+  auto skip = GENERATE(as<uint64_t>{}, 0, 1, chunk_records, chunk_records + 7, 12345);
+  champsim::tracereader_options options;
+  options.skip_instructions = skip;
+  auto uut = get_tracereader(trace_name, 0, options);
+
+  // The last record is never returned, since its branch target is unknown
+  for (std::size_t i = skip; i < num_records - 1; ++i) {
+    REQUIRE_FALSE(uut.eof());
+    auto instr = uut();
+    REQUIRE(instr.ip == champsim::address{records.at(i).ip});
+    if (instr.branch_taken) {
+      REQUIRE(instr.branch_target == champsim::address{records.at(i + 1).ip});
+    }
+  }
+  REQUIRE(uut.eof());
+
+  std::filesystem::remove(champsim::trace_index_name(trace_name));
+  std::filesystem::remove(trace_name);
+}
+
+TEST_CASE("The restart point is the last one before the offset")
+{
+  champsim::trace_index index;
+  index.entries = {{0, 12, 0, 0, 0}, {100, 50, 0, 0, 0}, {200, 90, 0, 0, 0}};
+
+  CHECK(index.restart_point(0).value().compressed_offset == 12);
+  CHECK(index.restart_point(150).value().compressed_offset == 50);
+  CHECK(index.restart_point(200).value().compressed_offset == 90);
+  CHECK(index.restart_point(5000).value().compressed_offset == 90);
+
+  index.entries.erase(std::begin(index.entries));
+  CHECK_FALSE(index.restart_point(50).has_value());
+}
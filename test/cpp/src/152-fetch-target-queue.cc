@@ -0,0 +1,109 @@
+#include <catch.hpp>
+
+#include "instr.h"
+#include "mocks.hpp"
+#include "ooo_cpu.h"
+
+SCENARIO("The branch predictor runs ahead of fetch into the fetch target queue")
+{
+  GIVEN("A core with a two-block fetch target queue and instructions in five different blocks")
+  {
+    constexpr std::array<uint64_t, 5> addrs{{0x1000, 0x2000, 0x3000, 0x4000, 0x5000}};
+
+    do_nothing_MRC mock_L1I{1000};
+    do_nothing_MRC mock_L1D;
+    O3_CPU uut{champsim::core_builder{}.fetch_queues(&mock_L1I.queues).data_queues(&mock_L1D.queues).ftq_size(2)};
+
+    std::array<champsim::operable*, 3> elements = {&uut, &mock_L1I, &mock_L1D};
+
+    for (auto addr : addrs) {
+      uut.input_queue.push_back(champsim::test::instruction_with_ip(addr));
+    }
+
+    WHEN("The core operates for one cycle")
+    {
+      for (auto x : elements)
+        x->_operate();
+
+      THEN("The first block is predicted and prefetched")
+      {
+        REQUIRE(std::size(uut.ftq_block_lengths) == 1);
+        REQUIRE(mock_L1I.queues.sim_stats.PQ_TO_CACHE == 1);
+        REQUIRE(std::empty(uut.IFETCH_BUFFER));
+      }
+    }
+
+    WHEN("The core operates while fetch waits on the L1I")
+    {
+      for (int i = 0; i < 10; ++i) {
+        for (auto x : elements)
+          x->_operate();
+      }
+
+      THEN("The fetch target queue fills to its size")
+      {
+        REQUIRE(std::size(uut.IFETCH_BUFFER) == 1);
+        REQUIRE(std::size(uut.ftq_block_lengths) == 2);
+        REQUIRE(std::size(uut.input_queue) == 2);
+      }
+
+      THEN("Every predicted block is prefetched, and only the fetched block is read")
+      {
+        REQUIRE(mock_L1I.queues.sim_stats.PQ_TO_CACHE == 3);
+        REQUIRE(mock_L1I.queues.sim_stats.RQ_TO_CACHE == 1);
+      }
+
+      THEN("The occupancy of the fetch target queue is recorded")
+      {
+        REQUIRE(uut.sim_stats.total_ftq_occupancy > 0);
+      }
+    }
+  }
+
+  GIVEN("A core with a fetch target queue and an instruction at the start of a block")
+  {
+    do_nothing_MRC mock_L1I{1000};
+    do_nothing_MRC mock_L1D;
+    O3_CPU uut{champsim::core_builder{}.fetch_queues(&mock_L1I.queues).data_queues(&mock_L1D.queues).ftq_size(4)};
+
+    std::array<champsim::operable*, 3> elements = {&uut, &mock_L1I, &mock_L1D};
+
+    uut.input_queue.push_back(champsim::test::instruction_with_ip(0x1000));
+    for (auto x : elements)
+      x->_operate();
+
+    WHEN("The rest of the block arrives in a later cycle")
+    {
+      uut.input_queue.push_back(champsim::test::instruction_with_ip(0x1004));
+      for (auto x : elements)
+        x->_operate();
+
+      THEN("The block is predicted as two entries, but prefetched once")
+      {
+        REQUIRE(mock_L1I.queues.sim_stats.PQ_TO_CACHE == 1);
+      }
+    }
+  }
+
+  GIVEN("A core without a fetch target queue")
+  {
+    do_nothing_MRC mock_L1I{1000};
+    do_nothing_MRC mock_L1D;
+    O3_CPU uut{champsim::core_builder{}.fetch_queues(&mock_L1I.queues).data_queues(&mock_L1D.queues)};
+
+    std::array<champsim::operable*, 3> elements = {&uut, &mock_L1I, &mock_L1D};
+
+    uut.input_queue.push_back(champsim::test::instruction_with_ip(0x1000));
+    uut.input_queue.push_back(champsim::test::instruction_with_ip(0x2000));
+
+    WHEN("The core operates")
+    {
+      for (int i = 0; i < 10; ++i) {
+        for (auto x : elements)
+          x->_operate();
+      }
+
+      THEN("No prefetches are issued") { REQUIRE(mock_L1I.queues.sim_stats.PQ_ACCESS == 0); }
+    }
+  }
+}
@@ -16,7 +16,8 @@ TEST_CASE("An empty core stats prints zero")
                                     "BRANCH_CONDITIONAL: -",
                                     "BRANCH_DIRECT_CALL: -",
                                     "BRANCH_INDIRECT_CALL: -",
-                                    "BRANCH_RETURN: -"};
+                                    "BRANCH_RETURN: -",
+                                    "test_cpu Front-End Stall Cycles: 0 Average FTQ Occupancy: - Wrong-Path Instructions: 0"};
 
   REQUIRE_THAT(champsim::plain_printer::format(given), Catch::Matchers::RangeEquals(expected));
 }
@@ -38,7 +39,8 @@ TEST_CASE("The number of instructions and cycles modifies the IPC")
                                     "BRANCH_CONDITIONAL: 0",
                                     "BRANCH_DIRECT_CALL: 0",
                                     "BRANCH_INDIRECT_CALL: 0",
-                                    "BRANCH_RETURN: 0"};
+                                    "BRANCH_RETURN: 0",
+                                    "test_cpu Front-End Stall Cycles: 0 Average FTQ Occupancy: 0 Wrong-Path Instructions: 0"};
 
   REQUIRE_THAT(champsim::plain_printer::format(given), Catch::Matchers::RangeEquals(expected));
 }
@@ -69,7 +71,8 @@ TEST_CASE("The number of mispredictions modifies the MPKI")
                                     "BRANCH_CONDITIONAL: 0",
                                     "BRANCH_DIRECT_CALL: 0",
                                     "BRANCH_INDIRECT_CALL: 0",
-                                    "BRANCH_RETURN: 0"};
+                                    "BRANCH_RETURN: 0",
+                                    "test_cpu Front-End Stall Cycles: 0 Average FTQ Occupancy: 0 Wrong-Path Instructions: 0"};
   expected.at(line_index) = expected_line;
 
   REQUIRE_THAT(champsim::plain_printer::format(given), Catch::Matchers::RangeEquals(expected));
@@ -97,7 +100,34 @@ TEST_CASE("The ROB occupancy modifies the flush penalty")
                                     "BRANCH_CONDITIONAL: 0",
                                     "BRANCH_DIRECT_CALL: 0",
                                     "BRANCH_INDIRECT_CALL: 0",
-                                    "BRANCH_RETURN: 0"};
+                                    "BRANCH_RETURN: 0",
+                                    "test_cpu Front-End Stall Cycles: 0 Average FTQ Occupancy: 0 Wrong-Path Instructions: 0"};
+
+  REQUIRE_THAT(champsim::plain_printer::format(given), Catch::Matchers::RangeEquals(expected));
+}
+
+TEST_CASE("The front-end stalls, FTQ occupancy, and wrong-path instructions are printed")
+{
+  cpu_stats given{};
+  given.name = "test_cpu";
+  given.begin_instrs = 0;
+  given.begin_cycles = 0;
+  given.end_instrs = 1000;
+  given.end_cycles = 500;
+  given.front_end_stall_cycles = 120;
+  given.total_ftq_occupancy = 1500;
+  given.wrong_path_instrs = 42;
+
+  std::vector<std::string> expected{"test_cpu cumulative IPC: 2 instructions: 1000 cycles: 500",
+                                    "test_cpu Branch Prediction Accuracy: -% MPKI: 0 Average ROB Occupancy at Mispredict: -",
+                                    "Branch type MPKI",
+                                    "BRANCH_DIRECT_JUMP: 0",
+                                    "BRANCH_INDIRECT: 0",
+                                    "BRANCH_CONDITIONAL: 0",
+                                    "BRANCH_DIRECT_CALL: 0",
+                                    "BRANCH_INDIRECT_CALL: 0",
+                                    "BRANCH_RETURN: 0",
+                                    "test_cpu Front-End Stall Cycles: 120 Average FTQ Occupancy: 3 Wrong-Path Instructions: 42"};
 
   REQUIRE_THAT(champsim::plain_printer::format(given), Catch::Matchers::RangeEquals(expected));
 }
@@ -0,0 +1,140 @@
+#include <catch.hpp>
+
+#include "instr.h"
+#include "mocks.hpp"
+#include "ooo_cpu.h"
+
+SCENARIO("A dependent instruction is woken when its producer completes")
+{
+  GIVEN("A ROB with a chain of dependent instructions")
+  {
+    constexpr unsigned execute_latency = 2;
+    constexpr uint64_t chain_length = 8;
+
+    do_nothing_MRC mock_L1I, mock_L1D;
+    O3_CPU uut{champsim::core_builder{}
+                   .schedule_width(champsim::bandwidth::maximum_type{128})
+                   .register_file_size(128)
+                   .schedule_latency(1)
+                   .execute_latency(execute_latency)
+                   .execute_width(champsim::bandwidth::maximum_type{4})
+                   .retire_width(champsim::bandwidth::maximum_type{4})
+                   .fetch_queues(&mock_L1I.queues)
+                   .data_queues(&mock_L1D.queues)};
+    uut.warmup = false;
+
+    for (uint64_t i = 0; i < chain_length; ++i) {
+      auto& instr = uut.ROB.emplace_back(champsim::test::instruction_with_ip(0x1000 + 4 * i));
+      instr.instr_id = i + 1;
+      instr.destination_registers.push_back(5);
+      if (i > 0) {
+        instr.source_registers.push_back(5);
+      }
+      instr.ready_time = champsim::chrono::clock::time_point{};
+    }
+
+    WHEN("The core runs until the chain retires")
+    {
+      bool executed_before_producer = false;
+      bool waited_after_producer = false;
+      for (int cycle = 0; cycle < 1000 && !std::empty(uut.ROB); ++cycle) {
+        for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+          op->_operate();
+
+        for (std::size_t i = 1; i < std::size(uut.ROB); ++i) {
+          const auto& producer = uut.ROB.at(i - 1);
+          const auto& consumer = uut.ROB.at(i);
+          executed_before_producer = executed_before_producer || (consumer.executed && !producer.completed);
+          waited_after_producer = waited_after_producer || (producer.completed && !consumer.executed);
+        }
+      }
+
+      THEN("Every instruction retires") { REQUIRE(uut.num_retired == chain_length); }
+
+      THEN("No instruction executes before the one it depends on completes") { REQUIRE_FALSE(executed_before_producer); }
+
+      THEN("Each instruction executes in the cycle the one it depends on completes") { REQUIRE_FALSE(waited_after_producer); }
+    }
+  }
+}
+
+SCENARIO("Instructions that wait on the same register are all woken")
+{
+  GIVEN("A ROB with one producer and several consumers")
+  {
+    constexpr long execute_width = 4;
+
+    do_nothing_MRC mock_L1I, mock_L1D;
+    O3_CPU uut{champsim::core_builder{}
+                   .schedule_width(champsim::bandwidth::maximum_type{128})
+                   .register_file_size(128)
+                   .execute_width(champsim::bandwidth::maximum_type{execute_width})
+                   .retire_width(champsim::bandwidth::maximum_type{execute_width})
+                   .fetch_queues(&mock_L1I.queues)
+                   .data_queues(&mock_L1D.queues)};
+
+    auto& producer = uut.ROB.emplace_back(champsim::test::instruction_with_ip(0x1000));
+    producer.instr_id = 1;
+    producer.destination_registers.push_back(7);
+    for (uint64_t i = 0; i < execute_width; ++i) {
+      auto& consumer = uut.ROB.emplace_back(champsim::test::instruction_with_ip(0x1004 + 4 * i));
+      consumer.instr_id = i + 2;
+      consumer.source_registers.push_back(7);
+    }
+    for (auto& instr : uut.ROB)
+      instr.ready_time = champsim::chrono::clock::time_point{};
+
+    WHEN("The producer completes")
+    {
+      for (int cycle = 0; cycle < 100 && !uut.ROB.front().completed; ++cycle) {
+        for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+          op->_operate();
+      }
+
+      THEN("All of the consumers execute together")
+      {
+        REQUIRE(uut.ROB.front().completed);
+        REQUIRE(std::all_of(std::next(std::begin(uut.ROB)), std::end(uut.ROB), [](const auto& x) { return x.executed; }));
+      }
+    }
+  }
+}
+
+TEST_CASE("Scheduler benchmarks")
+{
+  BENCHMARK_ADVANCED("ooo_cpu::operate() with a full ROB behind a stalled load")(Catch::Benchmark::Chronometer meter)
+  {
+    constexpr std::size_t rob_size = 512;
+
+    do_nothing_MRC mock_L1I, mock_L1D;
+    O3_CPU uut{champsim::core_builder{}
+                   .rob_size(rob_size)
+                   .schedule_width(champsim::bandwidth::maximum_type{128})
+                   .register_file_size(128)
+                   .execute_width(champsim::bandwidth::maximum_type{4})
+                   .retire_width(champsim::bandwidth::maximum_type{4})
+                   .fetch_queues(&mock_L1I.queues)
+                   .data_queues(&mock_L1D.queues)};
+
+    // The load at the head of the ROB never receives its data, so nothing retires
+    uut.ROB.push_back(champsim::test::instruction_with_ip_and_source_memory(champsim::address{0x1000}, champsim::address{0xdeadbeef}));
+    for (uint64_t i = 1; i < rob_size; ++i) {
+      uut.ROB.push_back(champsim::test::instruction_with_ip(0x1000 + 4 * i));
+    }
+    uint64_t id = 1;
+    for (auto& instr : uut.ROB) {
+      instr.instr_id = id++;
+      instr.ready_time = champsim::chrono::clock::time_point{};
+    }
+    for (int cycle = 0; cycle < 1000; ++cycle) {
+      for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+        op->_operate();
+    }
+
+    meter.measure([&] {
+      for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+        op->_operate();
+    });
+  };
+  SUCCEED();
+}
@@ -0,0 +1,103 @@
+#include <catch.hpp>
+
+#include "instr.h"
+#include "mocks.hpp"
+#include "ooo_cpu.h"
+
+namespace
+{
+// Run the core until its ROB drains, and return the cycle in which each instruction executed
+std::vector<long> execution_cycles(O3_CPU& uut, std::array<champsim::operable*, 3> elements)
+{
+  std::vector<long> cycles(std::size(uut.ROB), -1);
+  for (long cycle = 0; cycle < 1000 && !std::empty(uut.ROB); ++cycle) {
+    for (auto op : elements)
+      op->_operate();
+
+    for (std::size_t i = 0; i < std::size(uut.ROB); ++i) {
+      auto idx = static_cast<std::size_t>(uut.num_retired) + i;
+      if (uut.ROB.at(i).executed && cycles.at(idx) < 0) {
+        cycles.at(idx) = cycle;
+      }
+    }
+  }
+  return cycles;
+}
+} // namespace
+
+SCENARIO("Each class of instruction executes on its own functional units")
+{
+  GIVEN("A wide core with two pipelined FP units and independent FP instructions")
+  {
+    do_nothing_MRC mock_L1I, mock_L1D;
+    O3_CPU uut{champsim::core_builder{}
+                   .schedule_width(champsim::bandwidth::maximum_type{128})
+                   .register_file_size(128)
+                   .execute_width(champsim::bandwidth::maximum_type{4})
+                   .retire_width(champsim::bandwidth::maximum_type{4})
+                   .execute_latency(1)
+                   .execute_latency(champsim::op_class::fp, 4)
+                   .functional_units(champsim::op_class::fp, 2)
+                   .fetch_queues(&mock_L1I.queues)
+                   .data_queues(&mock_L1D.queues)};
+    uut.warmup = false;
+
+    for (uint64_t i = 0; i < 4; ++i) {
+      auto& instr = uut.ROB.emplace_back(champsim::test::instruction_with_ip(0x1000 + 4 * i));
+      instr.instr_id = i + 1;
+      instr.op_class = champsim::op_class::fp;
+    }
+
+    WHEN("The core runs")
+    {
+      auto cycles = execution_cycles(uut, {{&uut, &mock_L1I, &mock_L1D}});
+
+      THEN("Two instructions begin each cycle")
+      {
+        REQUIRE(cycles.at(0) == cycles.at(1));
+        REQUIRE(cycles.at(2) == cycles.at(0) + 1);
+        REQUIRE(cycles.at(3) == cycles.at(2));
+      }
+
+      THEN("Every instruction retires") { REQUIRE(uut.num_retired == 4); }
+    }
+  }
+
+  GIVEN("A core with one unpipelined divider and independent slow ALU instructions")
+  {
+    constexpr unsigned divide_latency = 5;
+
+    do_nothing_MRC mock_L1I, mock_L1D;
+    O3_CPU uut{champsim::core_builder{}
+                   .schedule_width(champsim::bandwidth::maximum_type{128})
+                   .register_file_size(128)
+                   .execute_width(champsim::bandwidth::maximum_type{4})
+                   .retire_width(champsim::bandwidth::maximum_type{4})
+                   .execute_latency(champsim::op_class::slow_alu, divide_latency)
+                   .functional_units(champsim::op_class::slow_alu, 1, false)
+                   .fetch_queues(&mock_L1I.queues)
+                   .data_queues(&mock_L1D.queues)};
+    uut.warmup = false;
+
+    for (uint64_t i = 0; i < 3; ++i) {
+      auto& instr = uut.ROB.emplace_back(champsim::test::instruction_with_ip(0x1000 + 4 * i));
+      instr.instr_id = i + 1;
+      instr.op_class = champsim::op_class::slow_alu;
+    }
+    auto& alu = uut.ROB.emplace_back(champsim::test::instruction_with_ip(0x100c));
+    alu.instr_id = 4;
+
+    WHEN("The core runs")
+    {
+      auto cycles = execution_cycles(uut, {{&uut, &mock_L1I, &mock_L1D}});
+
+      THEN("Each instruction waits for the divider to finish the one before it")
+      {
+        REQUIRE(cycles.at(1) == cycles.at(0) + divide_latency);
+        REQUIRE(cycles.at(2) == cycles.at(1) + divide_latency);
+      }
+
+      THEN("Instructions of other classes are not held back") { REQUIRE(cycles.at(3) == cycles.at(0)); }
+    }
+  }
+}
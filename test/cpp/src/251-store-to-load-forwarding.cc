@@ -0,0 +1,62 @@
+#include <catch.hpp>
+
+#include "instr.h"
+#include "mocks.hpp"
+#include "ooo_cpu.h"
+
+SCENARIO("A load to the address of an earlier store is forwarded from the store queue")
+{
+  GIVEN("A DISPATCH_BUFFER with a store and a later load to the same address")
+  {
+    constexpr std::size_t lq_size = 4;
+    do_nothing_MRC mock_L1I, mock_L1D;
+    O3_CPU uut{champsim::core_builder{}
+                   .fetch_queues(&mock_L1I.queues)
+                   .data_queues(&mock_L1D.queues)
+                   .dispatch_width(champsim::bandwidth::maximum_type{2})
+                   .rob_size(2)
+                   .lq_size(lq_size)};
+
+    auto store = champsim::test::instruction_with_ip(champsim::address{2000});
+    store.destination_memory.push_back(champsim::address{0xcafe0000});
+    store.instr_id = 1;
+    auto load = champsim::test::instruction_with_ip_and_source_memory(champsim::address{2004}, champsim::address{0xcafe0000});
+    load.instr_id = 2;
+
+    uut.DISPATCH_BUFFER.push_back(store);
+    uut.DISPATCH_BUFFER.push_back(load);
+    for (auto& instr : uut.DISPATCH_BUFFER)
+      instr.ready_time = champsim::chrono::clock::time_point{};
+
+    WHEN("The instructions are promoted to the ROB")
+    {
+      for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+        op->_operate();
+
+      THEN("The load takes the first slot of the load queue and waits on the store")
+      {
+        REQUIRE(uut.LQ.at(0).has_value());
+        REQUIRE(uut.LQ.at(0)->producer_id == store.instr_id);
+        REQUIRE(std::size(uut.lq_free_slots) == lq_size - 1);
+      }
+
+      AND_WHEN("Both instructions are retired")
+      {
+        for (int i = 0; i < 10000 && uut.num_retired < 2; ++i) {
+          for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+            op->_operate();
+        }
+
+        THEN("Only the store reaches the L1D, and the load queue is empty")
+        {
+          REQUIRE(uut.num_retired == 2);
+          REQUIRE(mock_L1D.packet_count() == 1);
+          REQUIRE(std::none_of(std::begin(uut.LQ), std::end(uut.LQ), [](const auto& x) { return x.has_value(); }));
+          REQUIRE(std::size(uut.lq_free_slots) == lq_size);
+          REQUIRE(std::empty(uut.lq_slots_by_instr_id));
+          REQUIRE(std::empty(uut.sq_stores_by_address));
+        }
+      }
+    }
+  }
+}
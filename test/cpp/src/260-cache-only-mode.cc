@@ -0,0 +1,91 @@
+#include <catch.hpp>
+
+#include "instr.h"
+#include "mocks.hpp"
+#include "ooo_cpu.h"
+
+SCENARIO("In cache-only mode, the core issues memory accesses directly from the input queue")
+{
+  GIVEN("A core in cache-only mode with a load and a store in its input queue")
+  {
+    do_nothing_MRC mock_L1I, mock_L1D{100};
+    O3_CPU uut{champsim::core_builder{}
+                   .fetch_queues(&mock_L1I.queues)
+                   .data_queues(&mock_L1D.queues)
+                   .fetch_width(champsim::bandwidth::maximum_type{2})
+                   .lq_size(1)};
+    uut.cache_only = true;
+
+    auto load = champsim::test::instruction_with_ip_and_source_memory(champsim::address{0x1000}, champsim::address{0xcafe0000});
+    load.instr_id = 1;
+    auto store = champsim::test::instruction_with_ip(champsim::address{0x1004});
+    store.destination_memory.push_back(champsim::address{0xbeef0000});
+    store.instr_id = 2;
+    uut.input_queue.push_back(load);
+    uut.input_queue.push_back(store);
+
+    WHEN("The core operates for a cycle")
+    {
+      for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+        op->_operate();
+
+      THEN("Both instructions are retired")
+      {
+        REQUIRE(uut.num_retired == 2);
+        REQUIRE(std::empty(uut.input_queue));
+      }
+
+      THEN("The fetch block is issued once, and the load and store are issued")
+      {
+        REQUIRE(mock_L1I.packet_count() == 1);
+        REQUIRE(mock_L1D.packet_count() == 2);
+        REQUIRE(std::size(uut.cache_only_outstanding_loads) == 1);
+      }
+    }
+  }
+
+  GIVEN("A core in cache-only mode with two loads and room for one outstanding load")
+  {
+    do_nothing_MRC mock_L1I, mock_L1D{100};
+    O3_CPU uut{champsim::core_builder{}
+                   .fetch_queues(&mock_L1I.queues)
+                   .data_queues(&mock_L1D.queues)
+                   .fetch_width(champsim::bandwidth::maximum_type{2})
+                   .lq_size(1)};
+    uut.cache_only = true;
+
+    for (uint64_t i = 0; i < 2; ++i) {
+      auto load = champsim::test::instruction_with_ip_and_source_memory(champsim::address{0x1000 + 4 * i}, champsim::address{0xcafe0000 + 0x1000 * i});
+      load.instr_id = i;
+      uut.input_queue.push_back(load);
+    }
+
+    WHEN("The core operates for a cycle")
+    {
+      for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+        op->_operate();
+
+      THEN("Only the first load is issued")
+      {
+        REQUIRE(uut.num_retired == 1);
+        REQUIRE(mock_L1D.packet_count() == 1);
+      }
+
+      THEN("The core waits for the load to return") { REQUIRE(uut.next_event() == champsim::chrono::clock::time_point::max()); }
+
+      AND_WHEN("The first load returns")
+      {
+        for (int i = 0; i < 200 && uut.num_retired < 2; ++i) {
+          for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+            op->_operate();
+        }
+
+        THEN("The second load is issued")
+        {
+          REQUIRE(uut.num_retired == 2);
+          REQUIRE(mock_L1D.packet_count() == 2);
+        }
+      }
+    }
+  }
+}
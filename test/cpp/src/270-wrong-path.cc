@@ -0,0 +1,181 @@
+#include <catch.hpp>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "instr.h"
+#include "mocks.hpp"
+#include "ooo_cpu.h"
+
+SCENARIO("In wrong-path mode, the core executes down the wrong path until a misprediction resolves")
+{
+  GIVEN("A core that has learned the code after a branch, and a branch that waits on a load")
+  {
+    do_nothing_MRC mock_L1I, mock_L1D{100}, mock_ll;
+    CACHE l1i{champsim::cache_builder{champsim::defaults::default_l1i}.name("270-l1i").lower_level(&mock_ll.queues)};
+    O3_CPU uut{champsim::core_builder{}
+                   .fetch_queues(&mock_L1I.queues)
+                   .data_queues(&mock_L1D.queues)
+                   .l1i(&l1i)
+                   .fetch_width(champsim::bandwidth::maximum_type{4})
+                   .decode_width(champsim::bandwidth::maximum_type{4})
+                   .dispatch_width(champsim::bandwidth::maximum_type{4})
+                   .schedule_width(champsim::bandwidth::maximum_type{8})
+                   .execute_width(champsim::bandwidth::maximum_type{4})
+                   .lq_width(champsim::bandwidth::maximum_type{2})
+                   .retire_width(champsim::bandwidth::maximum_type{4})
+                   .ifetch_buffer_size(8)
+                   .decode_buffer_size(8)
+                   .dispatch_buffer_size(8)
+                   .rob_size(8)
+                   .lq_size(4)
+                   .sq_size(4)
+                   .register_file_size(64)};
+    uut.wrong_path = true;
+    uut.warmup = false;
+
+    // The code at the fall-through of the branch
+    uut.learn_code_image(champsim::test::instruction_with_ip(0x1000));
+    uut.learn_code_image(champsim::test::instruction_with_ip_and_source_memory(champsim::address{0x1004}, champsim::address{0xcafe0000}));
+    uut.learn_code_image(champsim::test::instruction_with_ip(0x1008));
+    uut.code_image_last_ip.reset();
+
+    auto load = champsim::test::instruction_with_ip_and_source_memory(champsim::address{0x0ff0}, champsim::address{0xbeef0000});
+    load.destination_registers.push_back(42);
+    load.instr_id = 1;
+
+    // A conditional branch that is taken, but predicted not taken
+    auto branch = champsim::test::branch_instruction_with_ip(0x1000);
+    branch.branch = BRANCH_CONDITIONAL;
+    branch.branch_target = champsim::address{0x3000};
+    branch.source_registers.push_back(42);
+    branch.instr_id = 2;
+
+    uut.input_queue.push_back(load);
+    uut.input_queue.push_back(branch);
+
+    std::array<champsim::operable*, 3> elements = {&uut, &mock_L1I, &mock_L1D};
+
+    WHEN("The core operates while the branch waits")
+    {
+      for (int i = 0; i < 50; ++i) {
+        for (auto x : elements)
+          x->_operate();
+      }
+
+      THEN("The wrong path is fetched as far as the code is known")
+      {
+        REQUIRE(uut.sim_stats.wrong_path_instrs == 2);
+      }
+
+      THEN("The wrong-path instructions enter the ROB and issue their load")
+      {
+        REQUIRE(std::size(uut.ROB) == 4);
+        REQUIRE(mock_L1D.packet_count() == 2);
+      }
+
+      AND_WHEN("The branch resolves")
+      {
+        for (int i = 0; i < 200 && uut.num_retired < 2; ++i) {
+          for (auto x : elements)
+            x->_operate();
+        }
+        for (auto x : elements)
+          x->_operate();
+
+        THEN("The wrong path is squashed, and only the correct path retires")
+        {
+          REQUIRE(uut.num_retired == 2);
+          REQUIRE(std::empty(uut.ROB));
+          REQUIRE(std::size(uut.lq_free_slots) == std::size(uut.LQ));
+          REQUIRE(uut.scheduled_unexecuted == 0);
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("In wrong-path mode, squashing several stores to one address leaves the store queue consistent")
+{
+  GIVEN("A core that has learned two stores to the same address after a branch, and an older store to that address")
+  {
+    do_nothing_MRC mock_L1I, mock_L1D{100}, mock_ll;
+    CACHE l1i{champsim::cache_builder{champsim::defaults::default_l1i}.name("270-l1i").lower_level(&mock_ll.queues)};
+    O3_CPU uut{champsim::core_builder{}
+                   .fetch_queues(&mock_L1I.queues)
+                   .data_queues(&mock_L1D.queues)
+                   .l1i(&l1i)
+                   .fetch_width(champsim::bandwidth::maximum_type{4})
+                   .decode_width(champsim::bandwidth::maximum_type{4})
+                   .dispatch_width(champsim::bandwidth::maximum_type{4})
+                   .schedule_width(champsim::bandwidth::maximum_type{8})
+                   .execute_width(champsim::bandwidth::maximum_type{4})
+                   .lq_width(champsim::bandwidth::maximum_type{2})
+                   .sq_width(champsim::bandwidth::maximum_type{2})
+                   .retire_width(champsim::bandwidth::maximum_type{4})
+                   .ifetch_buffer_size(8)
+                   .decode_buffer_size(8)
+                   .dispatch_buffer_size(8)
+                   .rob_size(8)
+                   .lq_size(4)
+                   .sq_size(4)
+                   .register_file_size(64)};
+    uut.wrong_path = true;
+    uut.warmup = false;
+
+    const champsim::address stored_address{0xcafe0000};
+
+    // The code at the fall-through of the branch
+    uut.learn_code_image(champsim::test::instruction_with_ip(0x1000));
+    auto wrong_path_store = champsim::test::instruction_with_ip(0x1004);
+    wrong_path_store.destination_memory.push_back(stored_address);
+    uut.learn_code_image(wrong_path_store);
+    wrong_path_store.ip = champsim::address{0x1008};
+    uut.learn_code_image(wrong_path_store);
+    uut.code_image_last_ip.reset();
+
+    auto store = champsim::test::instruction_with_ip(0x0fe0);
+    store.destination_memory.push_back(stored_address);
+    store.instr_id = 1;
+
+    auto load = champsim::test::instruction_with_ip_and_source_memory(champsim::address{0x0ff0}, champsim::address{0xbeef0000});
+    load.destination_registers.push_back(42);
+    load.instr_id = 2;
+
+    // A conditional branch that is taken, but predicted not taken
+    auto branch = champsim::test::branch_instruction_with_ip(0x1000);
+    branch.branch = BRANCH_CONDITIONAL;
+    branch.branch_target = champsim::address{0x3000};
+    branch.source_registers.push_back(42);
+    branch.instr_id = 3;
+
+    uut.input_queue.push_back(store);
+    uut.input_queue.push_back(load);
+    uut.input_queue.push_back(branch);
+
+    std::array<champsim::operable*, 3> elements = {&uut, &mock_L1I, &mock_L1D};
+
+    WHEN("The branch resolves after the wrong-path stores enter the store queue")
+    {
+      for (int i = 0; i < 50; ++i) {
+        for (auto x : elements)
+          x->_operate();
+      }
+      REQUIRE(uut.sim_stats.wrong_path_instrs == 2);
+
+      for (int i = 0; i < 200 && uut.num_retired < 3; ++i) {
+        for (auto x : elements)
+          x->_operate();
+      }
+      for (auto x : elements)
+        x->_operate();
+
+      THEN("The wrong-path stores are squashed, and only the correct path retires")
+      {
+        REQUIRE(uut.num_retired == 3);
+        REQUIRE(std::empty(uut.ROB));
+        REQUIRE(std::empty(uut.SQ));
+        REQUIRE(std::empty(uut.sq_stores_by_address));
+      }
+    }
+  }
+}
@@ -116,3 +116,50 @@ SCENARIO("A cache merges two requests in the MSHR")
     }
   }
 }
+
+TEST_CASE("MSHR benchmarks")
+{
+  BENCHMARK_ADVANCED("CACHE::operate() with a full MSHR of 256 entries")(Catch::Benchmark::Chronometer meter)
+  {
+    constexpr std::size_t num_mshrs = 256;
+    constexpr uint64_t num_blocks = 4 * num_mshrs;
+
+    do_nothing_MRC mock_ll{1000};
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l1d}
+                  .name("406-bench")
+                  .sets(1)
+                  .ways(1)
+                  .mshr_size(num_mshrs)
+                  .upper_levels({{&mock_ul.queues}})
+                  .lower_level(&mock_ll.queues)};
+
+    std::array<champsim::operable*, 3> elements{{&mock_ll, &uut, &mock_ul}};
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    // Requests cycle through more blocks than the MSHR can hold, so each one either merges or waits for an entry
+    uint64_t id = 1;
+    auto issue_and_operate = [&] {
+      for (int i = 0; i < 4; ++i) {
+        decltype(mock_ul)::request_type req;
+        req.address = champsim::address{0x10000000 + 64 * (id % num_blocks)};
+        req.cpu = 0;
+        req.type = access_type::LOAD;
+        req.instr_id = id++;
+        mock_ul.issue(req);
+      }
+      for (auto elem : elements)
+        elem->_operate();
+    };
+
+    for (int cycle = 0; cycle < 2000; ++cycle)
+      issue_and_operate();
+
+    meter.measure(issue_and_operate);
+  };
+  SUCCEED();
+}
@@ -0,0 +1,71 @@
+#include <catch.hpp>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+
+SCENARIO("A cache reports when its tag check will finish")
+{
+  GIVEN("An empty cache")
+  {
+    constexpr auto hit_latency = 7;
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l1d}
+                  .name("416-uut")
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)
+                  .hit_latency(hit_latency)};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+
+    // Initialize the prefetching and replacement
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    THEN("The cache has no next event") { REQUIRE(uut.next_event() == champsim::chrono::clock::time_point::max()); }
+
+    WHEN("A packet is issued")
+    {
+      decltype(mock_ul)::request_type test;
+      test.address = champsim::address{0xdeadbeef};
+      test.is_translated = true;
+      test.cpu = 0;
+      test.type = access_type::LOAD;
+
+      auto test_result = mock_ul.issue(test);
+      THEN("This issue is received") { REQUIRE(test_result); }
+
+      THEN("The cache must operate in the next cycle") { REQUIRE(uut.next_event() == uut.current_time + uut.clock_period); }
+
+      AND_WHEN("The cache begins the tag check")
+      {
+        for (auto elem : elements) {
+          elem->_operate();
+        }
+
+        const auto expected_event = uut.current_time + hit_latency * uut.clock_period;
+        THEN("The next event is the end of the tag check") { REQUIRE(uut.next_event() == expected_event); }
+
+        AND_WHEN("The cache skips to the cycle before the event")
+        {
+          champsim::chrono::clock skip_clock;
+          skip_clock.tick((expected_event - uut.clock_period).time_since_epoch());
+          uut.skip_to(skip_clock);
+
+          THEN("The tag check has not finished") { REQUIRE(uut.sim_stats.misses.total() == 0); }
+
+          AND_WHEN("The cache operates once more")
+          {
+            uut._operate();
+
+            THEN("The tag check finishes") { REQUIRE(uut.sim_stats.misses.total() == 1); }
+          }
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,82 @@
+#include <catch.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include "address.h"
+#include "block.h"
+#include "tag_array.h"
+
+TEST_CASE("A tag array finds the ways of a set by tag")
+{
+  constexpr std::size_t num_sets = 4;
+  auto num_ways = GENERATE(as<std::size_t>{}, 1, 3, 16, 32, 70);
+  champsim::tag_array uut{num_sets, num_ways};
+
+  const std::size_t set = 2;
+  const auto last_way = num_ways - 1;
+  uut.assign(set * num_ways + last_way, 0xbeef, true);
+
+  REQUIRE(uut.find_valid(set, 0xbeef) == last_way);
+  REQUIRE(uut.find_valid(set, 0xcafe) == num_ways);
+  REQUIRE(uut.find_valid(set + 1, 0xbeef) == num_ways);
+  REQUIRE(uut.find_invalid(set) == (num_ways == 1 ? num_ways : 0));
+
+  uut.assign(set * num_ways + last_way, 0xbeef, false);
+
+  REQUIRE(uut.find_valid(set, 0xbeef) == num_ways);
+  REQUIRE(uut.find(set, 0xbeef) == last_way);
+  REQUIRE(uut.find_invalid(set) == 0);
+}
+
+TEST_CASE("A tag array finds the first invalid way")
+{
+  constexpr std::size_t num_ways = 70;
+  champsim::tag_array uut{1, num_ways};
+
+  for (std::size_t way = 0; way < num_ways; ++way) {
+    uut.assign(way, way, true);
+  }
+  REQUIRE(uut.find_invalid(0) == num_ways);
+
+  uut.assign(65, 65, false);
+  REQUIRE(uut.find_invalid(0) == 65);
+  REQUIRE(uut.find_valid(0, 66) == 66);
+}
+
+TEST_CASE("Tag array benchmarks")
+{
+  constexpr std::size_t num_sets = 2048;
+  constexpr std::size_t num_ways = 16;
+
+  std::vector<champsim::cache_block> blocks(num_sets * num_ways);
+  champsim::tag_array uut{num_sets, num_ways};
+  for (std::size_t i = 0; i < std::size(blocks); ++i) {
+    blocks[i].valid = true;
+    blocks[i].address = champsim::address{i << 6};
+    uut.assign(i, i, true);
+  }
+
+  // Search for the last way of each set, which is the longest search that hits
+  BENCHMARK("Search 16-way sets with find_if")
+  {
+    std::size_t found = 0;
+    for (std::size_t set = 0; set < num_sets; ++set) {
+      auto begin = std::next(std::cbegin(blocks), static_cast<long>(set * num_ways));
+      auto end = std::next(begin, num_ways);
+      auto match = champsim::address{(set * num_ways + num_ways - 1) << 6}.slice_upper(champsim::data::bits{6});
+      auto is_match = [match](const auto& x) { return x.valid && x.address.slice_upper(champsim::data::bits{6}) == match; };
+      found += static_cast<std::size_t>(std::distance(begin, std::find_if(begin, end, is_match)));
+    }
+    return found;
+  };
+
+  BENCHMARK("Search 16-way sets with a tag array")
+  {
+    std::size_t found = 0;
+    for (std::size_t set = 0; set < num_sets; ++set) {
+      found += uut.find_valid(set, set * num_ways + num_ways - 1);
+    }
+    return found;
+  };
+}
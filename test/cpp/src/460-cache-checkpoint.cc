@@ -0,0 +1,89 @@
+#include <catch.hpp>
+#include <sstream>
+
+#include "cache.h"
+#include "checkpoint.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+#include "modules.h"
+
+namespace
+{
+struct no_checkpoint_replacement : champsim::modules::replacement {
+  using replacement::replacement;
+
+  long find_victim(uint32_t, uint64_t, long, const CACHE::BLOCK*, champsim::address, champsim::address, uint32_t) { return 0; }
+};
+} // namespace
+
+SCENARIO("A cache can be restored from a checkpoint")
+{
+  GIVEN("A cache with some valid blocks")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    auto builder = champsim::cache_builder{champsim::defaults::default_l1d}
+                       .name("460-uut")
+                       .sets(4)
+                       .ways(2)
+                       .upper_levels({&mock_ul.queues})
+                       .lower_level(&mock_ll.queues);
+    CACHE uut{builder};
+    uut.initialize();
+    uut.block.at(1).valid = true;
+    uut.block.at(1).address = champsim::address{0xdeadbeef};
+    uut.block.at(6).valid = true;
+    uut.block.at(6).dirty = true;
+    uut.block.at(6).address = champsim::address{0xcafebabe};
+
+    WHEN("It is saved and restored into a cache of the same configuration")
+    {
+      std::stringstream stream;
+      champsim::checkpoint_writer writer{stream};
+      uut.save_checkpoint(writer);
+
+      CACHE restored{builder};
+      restored.initialize();
+      champsim::checkpoint_reader reader{stream};
+      restored.load_checkpoint(reader);
+
+      THEN("The blocks match")
+      {
+        for (std::size_t i = 0; i < std::size(uut.block); ++i) {
+          CHECK(restored.block.at(i).valid == uut.block.at(i).valid);
+          CHECK(restored.block.at(i).dirty == uut.block.at(i).dirty);
+          CHECK(restored.block.at(i).address == uut.block.at(i).address);
+        }
+      }
+    }
+
+    WHEN("It is restored into a cache with a different number of sets")
+    {
+      std::stringstream stream;
+      champsim::checkpoint_writer writer{stream};
+      uut.save_checkpoint(writer);
+
+      CACHE other{champsim::cache_builder{builder}.sets(8)};
+      other.initialize();
+      champsim::checkpoint_reader reader{stream};
+
+      THEN("The restore fails") { REQUIRE_THROWS_AS(other.load_checkpoint(reader), champsim::checkpoint_error); }
+    }
+  }
+}
+
+SCENARIO("A cache whose replacement policy cannot be checkpointed reports it")
+{
+  GIVEN("A cache with a replacement policy that has no checkpoint members")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l1d}
+                  .name("460-unsupported")
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)
+                  .replacement<no_checkpoint_replacement>()};
+
+    THEN("Checking for support fails") { REQUIRE_THROWS_AS(uut.check_checkpoint_support(), champsim::checkpoint_error); }
+  }
+}
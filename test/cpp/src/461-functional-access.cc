@@ -0,0 +1,88 @@
+#include <catch.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+
+SCENARIO("A cache can be accessed functionally")
+{
+  GIVEN("An empty cache with one block")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}
+                  .name("461-uut")
+                  .sets(1)
+                  .ways(1)
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)};
+
+    uut.initialize();
+    uut.warmup = false;
+    uut.begin_phase();
+
+    std::vector<champsim::channel::request_type> lower_requests;
+    champsim::functional_access lower = [&lower_requests](champsim::channel*, const champsim::channel::request_type& packet) {
+      lower_requests.push_back(packet);
+      return champsim::channel::response_type{packet.address, packet.v_address, packet.data, packet.pf_metadata, packet.instr_depend_on_me};
+    };
+
+    champsim::channel::request_type load;
+    load.address = champsim::address{0xdeadbeef};
+    load.v_address = load.address;
+    load.cpu = 0;
+    load.type = access_type::LOAD;
+
+    WHEN("A load is served")
+    {
+      auto response = uut.functional_access(load, lower);
+
+      THEN("The block is requested from the lower level and filled")
+      {
+        REQUIRE(response.address == load.address);
+        REQUIRE(std::size(lower_requests) == 1);
+        REQUIRE(champsim::block_number{lower_requests.front().address} == champsim::block_number{load.address});
+        REQUIRE(uut.sim_stats.misses.total() == 1);
+        REQUIRE(uut.block.at(0).valid);
+      }
+
+      THEN("No queue or cycle is used") { REQUIRE(std::empty(mock_ul.queues.returned)); }
+
+      AND_WHEN("The same load is served again")
+      {
+        uut.functional_access(load, lower);
+
+        THEN("It hits")
+        {
+          REQUIRE(std::size(lower_requests) == 1);
+          REQUIRE(uut.sim_stats.hits.total() == 1);
+        }
+      }
+    }
+
+    WHEN("A write is followed by a load to a different block")
+    {
+      auto write = load;
+      write.type = access_type::WRITE;
+      write.response_requested = false;
+      uut.functional_access(write, lower);
+
+      auto other_load = load;
+      other_load.address = champsim::address{0xcafebabe};
+      other_load.v_address = other_load.address;
+      uut.functional_access(other_load, lower);
+
+      THEN("The dirty block is written back to the lower level")
+      {
+        auto is_writeback = [](const auto& packet) {
+          return packet.type == access_type::WRITE;
+        };
+        REQUIRE(std::count_if(std::begin(lower_requests), std::end(lower_requests), is_writeback) == 1);
+        REQUIRE(std::empty(mock_ll.queues.WQ));
+      }
+    }
+  }
+}
@@ -180,3 +180,57 @@ SCENARIO("A series of reads arrive at the memory controller and are reordered")
     }
   }
 }
+
+TEST_CASE("DRAM scheduler benchmarks")
+{
+  BENCHMARK_ADVANCED("MEMORY_CONTROLLER::operate() with 256-entry queues")(Catch::Benchmark::Chronometer meter)
+  {
+    constexpr std::size_t queue_size = 256;
+    const auto clock_period = champsim::chrono::picoseconds{3200};
+
+    champsim::channel ul{queue_size, 0, queue_size, champsim::data::bits{LOG2_BLOCK_SIZE}, false};
+    MEMORY_CONTROLLER uut{clock_period,
+                          clock_period * 2,
+                          24,
+                          24,
+                          24,
+                          52,
+                          champsim::chrono::microseconds{64000},
+                          {&ul},
+                          queue_size,
+                          queue_size,
+                          1,
+                          champsim::data::bytes{8},
+                          65536,
+                          1024,
+                          1,
+                          8,
+                          4,
+                          8192};
+    uut.warmup = false;
+    uut.channels[0].warmup = false;
+
+    // Keep the queues full with requests spread over the banks, and one in eight of them writes
+    uint64_t state = 0x2545f4914f6cdd1d;
+    auto issue_and_operate = [&] {
+      for (int i = 0; i < 2; ++i) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        champsim::channel::request_type req;
+        req.address = champsim::address{(state >> 16) << LOG2_BLOCK_SIZE};
+        req.response_requested = false;
+        if ((state >> 61) == 0) {
+          ul.add_wq(req);
+        } else {
+          ul.add_rq(req);
+        }
+      }
+      uut._operate();
+    };
+
+    for (int cycle = 0; cycle < 5000; ++cycle)
+      issue_and_operate();
+
+    meter.measure(issue_and_operate);
+  };
+  SUCCEED();
+}
@@ -0,0 +1,79 @@
+#include <catch.hpp>
+
+#include "dram_controller.h"
+
+namespace
+{
+MEMORY_CONTROLLER make_controller(champsim::channel* ul)
+{
+  const auto clock_period = champsim::chrono::picoseconds{3200};
+  MEMORY_CONTROLLER uut{clock_period, clock_period * 2, 24, 24, 24, 52, champsim::chrono::microseconds{64000}, {ul}, 64, 64, 1, champsim::data::bytes{8},
+                        65536, 1024, 1, 8, 4, 8192};
+  uut.warmup = false;
+  uut.channels[0].warmup = false;
+  return uut;
+}
+} // namespace
+
+SCENARIO("Writes to the same block are merged in the DRAM write queue")
+{
+  GIVEN("A memory controller with one write in its write queue")
+  {
+    champsim::channel ul{32, 32, 32, champsim::data::bits{LOG2_BLOCK_SIZE}, false};
+    auto uut = make_controller(&ul);
+
+    champsim::channel::request_type write;
+    write.address = champsim::address{0xdeadbec0};
+    write.response_requested = false;
+    ul.add_wq(write);
+    uut._operate();
+
+    WHEN("Two more writes to the same block and one to another block arrive")
+    {
+      ul.add_wq(write);
+      ul.add_wq(write);
+      auto other_write = write;
+      other_write.address = champsim::address{0xcafebac0};
+      ul.add_wq(other_write);
+      uut._operate();
+
+      THEN("Only one write to each block remains")
+      {
+        auto occupied = std::count_if(std::begin(uut.channels[0].WQ), std::end(uut.channels[0].WQ), [](const auto& x) { return x.has_value(); });
+        REQUIRE(occupied == 2);
+      }
+    }
+  }
+}
+
+SCENARIO("Reads to a block in the DRAM write queue are returned from the write")
+{
+  GIVEN("A memory controller with one write in its write queue")
+  {
+    champsim::channel ul{32, 32, 32, champsim::data::bits{LOG2_BLOCK_SIZE}, false};
+    auto uut = make_controller(&ul);
+
+    champsim::channel::request_type write;
+    write.address = champsim::address{0xdeadbec0};
+    write.data = champsim::address{0x1234};
+    write.response_requested = false;
+    ul.add_wq(write);
+    uut._operate();
+
+    WHEN("A read to the same block arrives")
+    {
+      champsim::channel::request_type read;
+      read.address = champsim::address{0xdeadbec8};
+      read.response_requested = true;
+      ul.add_rq(read);
+      uut._operate();
+
+      THEN("The read returns the data of the write immediately")
+      {
+        REQUIRE_THAT(ul.returned, Catch::Matchers::SizeIs(1));
+        CHECK(ul.returned.front().data == write.data);
+        CHECK(std::none_of(std::begin(uut.channels[0].RQ), std::end(uut.channels[0].RQ), [](const auto& x) { return x.has_value(); }));
+      }
+    }
+  }
+}
@@ -0,0 +1,198 @@
+#include <catch.hpp>
+
+#include "../../../dram_scheduler/bliss/bliss.h"
+#include "../../../dram_scheduler/fr_fcfs/fr_fcfs.h"
+#include "dram_controller.h"
+
+namespace
+{
+DRAM_CHANNEL make_channel()
+{
+  const auto clock_period = champsim::chrono::picoseconds{3200};
+  DRAM_ADDRESS_MAPPING mapper{champsim::data::bytes{8}, 8, 1, 8, 4, 1024, 1, 65536};
+  return DRAM_CHANNEL{clock_period, clock_period * 2, 24, 24, 24, 52, champsim::chrono::microseconds{64000}, 8192, champsim::data::bytes{8}, 64, 64, mapper};
+}
+
+void add_read(DRAM_CHANNEL& chan, std::size_t slot, champsim::address addr, uint32_t cpu, champsim::chrono::clock::time_point ready_time)
+{
+  champsim::channel::request_type packet;
+  packet.address = addr;
+  packet.cpu = cpu;
+  chan.RQ.at(slot) = DRAM_CHANNEL::request_type{packet};
+  chan.RQ.at(slot)->ready_time = ready_time;
+}
+} // namespace
+
+SCENARIO("The BLISS scheduler deprioritizes a core that has been served several times in a row")
+{
+  GIVEN("A channel with an older read from core 0 and a newer read from core 1 to another bank")
+  {
+    auto chan = make_channel();
+    chan.warmup = false;
+    chan.current_time = champsim::chrono::clock::time_point{} + 10 * chan.clock_period;
+    add_read(chan, 0, champsim::address{0x1000}, 1, champsim::chrono::clock::time_point{} + chan.clock_period);
+    add_read(chan, 1, champsim::address{0x1040}, 0, champsim::chrono::clock::time_point{});
+    chan.check_read_collision();
+    REQUIRE(chan.RQ.at(0)->bank_index != chan.RQ.at(1)->bank_index);
+
+    bliss uut{&chan};
+
+    THEN("The older read is selected")
+    {
+      auto selected = uut.select_request();
+      REQUIRE(selected == std::next(std::begin(chan.RQ), 1));
+    }
+
+    WHEN("Core 0 has had several requests scheduled in a row")
+    {
+      [[maybe_unused]] auto unused = uut.select_request();
+      for (std::size_t i = 0; i < bliss::blacklisting_threshold; ++i) {
+        uut.request_scheduled(chan.RQ.at(1).value());
+      }
+
+      THEN("Core 0 is blacklisted") { REQUIRE(uut.is_blacklisted(0)); }
+
+      THEN("The read from core 1 is selected")
+      {
+        auto selected = uut.select_request();
+        REQUIRE(selected == std::begin(chan.RQ));
+      }
+
+      AND_WHEN("The blacklist is cleared")
+      {
+        chan.current_time += bliss::clearing_interval * chan.clock_period;
+        auto selected = uut.select_request();
+
+        THEN("The older read is selected again")
+        {
+          REQUIRE_FALSE(uut.is_blacklisted(0));
+          REQUIRE(selected == std::next(std::begin(chan.RQ), 1));
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("The FR-FCFS scheduler prefers a read that hits in the open row")
+{
+  GIVEN("A channel with an older read and a newer read to different rows of the same bank")
+  {
+    auto chan = make_channel();
+    chan.warmup = false;
+    chan.current_time = champsim::chrono::clock::time_point{} + 10 * chan.clock_period;
+    add_read(chan, 0, champsim::address{0x1000}, 0, champsim::chrono::clock::time_point{});
+    add_read(chan, 1, champsim::address{0x841000}, 0, champsim::chrono::clock::time_point{} + chan.clock_period);
+    chan.check_read_collision();
+    REQUIRE(chan.RQ.at(0)->bank_index == chan.RQ.at(1)->bank_index);
+    REQUIRE(chan.RQ.at(0)->row != chan.RQ.at(1)->row);
+
+    fr_fcfs uut{&chan};
+
+    THEN("With the bank closed, the older read is selected")
+    {
+      auto selected = uut.select_request();
+      REQUIRE(selected == std::begin(chan.RQ));
+    }
+
+    WHEN("The row of the newer read is open")
+    {
+      chan.bank_request.at(chan.RQ.at(1)->bank_index).open_row = chan.RQ.at(1)->row;
+
+      THEN("The newer read is selected")
+      {
+        auto selected = uut.select_request();
+        REQUIRE(selected == std::next(std::begin(chan.RQ), 1));
+      }
+    }
+
+    WHEN("The row of the newer read is open, but the newer read is not yet ready")
+    {
+      chan.bank_request.at(chan.RQ.at(1)->bank_index).open_row = chan.RQ.at(1)->row;
+      chan.current_time = champsim::chrono::clock::time_point{};
+
+      THEN("The older read is selected")
+      {
+        auto selected = uut.select_request();
+        REQUIRE(selected == std::begin(chan.RQ));
+      }
+    }
+
+    WHEN("The row of the newer read is open and the newer read is scheduled")
+    {
+      chan.bank_request.at(chan.RQ.at(1)->bank_index).open_row = chan.RQ.at(1)->row;
+      chan.service_packet(uut.select_request());
+      chan.bank_request.at(chan.RQ.at(0)->bank_index).valid = false;
+
+      THEN("The bank has no more row hits, and the older read is selected")
+      {
+        REQUIRE_FALSE(chan.oldest_ready_row_hit(chan.RQ.at(0)->bank_index).has_value());
+        auto selected = uut.select_request();
+        REQUIRE(selected == std::begin(chan.RQ));
+      }
+    }
+
+    WHEN("The bank is busy")
+    {
+      chan.bank_request.at(chan.RQ.at(0)->bank_index).valid = true;
+
+      THEN("No read is selected")
+      {
+        auto selected = uut.select_request();
+        REQUIRE(selected == std::end(chan.RQ));
+      }
+    }
+  }
+}
+
+SCENARIO("A memory controller can be given a scheduler module")
+{
+  GIVEN("A memory controller that schedules with BLISS")
+  {
+    champsim::channel ul{32, 32, 32, champsim::data::bits{LOG2_BLOCK_SIZE}, false};
+    const auto clock_period = champsim::chrono::picoseconds{3200};
+    MEMORY_CONTROLLER uut{clock_period,
+                          clock_period * 2,
+                          24,
+                          24,
+                          24,
+                          52,
+                          champsim::chrono::microseconds{64000},
+                          {&ul},
+                          64,
+                          64,
+                          1,
+                          champsim::data::bytes{8},
+                          65536,
+                          1024,
+                          1,
+                          8,
+                          4,
+                          8192,
+                          dram_power_parameters{},
+                          dram_page_policy{},
+                          dram_address_layout{},
+                          dram_node{},
+                          dram_refresh_policy{},
+                          champsim::dram_scheduler_module_type_holder<bliss>{}};
+    uut.warmup = false;
+    uut.channels[0].warmup = false;
+
+    WHEN("Reads from several cores arrive")
+    {
+      constexpr uint32_t num_reads = 16;
+      for (uint32_t i = 0; i < num_reads; ++i) {
+        champsim::channel::request_type read;
+        read.address = champsim::address{0x10000 + 0x40 * i};
+        read.cpu = i % 4;
+        read.response_requested = true;
+        ul.add_rq(read);
+      }
+
+      for (int cycle = 0; cycle < 10000 && std::size(ul.returned) < num_reads; ++cycle) {
+        uut._operate();
+      }
+
+      THEN("Every read is returned") { REQUIRE_THAT(ul.returned, Catch::Matchers::SizeIs(num_reads)); }
+    }
+  }
+}
@@ -0,0 +1,78 @@
+#include <catch.hpp>
+
+#include "dram_controller.h"
+
+SCENARIO("The memory controller counts the commands it issues and the energy they use")
+{
+  GIVEN("A memory controller in the simulation phase")
+  {
+    champsim::channel ul{32, 32, 32, champsim::data::bits{LOG2_BLOCK_SIZE}, false};
+    const auto clock_period = champsim::chrono::picoseconds{3200};
+    MEMORY_CONTROLLER uut{clock_period,
+                          clock_period * 2,
+                          24,
+                          24,
+                          24,
+                          52,
+                          champsim::chrono::microseconds{64000},
+                          {&ul},
+                          64,
+                          64,
+                          1,
+                          champsim::data::bytes{8},
+                          65536,
+                          1024,
+                          1,
+                          8,
+                          4,
+                          8192};
+    uut.warmup = false;
+    uut.begin_phase();
+    const auto start_time = uut.current_time;
+
+    WHEN("Reads to several rows arrive")
+    {
+      constexpr uint32_t num_reads = 16;
+      for (uint32_t i = 0; i < num_reads; ++i) {
+        champsim::channel::request_type read;
+        read.address = champsim::address{0x100000 * (i % 4) + 0x40 * i};
+        read.response_requested = true;
+        ul.add_rq(read);
+      }
+
+      for (int cycle = 0; cycle < 10000 && std::size(ul.returned) < num_reads; ++cycle) {
+        uut._operate();
+      }
+      uut.end_phase(0);
+
+      const auto& chan = uut.channels[0];
+      const auto& stats = chan.roi_stats;
+
+      THEN("Every read is returned") { REQUIRE_THAT(ul.returned, Catch::Matchers::SizeIs(num_reads)); }
+
+      THEN("A read command is counted for each read")
+      {
+        REQUIRE(stats.RD == num_reads);
+        REQUIRE(stats.WR == 0);
+        REQUIRE(stats.read_energy == Approx(num_reads * chan.command_energy.read));
+      }
+
+      THEN("An activate is counted for each row buffer miss")
+      {
+        REQUIRE(stats.ACT > 0);
+        REQUIRE(stats.ACT == stats.RQ_ROW_BUFFER_MISS);
+        REQUIRE(stats.PRE < stats.ACT);
+        REQUIRE(stats.activate_energy == Approx(static_cast<double>(stats.ACT) * chan.command_energy.activate));
+      }
+
+      THEN("The rank spends the whole phase in one of the standby states")
+      {
+        REQUIRE_THAT(stats.active_standby_time, Catch::Matchers::SizeIs(1));
+        REQUIRE_THAT(stats.precharge_standby_time, Catch::Matchers::SizeIs(1));
+        REQUIRE(stats.active_standby_time.at(0) > champsim::chrono::picoseconds{});
+        REQUIRE(stats.active_standby_time.at(0) + stats.precharge_standby_time.at(0) == uut.current_time - start_time);
+        REQUIRE(stats.total_energy() > stats.activate_energy + stats.read_energy);
+      }
+    }
+  }
+}
@@ -0,0 +1,148 @@
+#include <catch.hpp>
+
+#include "dram_controller.h"
+
+namespace
+{
+// Send two reads to the same row, the second long after the first has returned, and count how many hit in the row buffer
+uint64_t row_buffer_hits(dram_page_policy policy)
+{
+  champsim::channel ul{32, 32, 32, champsim::data::bits{LOG2_BLOCK_SIZE}, false};
+  const auto clock_period = champsim::chrono::picoseconds{3200};
+  MEMORY_CONTROLLER uut{clock_period,
+                        clock_period * 2,
+                        24,
+                        24,
+                        24,
+                        52,
+                        champsim::chrono::microseconds{64000},
+                        {&ul},
+                        64,
+                        64,
+                        1,
+                        champsim::data::bytes{8},
+                        65536,
+                        1024,
+                        1,
+                        8,
+                        4,
+                        8192,
+                        dram_power_parameters{},
+                        policy};
+  uut.warmup = false;
+  uut.begin_phase();
+
+  // The two addresses differ only in their column
+  for (auto addr : {champsim::address{0x10000}, champsim::address{0x10800}}) {
+    champsim::channel::request_type read;
+    read.address = addr;
+    read.response_requested = true;
+    ul.add_rq(read);
+
+    for (int cycle = 0; cycle < 1000; ++cycle) {
+      uut._operate();
+    }
+  }
+
+  REQUIRE_THAT(ul.returned, Catch::Matchers::SizeIs(2));
+  return uut.channels[0].sim_stats.RQ_ROW_BUFFER_HIT;
+}
+} // namespace
+
+TEST_CASE("An open page policy leaves the row open for later accesses") { REQUIRE(row_buffer_hits(dram_page_policy{}) == 1); }
+
+TEST_CASE("A close page policy precharges the row after each access")
+{
+  REQUIRE(row_buffer_hits(dram_page_policy{dram_page_policy::mode::close, 0}) == 0);
+}
+
+TEST_CASE("An adaptive page policy precharges the row once the bank has been idle for the timeout")
+{
+  REQUIRE(row_buffer_hits(dram_page_policy{dram_page_policy::mode::adaptive, 10000}) == 1);
+  REQUIRE(row_buffer_hits(dram_page_policy{dram_page_policy::mode::adaptive, 10}) == 0);
+}
+
+SCENARIO("A row closed by the page policy delays the next activate by the precharge time")
+{
+  GIVEN("A channel with a close page policy and an idle bank with an open row")
+  {
+    const auto clock_period = champsim::chrono::picoseconds{3200};
+    DRAM_ADDRESS_MAPPING mapper{champsim::data::bytes{8}, 8, 1, 8, 4, 1024, 1, 65536};
+    DRAM_CHANNEL uut{clock_period, clock_period * 2, 24, 24, 24, 52, champsim::chrono::microseconds{64000}, 8192, champsim::data::bytes{8}, 64, 64, mapper,
+                     dram_power_parameters{}, dram_page_policy{dram_page_policy::mode::close, 0}};
+    uut.warmup = false;
+    uut.current_time = champsim::chrono::clock::time_point{} + 10 * uut.clock_period;
+
+    champsim::channel::request_type packet;
+    packet.address = champsim::address{0x10000};
+    uut.RQ.at(0) = DRAM_CHANNEL::request_type{packet};
+    uut.RQ.at(0)->ready_time = uut.current_time;
+    uut.check_read_collision();
+
+    auto& bank = uut.bank_request.at(uut.RQ.at(0)->bank_index);
+    bank.open_row = uut.RQ.at(0)->row + 1;
+    bank.close_time = uut.current_time;
+
+    WHEN("The row is closed and a read to another row is scheduled in the same cycle")
+    {
+      uut.close_idle_rows();
+      REQUIRE_FALSE(bank.open_row.has_value());
+      uut.service_packet(std::begin(uut.RQ));
+
+      THEN("The read waits for the precharge, the activate, and the column access")
+      {
+        REQUIRE(bank.valid);
+        REQUIRE(bank.ready_time == uut.current_time + uut.tRP + uut.tRCD + uut.tCAS);
+      }
+    }
+
+    WHEN("The row is closed and a read to another row is scheduled once the precharge has completed")
+    {
+      uut.close_idle_rows();
+      uut.current_time += uut.tRP;
+      uut.service_packet(std::begin(uut.RQ));
+
+      THEN("The read waits for the activate and the column access")
+      {
+        REQUIRE(bank.valid);
+        REQUIRE(bank.ready_time == uut.current_time + uut.tRCD + uut.tCAS);
+      }
+    }
+  }
+}
+
+SCENARIO("Under an open page policy, a bank descheduled with a closed row activates without a precharge delay")
+{
+  GIVEN("A channel with an open page policy and a bank whose request was descheduled by a write mode swap")
+  {
+    const auto clock_period = champsim::chrono::picoseconds{3200};
+    DRAM_ADDRESS_MAPPING mapper{champsim::data::bytes{8}, 8, 1, 8, 4, 1024, 1, 65536};
+    DRAM_CHANNEL uut{clock_period, clock_period * 2, 24, 24, 24, 52, champsim::chrono::microseconds{64000}, 8192, champsim::data::bytes{8}, 64, 64, mapper,
+                     dram_power_parameters{}, dram_page_policy{}};
+    uut.warmup = false;
+    uut.current_time = champsim::chrono::clock::time_point{} + 10 * uut.clock_period;
+
+    champsim::channel::request_type packet;
+    packet.address = champsim::address{0x10000};
+    uut.RQ.at(0) = DRAM_CHANNEL::request_type{packet};
+    uut.RQ.at(0)->ready_time = uut.current_time;
+    uut.check_read_collision();
+
+    // A swap leaves the descheduled request's ready time in the bank and resets its row
+    auto& bank = uut.bank_request.at(uut.RQ.at(0)->bank_index);
+    bank.open_row.reset();
+    bank.ready_time = uut.current_time + 100 * uut.clock_period;
+
+    WHEN("A read is scheduled to the bank")
+    {
+      uut.close_idle_rows();
+      uut.service_packet(std::begin(uut.RQ));
+
+      THEN("The read waits only for the activate and the column access")
+      {
+        REQUIRE(bank.valid);
+        REQUIRE(bank.ready_time == uut.current_time + uut.tRCD + uut.tCAS);
+      }
+    }
+  }
+}
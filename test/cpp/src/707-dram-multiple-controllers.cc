@@ -0,0 +1,117 @@
+#include <catch.hpp>
+
+#include "dram_controller.h"
+
+namespace
+{
+MEMORY_CONTROLLER make_controller(champsim::channel* ul, dram_node node)
+{
+  const auto clock_period = champsim::chrono::picoseconds{3200};
+  MEMORY_CONTROLLER uut{clock_period,
+                        clock_period * 2,
+                        24,
+                        24,
+                        24,
+                        52,
+                        champsim::chrono::microseconds{64000},
+                        {ul},
+                        64,
+                        64,
+                        1,
+                        champsim::data::bytes{8},
+                        65536,
+                        1024,
+                        1,
+                        8,
+                        4,
+                        8192,
+                        dram_power_parameters{},
+                        dram_page_policy{},
+                        dram_address_layout{},
+                        std::move(node)};
+  uut.warmup = false;
+  uut.channels[0].warmup = false;
+  uut.begin_phase();
+  return uut;
+}
+} // namespace
+
+SCENARIO("Memory controllers that share an upper level each serve their own addresses")
+{
+  GIVEN("Two controllers of one tier")
+  {
+    champsim::channel ul{32, 32, 32, champsim::data::bits{LOG2_BLOCK_SIZE}, false};
+    auto first = make_controller(&ul, dram_node{"A", champsim::address{}, champsim::address{std::numeric_limits<uint64_t>::max()}, 0, 2, 0});
+    auto second = make_controller(&ul, dram_node{"B", champsim::address{}, champsim::address{std::numeric_limits<uint64_t>::max()}, 1, 2, 0});
+
+    const champsim::address low_addr{0x1000};
+    const champsim::address high_addr{static_cast<uint64_t>(first.size().count()) + 0x1000};
+
+    THEN("The controllers split their range")
+    {
+      REQUIRE(first.address_range() == second.address_range());
+      REQUIRE(first.owns(low_addr));
+      REQUIRE_FALSE(first.owns(high_addr));
+      REQUIRE(second.owns(high_addr));
+      REQUIRE_FALSE(second.owns(low_addr));
+    }
+
+    WHEN("A read to each half arrives")
+    {
+      for (auto addr : {low_addr, high_addr}) {
+        champsim::channel::request_type read;
+        read.address = addr;
+        read.response_requested = true;
+        ul.add_rq(read);
+      }
+
+      for (int cycle = 0; cycle < 10000 && std::size(ul.returned) < 2; ++cycle) {
+        first._operate();
+        second._operate();
+      }
+      first.end_phase(0);
+      second.end_phase(0);
+
+      THEN("Both reads are returned") { REQUIRE_THAT(ul.returned, Catch::Matchers::SizeIs(2)); }
+
+      THEN("Each controller serves one read")
+      {
+        REQUIRE(first.channels[0].roi_stats.RD == 1);
+        REQUIRE(second.channels[0].roi_stats.RD == 1);
+      }
+    }
+  }
+}
+
+SCENARIO("A memory controller in a slower tier adds latency to each request")
+{
+  GIVEN("A controller with no added latency and one with some")
+  {
+    constexpr std::size_t extra_latency = 100;
+    champsim::channel near_ul{32, 32, 32, champsim::data::bits{LOG2_BLOCK_SIZE}, false};
+    champsim::channel far_ul{32, 32, 32, champsim::data::bits{LOG2_BLOCK_SIZE}, false};
+    auto near_mc = make_controller(&near_ul, dram_node{});
+    auto far_mc = make_controller(&far_ul, dram_node{"FAR", champsim::address{}, champsim::address{std::numeric_limits<uint64_t>::max()}, 0, 1, extra_latency});
+
+    WHEN("Each receives the same read")
+    {
+      std::array<long, 2> cycles{};
+      for (auto [mc, ul, count] : {std::tuple{&near_mc, &near_ul, &cycles[0]}, std::tuple{&far_mc, &far_ul, &cycles[1]}}) {
+        champsim::channel::request_type read;
+        read.address = champsim::address{0x1000};
+        read.response_requested = true;
+        ul->add_rq(read);
+        for (; *count < 10000 && std::empty(ul->returned); ++(*count)) {
+          mc->_operate();
+        }
+      }
+
+      THEN("The slower controller returns it later by at least the added latency")
+      {
+        REQUIRE(near_ul.returned.size() == 1);
+        REQUIRE(far_ul.returned.size() == 1);
+        REQUIRE(cycles[1] >= cycles[0] + static_cast<long>(extra_latency));
+      }
+    }
+  }
+}
@@ -0,0 +1,170 @@
+#include <catch.hpp>
+
+#include "dram_controller.h"
+
+namespace
+{
+DRAM_CHANNEL make_channel(dram_refresh_policy refresh)
+{
+  const auto clock_period = champsim::chrono::picoseconds{3200};
+  DRAM_ADDRESS_MAPPING mapper{champsim::data::bytes{8}, 8, 1, 8, 4, 1024, 1, 65536};
+  DRAM_CHANNEL chan{clock_period,
+                    clock_period * 2,
+                    24,
+                    24,
+                    24,
+                    52,
+                    champsim::chrono::microseconds{64000},
+                    1024,
+                    champsim::data::bytes{8},
+                    64,
+                    64,
+                    mapper,
+                    dram_power_parameters{},
+                    dram_page_policy{},
+                    refresh};
+  chan.warmup = false;
+  return chan;
+}
+
+void add_read(DRAM_CHANNEL& chan, std::size_t slot, champsim::address addr)
+{
+  champsim::channel::request_type packet;
+  packet.address = addr;
+  chan.RQ.at(slot) = DRAM_CHANNEL::request_type{packet};
+  chan.RQ.at(slot)->ready_time = chan.current_time;
+  chan.check_read_collision();
+}
+} // namespace
+
+SCENARIO("Banks can be refreshed a few at a time")
+{
+  auto mode = GENERATE(dram_refresh_policy::mode::per_bank, dram_refresh_policy::mode::same_bank);
+  GIVEN("An idle channel that refreshes " + std::string{mode == dram_refresh_policy::mode::per_bank ? "one bank" : "one bank per bankgroup"} + " at a time")
+  {
+    auto chan = make_channel(dram_refresh_policy{mode, 0, 0});
+    const auto banks = chan.address_mapping.banks();
+    const auto bankgroups = chan.address_mapping.bankgroups();
+
+    WHEN("The channel runs for a refresh period")
+    {
+      std::vector<bool> refreshed(std::size(chan.bank_request), false);
+      bool banks_match = true;
+      std::size_t most_under_refresh = 0;
+      while (chan.current_time < champsim::chrono::clock::time_point{} + chan.tREF + chan.tRFC) {
+        chan._operate();
+
+        std::vector<std::size_t> under_refresh;
+        for (std::size_t i = 0; i < std::size(chan.bank_request); ++i) {
+          if (chan.bank_request[i].under_refresh) {
+            refreshed[i] = true;
+            under_refresh.push_back(i);
+          }
+        }
+        most_under_refresh = std::max(most_under_refresh, std::size(under_refresh));
+        banks_match = banks_match
+                      && std::all_of(std::begin(under_refresh), std::end(under_refresh), [&](auto i) { return i % banks == under_refresh.front() % banks; });
+      }
+
+      THEN("Every bank is refreshed") { REQUIRE(std::all_of(std::begin(refreshed), std::end(refreshed), [](bool x) { return x; })); }
+
+      THEN("Only one group of banks is refreshed at once")
+      {
+        REQUIRE(most_under_refresh == (mode == dram_refresh_policy::mode::per_bank ? 1 : bankgroups));
+        REQUIRE(banks_match);
+      }
+    }
+  }
+}
+
+SCENARIO("A refresh is postponed while its bank has requests waiting")
+{
+  GIVEN("A channel that may postpone up to four refreshes, with a read waiting for the first bank")
+  {
+    constexpr std::size_t max_postponed = 4;
+    auto chan = make_channel(dram_refresh_policy{dram_refresh_policy::mode::per_bank, max_postponed, 0});
+    add_read(chan, 0, champsim::address{0x1000});
+    const auto bank = chan.RQ.at(0)->bank_index;
+
+    WHEN("A refresh is due for the bank")
+    {
+      chan.bank_request[bank].refresh_debt = 1;
+      chan.schedule_refresh();
+
+      THEN("The refresh is postponed") { REQUIRE_FALSE(chan.bank_request[bank].under_refresh); }
+    }
+
+    WHEN("The bank has postponed as many refreshes as it may")
+    {
+      chan.bank_request[bank].refresh_debt = max_postponed + 1;
+      chan.schedule_refresh();
+
+      THEN("The refresh is issued") { REQUIRE(chan.bank_request[bank].under_refresh); }
+
+      AND_WHEN("The bank is still being refreshed a cycle later")
+      {
+        chan.current_time += chan.clock_period;
+        chan.schedule_refresh();
+
+        THEN("Each cycle that the ready read waits is counted") { REQUIRE(chan.sim_stats.refresh_stall_cycles == 2); }
+      }
+    }
+  }
+}
+
+SCENARIO("An idle bank may pull in refreshes")
+{
+  GIVEN("A channel that may pull in up to two refreshes")
+  {
+    constexpr std::size_t max_pulled_in = 2;
+    auto chan = make_channel(dram_refresh_policy{dram_refresh_policy::mode::per_bank, 0, max_pulled_in});
+
+    WHEN("The banks are idle")
+    {
+      // The first refresh interval has not passed, so no refresh is due
+      chan.schedule_refresh();
+
+      THEN("Every bank pulls in a refresh")
+      {
+        REQUIRE(std::all_of(std::begin(chan.bank_request), std::end(chan.bank_request), [](const auto& b) { return b.under_refresh && b.refresh_debt == -1; }));
+      }
+    }
+
+    WHEN("A bank has pulled in as many refreshes as it may")
+    {
+      chan.bank_request[0].refresh_debt = -static_cast<long>(max_pulled_in);
+      chan.schedule_refresh();
+
+      THEN("It does not pull in another") { REQUIRE_FALSE(chan.bank_request[0].under_refresh); }
+    }
+  }
+}
+
+SCENARIO("The duration of a per-bank refresh can be given")
+{
+  GIVEN("A channel that refreshes one bank at a time with the default duration")
+  {
+    auto chan = make_channel(dram_refresh_policy{dram_refresh_policy::mode::per_bank, 0, 0});
+
+    WHEN("A refresh is issued")
+    {
+      chan.bank_request[0].refresh_debt = 1;
+      chan.schedule_refresh();
+
+      THEN("It takes half as long as an all-bank refresh") { REQUIRE(chan.bank_request[0].ready_time == chan.current_time + chan.tRFC / 2); }
+    }
+  }
+
+  GIVEN("A channel that refreshes one bank at a time in 100 cycles")
+  {
+    auto chan = make_channel(dram_refresh_policy{dram_refresh_policy::mode::per_bank, 0, 0, 100});
+
+    WHEN("A refresh is issued")
+    {
+      chan.bank_request[0].refresh_debt = 1;
+      chan.schedule_refresh();
+
+      THEN("It takes the given number of cycles") { REQUIRE(chan.bank_request[0].ready_time == chan.current_time + 100 * chan.clock_period); }
+    }
+  }
+}
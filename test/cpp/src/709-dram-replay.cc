@@ -0,0 +1,127 @@
+#include <catch.hpp>
+
+#include <sstream>
+
+#include "dram_replay.h"
+
+namespace
+{
+struct dram_only_environment final : public champsim::environment {
+  champsim::channel upper_level{32, 32, 32, champsim::data::bits{LOG2_BLOCK_SIZE}, false};
+  MEMORY_CONTROLLER dram{champsim::chrono::picoseconds{3200},
+                         champsim::chrono::picoseconds{6400},
+                         24,
+                         24,
+                         24,
+                         52,
+                         champsim::chrono::microseconds{64000},
+                         {&upper_level},
+                         64,
+                         64,
+                         1,
+                         champsim::data::bytes{8},
+                         65536,
+                         1024,
+                         1,
+                         8,
+                         4,
+                         8192};
+
+  std::vector<std::reference_wrapper<O3_CPU>> cpu_view() final { return {}; }
+  std::vector<std::reference_wrapper<CACHE>> cache_view() final { return {}; }
+  std::vector<std::reference_wrapper<PageTableWalker>> ptw_view() final { return {}; }
+  std::vector<std::reference_wrapper<MEMORY_CONTROLLER>> dram_view() final { return {std::ref(dram)}; }
+  std::vector<std::reference_wrapper<champsim::operable>> operable_view() final { return {std::ref(dram)}; }
+};
+} // namespace
+
+SCENARIO("Memory trace records can be parsed and formatted")
+{
+  GIVEN("A well-formed record")
+  {
+    const std::string line{"120 1 W 0xdeadbe40"};
+
+    THEN("It parses to its fields")
+    {
+      auto record = champsim::parse_dram_trace_record(line);
+      REQUIRE(record.has_value());
+      REQUIRE(record->cycle == 120);
+      REQUIRE(record->cpu == 1);
+      REQUIRE(record->is_write);
+      REQUIRE(record->address == champsim::address{0xdeadbe40});
+    }
+
+    THEN("Formatting the parsed record gives back the line")
+    {
+      REQUIRE(champsim::format_dram_trace_record(champsim::parse_dram_trace_record(line).value()) == line);
+    }
+  }
+
+  GIVEN("Blank and comment lines")
+  {
+    THEN("They carry no record")
+    {
+      REQUIRE_FALSE(champsim::parse_dram_trace_record("").has_value());
+      REQUIRE_FALSE(champsim::parse_dram_trace_record("   ").has_value());
+      REQUIRE_FALSE(champsim::parse_dram_trace_record("# cycle cpu type address").has_value());
+    }
+  }
+
+  GIVEN("Malformed lines")
+  {
+    THEN("They are rejected")
+    {
+      REQUIRE_THROWS_AS(champsim::parse_dram_trace_record("120 0 R"), std::invalid_argument);
+      REQUIRE_THROWS_AS(champsim::parse_dram_trace_record("120 0 X 0x40"), std::invalid_argument);
+      REQUIRE_THROWS_AS(champsim::parse_dram_trace_record("120 0 R 0x40 extra"), std::invalid_argument);
+      REQUIRE_THROWS_AS(champsim::parse_dram_trace_record("-1 0 R 0x40"), std::invalid_argument);
+      REQUIRE_THROWS_AS(champsim::parse_dram_trace_record("12z 0 R 0x40"), std::invalid_argument);
+    }
+  }
+}
+
+SCENARIO("A memory trace can be replayed into a memory controller alone")
+{
+  GIVEN("A memory controller with no cores or caches")
+  {
+    dram_only_environment env;
+
+    WHEN("A trace of reads and writes is replayed")
+    {
+      std::istringstream trace{"# a short trace\n"
+                               "1000 0 R 0x1000\n"
+                               "1000 0 R 0x1040\n"
+                               "1010 0 W 0x80000\n"
+                               "1500 0 R 0x100000\n"};
+      auto stats = champsim::replay_dram_trace(env, trace);
+
+      THEN("Every request is served by the controller")
+      {
+        REQUIRE(stats.name == "DRAM replay");
+        REQUIRE(std::size(stats.roi_dram_stats) == 1);
+        const auto& chan_stats = stats.roi_dram_stats.front();
+        REQUIRE(chan_stats.RD == 3);
+        REQUIRE(chan_stats.WR == 1);
+        REQUIRE(chan_stats.RQ_ROW_BUFFER_HIT + chan_stats.RQ_ROW_BUFFER_MISS == 3);
+        REQUIRE(chan_stats.WQ_ROW_BUFFER_HIT + chan_stats.WQ_ROW_BUFFER_MISS == 1);
+      }
+
+      THEN("The controller is drained when the replay finishes")
+      {
+        REQUIRE(std::empty(env.upper_level.RQ));
+        REQUIRE(std::empty(env.upper_level.WQ));
+        REQUIRE(std::empty(env.upper_level.returned));
+      }
+    }
+
+    WHEN("A malformed trace is replayed")
+    {
+      std::istringstream trace{"1000 0 R 0x1000\nnot a record\n"};
+
+      THEN("The replay is rejected")
+      {
+        REQUIRE_THROWS_AS(champsim::replay_dram_trace(env, trace), std::invalid_argument);
+      }
+    }
+  }
+}
@@ -0,0 +1,61 @@
+#include <catch.hpp>
+#include <fmt/core.h>
+#include <stdexcept>
+
+#include "dram_controller.h"
+
+namespace
+{
+constexpr std::size_t rows = 8;
+constexpr std::size_t columns = 128;
+constexpr std::size_t ranks = 2;
+constexpr std::size_t bankgroups = 4;
+constexpr std::size_t banks = 4;
+constexpr std::size_t prefetch_size = 8;
+constexpr std::size_t offset_bits = 3 + champsim::lg2(prefetch_size);
+} // namespace
+
+TEST_CASE("A DRAM address layout can place the row below the other fields")
+{
+  using field = dram_address_layout::field;
+  dram_address_layout layout{{field::row, field::column, field::rank, field::bank, field::bankgroup, field::channel, field::controller}, false};
+  auto uut = DRAM_ADDRESS_MAPPING(champsim::data::bytes{8}, prefetch_size, 1, bankgroups, banks, columns, ranks, rows, layout);
+
+  auto row = rows - 1;
+  auto bankgroup = bankgroups - 1;
+  champsim::address addr{(row << offset_bits)
+                         | (bankgroup << (offset_bits + champsim::lg2(rows) + champsim::lg2(columns / prefetch_size) + champsim::lg2(ranks)
+                                          + champsim::lg2(banks)))};
+
+  INFO(fmt::format("address: {}", addr));
+  REQUIRE(uut.get_row(addr) == row);
+  REQUIRE(uut.get_bankgroup(addr) == bankgroup);
+  REQUIRE(uut.get_bank(addr) == 0);
+  REQUIRE(uut.get_column(addr) == 0);
+  REQUIRE(uut.get_rank(addr) == 0);
+  REQUIRE(uut.rows() == rows);
+  REQUIRE(uut.columns() == columns);
+}
+
+TEST_CASE("The bank index is hashed with the row only if the layout asks for it")
+{
+  auto swizzle = GENERATE(true, false);
+  dram_address_layout layout{};
+  layout.swizzle = swizzle;
+  auto uut = DRAM_ADDRESS_MAPPING(champsim::data::bytes{8}, prefetch_size, 1, bankgroups, banks, columns, ranks, rows, layout);
+
+  // The row is the most significant field by default, so this address has a bank index of 0 and a row of 1
+  champsim::address addr{1ull << (offset_bits + champsim::lg2(bankgroups) + champsim::lg2(banks) + champsim::lg2(columns / prefetch_size)
+                                  + champsim::lg2(ranks))};
+
+  INFO(fmt::format("address: {} swizzle: {}", addr, swizzle));
+  REQUIRE(uut.get_row(addr) == 1);
+  REQUIRE((uut.get_bankgroup(addr) != 0) == swizzle);
+}
+
+TEST_CASE("A DRAM address layout must name each field once")
+{
+  using field = dram_address_layout::field;
+  dram_address_layout layout{{field::row, field::row, field::rank, field::bank, field::bankgroup, field::channel, field::controller}, true};
+  REQUIRE_THROWS_AS(DRAM_ADDRESS_MAPPING(champsim::data::bytes{8}, prefetch_size, 1, bankgroups, banks, columns, ranks, rows, layout), std::invalid_argument);
+}
@@ -0,0 +1,56 @@
+#include <catch.hpp>
+
+#include "dram_controller.h"
+#include "vmem.h"
+
+namespace
+{
+MEMORY_CONTROLLER make_controller(dram_node node)
+{
+  return MEMORY_CONTROLLER{champsim::chrono::picoseconds{3200},
+                           champsim::chrono::picoseconds{6400},
+                           std::size_t{18},
+                           std::size_t{18},
+                           std::size_t{18},
+                           std::size_t{38},
+                           champsim::chrono::microseconds{64000},
+                           {},
+                           64,
+                           64,
+                           1,
+                           champsim::data::bytes{8},
+                           1024,
+                           1024,
+                           4,
+                           4,
+                           4,
+                           8192,
+                           dram_power_parameters{},
+                           dram_page_policy{},
+                           dram_address_layout{},
+                           std::move(node)};
+}
+} // namespace
+
+TEST_CASE("The virtual memory allocates pages from every memory tier")
+{
+  auto near_mc = make_controller(dram_node{});
+  const auto tier_size = static_cast<uint64_t>(near_mc.size().count());
+  auto far_mc = make_controller(dram_node{"FAR", champsim::address{tier_size}, champsim::address{std::numeric_limits<uint64_t>::max()}, 0, 1, 0});
+  REQUIRE(far_mc.address_range().first == champsim::address{tier_size});
+
+  VirtualMemory single{champsim::data::bytes{1 << 12}, 5, champsim::chrono::nanoseconds{6400}, near_mc};
+  VirtualMemory uut{champsim::data::bytes{1 << 12}, 5, champsim::chrono::nanoseconds{6400}, {std::ref(near_mc), std::ref(far_mc)}, {}};
+
+  REQUIRE(uut.available_ppages() == single.available_ppages() + tier_size / PAGE_SIZE);
+}
+
+TEST_CASE("The virtual memory allocates the range of a tier of controllers once")
+{
+  auto first = make_controller(dram_node{"A", champsim::address{}, champsim::address{std::numeric_limits<uint64_t>::max()}, 0, 2, 0});
+  auto second = make_controller(dram_node{"B", champsim::address{}, champsim::address{std::numeric_limits<uint64_t>::max()}, 1, 2, 0});
+
+  VirtualMemory uut{champsim::data::bytes{1 << 12}, 5, champsim::chrono::nanoseconds{6400}, {std::ref(first), std::ref(second)}, {}};
+
+  REQUIRE(uut.available_ppages() == (2 * first.size().count() - (1ull << 20)) / PAGE_SIZE);
+}
@@ -16,6 +16,62 @@ class VectorStringTest(unittest.TestCase):
     def test_list_with_two(self):
         self.assertEqual(config.instantiation_file.vector_string(['a','b']), '{a, b}');
 
+class DramAddressOrderTest(unittest.TestCase):
+
+    def test_string_is_reversed(self):
+        self.assertEqual(config.instantiation_file.dram_address_order('row:rank:column:bank:bankgroup:channel'),
+            'dram_address_layout::field::channel, dram_address_layout::field::controller, dram_address_layout::field::bankgroup, dram_address_layout::field::bank, dram_address_layout::field::column, dram_address_layout::field::rank, dram_address_layout::field::row')
+
+    def test_node_interleave_places_controller_last(self):
+        self.assertTrue(config.instantiation_file.dram_address_order('row:rank:column:bank:bankgroup:channel', 'node').endswith('dram_address_layout::field::row, dram_address_layout::field::controller'))
+
+    def test_explicit_controller_is_kept(self):
+        self.assertTrue(config.instantiation_file.dram_address_order('row:rank:column:bank:bankgroup:controller:channel', 'node').startswith('dram_address_layout::field::channel, dram_address_layout::field::controller,'))
+
+    def test_list_matches_string(self):
+        order = ['channel', 'row', 'rank', 'column', 'bank', 'bankgroup']
+        self.assertEqual(config.instantiation_file.dram_address_order(order), config.instantiation_file.dram_address_order(':'.join(order)))
+
+    def test_missing_field_raises(self):
+        with self.assertRaises(ValueError):
+            config.instantiation_file.dram_address_order('row:rank:column:bank:channel')
+
+    def test_repeated_field_raises(self):
+        with self.assertRaises(ValueError):
+            config.instantiation_file.dram_address_order('row:row:column:bank:bankgroup:channel')
+
+class GetMemoryNodesTest(unittest.TestCase):
+
+    def make_pmem(self, **kwargs):
+        return {'name': 'DRAM', 'channels': 1, 'ranks': 1, 'bankgroups': 1, 'banks': 1, 'bank_rows': 1024, 'bank_columns': 128, 'channel_width': 8, 'controllers': 1, 'interleave': 'striped', **kwargs}
+
+    def test_single_controller(self):
+        nodes = config.instantiation_file.get_memory_nodes(self.make_pmem())
+        self.assertEqual([n['name'] for n in nodes], ['DRAM'])
+        self.assertEqual(nodes[0]['_node_base'], 0)
+        self.assertEqual(nodes[0]['_node_last'], (1 << 64) - 1)
+
+    def test_controllers_are_named_and_indexed(self):
+        nodes = config.instantiation_file.get_memory_nodes(self.make_pmem(controllers=4))
+        self.assertEqual([n['name'] for n in nodes], ['DRAM', 'DRAM_1', 'DRAM_2', 'DRAM_3'])
+        self.assertEqual([n['_node_index'] for n in nodes], [0, 1, 2, 3])
+        self.assertTrue(all(n['_node_count'] == 4 for n in nodes))
+
+    def test_far_memory_follows_near_memory(self):
+        pmem = self.make_pmem(controllers=2)
+        far_pmem = self.make_pmem(name='FAR_DRAM', bank_rows=4096)
+        nodes = config.instantiation_file.get_memory_nodes(pmem, far_pmem)
+        near_size = 2 * config.instantiation_file.dram_size(pmem)
+        far_size = config.instantiation_file.dram_size(far_pmem)
+        self.assertEqual([n['name'] for n in nodes], ['DRAM', 'DRAM_1', 'FAR_DRAM'])
+        self.assertEqual(nodes[0]['_node_last'], far_size - 1)
+        self.assertEqual(nodes[2]['_node_base'] % far_size, 0)
+        self.assertGreaterEqual(nodes[2]['_node_base'], near_size)
+
+    def test_controllers_must_be_power_of_two(self):
+        with self.assertRaises(ValueError):
+            config.instantiation_file.get_memory_nodes(self.make_pmem(controllers=3))
+
 class CpuBuilderTest(unittest.TestCase):
 
     def get_element_diff(self, added_lines, **kwargs):
@@ -86,6 +142,19 @@ class CpuBuilderTest(unittest.TestCase):
     def test_execute_latency(self):
         self.get_element_diff(['.execute_latency(1)'], execute_latency=1)
 
+    def test_ftq_size(self):
+        self.get_element_diff(['.ftq_size(1)'], ftq_size=1)
+
+    def test_functional_unit_latency(self):
+        self.get_element_diff(['.execute_latency(champsim::op_class::fp, 4)'], functional_units={ 'fp': { 'latency': 4 } })
+
+    def test_functional_unit_count(self):
+        self.get_element_diff(['.functional_units(champsim::op_class::fp, 2, true)'], functional_units={ 'fp': { 'count': 2 } })
+
+    def test_unpipelined_functional_unit(self):
+        self.get_element_diff(['.execute_latency(champsim::op_class::slow_alu, 12)', '.functional_units(champsim::op_class::slow_alu, 1, false)'],
+            functional_units={ 'slow_alu': { 'latency': 12, 'count': 1, 'pipelined': False } })
+
     def test_dib_set(self):
         self.get_element_diff(['.dib_set(1)'], dib_set=1)
 
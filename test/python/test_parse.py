@@ -192,7 +192,7 @@ class ParseNormalizedTests(unittest.TestCase):
 
         for key in ('L1I', 'L1D', 'ITLB', 'DTLB'):
             with self.subTest(cache=key):
-                result = test_config.apply_defaults_in(PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext())
+                result = test_config.apply_defaults_in(PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext())
                 cache_name = result[0]['cores'][0][key]
                 caches = result[0]['caches']
 
@@ -201,7 +201,7 @@ class ParseNormalizedTests(unittest.TestCase):
     def test_generates_default_ptws(self):
         test_config = config.parse.NormalizedConfiguration({ 'ooo_cpu': [{ 'name': 'test_cpu' }] })
 
-        result = test_config.apply_defaults_in(PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext())
+        result = test_config.apply_defaults_in(PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext())
         ptw_name = result[0]['cores'][0]['PTW']
         ptws = result[0]['ptws']
 
@@ -212,7 +212,7 @@ class ParseNormalizedTests(unittest.TestCase):
             with self.subTest(num_cores=num_cores):
                 test_config = config.parse.NormalizedConfiguration({ 'ooo_cpu': [{ 'name': 'test_cpu'+str(i) } for i in range(num_cores)] })
 
-                result = test_config.apply_defaults_in(PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext())
+                result = test_config.apply_defaults_in(PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext())
                 cache_names = [core['L1I'] for core in result[0]['cores']]
                 caches = result[0]['caches']
 
@@ -225,7 +225,7 @@ class ParseNormalizedTests(unittest.TestCase):
             with self.subTest(num_cores=num_cores):
                 test_config = config.parse.NormalizedConfiguration({ 'ooo_cpu': [{ 'name': 'test_cpu'+str(i) } for i in range(num_cores)] })
 
-                result = test_config.apply_defaults_in(PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext())
+                result = test_config.apply_defaults_in(PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext())
                 cache_names = [core['L1I'] for core in result[0]['cores']] + [core['L1D'] for core in result[0]['cores']]
                 caches = result[0]['caches']
 
@@ -239,7 +239,7 @@ class ParseNormalizedTests(unittest.TestCase):
             with self.subTest(ptw=name, num_cores=num_cores):
                 test_config = config.parse.NormalizedConfiguration({ 'ooo_cpu': [{ 'name': 'test_cpu'+str(i) } for i in range(num_cores)] })
 
-                result = test_config.apply_defaults_in(PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext())
+                result = test_config.apply_defaults_in(PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext())
                 cache_names = [c['name'] for c in result[0]['caches']]
                 ll_names = [c.get('lower_level') for c in result[0]['caches']]
 
@@ -257,7 +257,7 @@ class ParseNormalizedTests(unittest.TestCase):
             with self.subTest(ptw=name, num_cores=num_cores):
                 test_config = config.parse.NormalizedConfiguration({ 'ooo_cpu': [{ 'name': 'test_cpu'+str(i) } for i in range(num_cores)] })
 
-                result = test_config.apply_defaults_in(PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext())
+                result = test_config.apply_defaults_in(PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext())
                 cache_names = [c['name'] for c in result[0]['caches']]
                 ptw_names = [c['name'] for c in result[0]['ptws']]
                 ll_names = [c.get('lower_level') for c in result[0]['caches']]
@@ -276,7 +276,7 @@ class ParseNormalizedTests(unittest.TestCase):
             with self.subTest(num_cores=num_cores):
                 test_config = config.parse.NormalizedConfiguration({ 'ooo_cpu': [{ 'name': 'test_cpu'+str(i) } for i in range(num_cores)] })
 
-                result = test_config.apply_defaults_in(PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext())
+                result = test_config.apply_defaults_in(PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext())
                 cache_names = [core['ITLB'] for core in result[0]['cores']] + [core['DTLB'] for core in result[0]['cores']]
                 caches = result[0]['caches']
 
@@ -290,7 +290,7 @@ class ParseNormalizedTests(unittest.TestCase):
             with self.subTest(num_cores=num_cores):
                 test_config = config.parse.NormalizedConfiguration({ 'ooo_cpu': [{ 'name': 'test_cpu'+str(i), 'frequency': random.randrange(20162016) } for i in range(num_cores)] })
 
-                result = test_config.apply_defaults_in(PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext())
+                result = test_config.apply_defaults_in(PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext())
                 for name in ('L1I', 'L1D', 'ITLB', 'DTLB'):
                     cache_names_and_frequencies = [(core[name], core['frequency']) for core in result[0]['cores']]
                     caches = result[0]['caches']
@@ -304,7 +304,7 @@ class ParseNormalizedTests(unittest.TestCase):
             with self.subTest(num_cores=num_cores, module_key=module_key):
                 test_config = config.parse.NormalizedConfiguration({ 'ooo_cpu': [{ 'name': 'test_cpu'+str(i) } for i in range(num_cores)] })
 
-                result = test_config.apply_defaults_in(PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext())
+                result = test_config.apply_defaults_in(PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext())
                 cores = result[0]['cores']
 
                 module_names = [c.get(module_key) for c in cores]
@@ -315,7 +315,7 @@ class ParseNormalizedTests(unittest.TestCase):
             with self.subTest(num_cores=num_cores, module_key=module_key):
                 test_config = config.parse.NormalizedConfiguration({ 'ooo_cpu': [{ 'name': 'test_cpu'+str(i) } for i in range(num_cores)] })
 
-                result = test_config.apply_defaults_in(PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext())
+                result = test_config.apply_defaults_in(PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext())
                 caches = result[0]['caches']
 
                 module_names = [c.get(module_key) for c in caches]
@@ -417,7 +417,7 @@ class NormalizeConfigTest(unittest.TestCase):
         self.assertEqual(result.vmem.get('__test__'), True)
 
     def test_core_params_are_moved_to_core_array(self):
-        core_keys_to_copy = ('frequency', 'ifetch_buffer_size', 'decode_buffer_size', 'dispatch_buffer_size', 'register_file_size', 'rob_size', 'lq_size', 'sq_size', 'fetch_width', 'decode_width', 'dispatch_width', 'execute_width', 'lq_width', 'sq_width', 'retire_width', 'mispredict_penalty', 'scheduler_size', 'decode_latency', 'dispatch_latency', 'schedule_latency', 'execute_latency', 'branch_predictor', 'btb', 'DIB')
+        core_keys_to_copy = ('frequency', 'ifetch_buffer_size', 'decode_buffer_size', 'dispatch_buffer_size', 'register_file_size', 'rob_size', 'lq_size', 'sq_size', 'fetch_width', 'decode_width', 'dispatch_width', 'execute_width', 'lq_width', 'sq_width', 'retire_width', 'mispredict_penalty', 'scheduler_size', 'decode_latency', 'dispatch_latency', 'schedule_latency', 'execute_latency', 'functional_units', 'ftq_size', 'branch_predictor', 'btb', 'DIB')
         for k in core_keys_to_copy:
             with self.subTest(key=k):
                 result = config.parse.NormalizedConfiguration({ k: '__test__' })
@@ -680,7 +680,7 @@ class ConfigRootPassthroughParseTests(unittest.TestCase):
         test_config = config.parse.NormalizedConfiguration({
             'block_size': 27
         })
-        result = test_config.apply_defaults_in(PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext())
+        result = test_config.apply_defaults_in(PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext())
         self.assertIn('block_size', result[2])
         self.assertEqual(test_config.root.get('block_size'), result[2].get('block_size'))
 
@@ -688,7 +688,7 @@ class ConfigRootPassthroughParseTests(unittest.TestCase):
         test_config = config.parse.NormalizedConfiguration({
             'page_size': 27
         })
-        result = test_config.apply_defaults_in(PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext())
+        result = test_config.apply_defaults_in(PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext())
         self.assertIn('page_size', result[2])
         self.assertEqual(test_config.root.get('page_size'), result[2].get('page_size'))
 
@@ -696,7 +696,7 @@ class ConfigRootPassthroughParseTests(unittest.TestCase):
         test_config = config.parse.NormalizedConfiguration({
             'heartbeat_frequency': 27
         })
-        result = test_config.apply_defaults_in(PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext())
+        result = test_config.apply_defaults_in(PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext())
         self.assertIn('heartbeat_frequency', result[2])
         self.assertEqual(test_config.root.get('heartbeat_frequency'), result[2].get('heartbeat_frequency'))
 
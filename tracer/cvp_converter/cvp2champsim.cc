@@ -39,9 +39,10 @@
 #endif
 
 bool verbose = false;
+bool write_op_class = false;
 
-// use non-cloudsuite ChampSim trace format
-using trace_instr_format = input_instr;
+// use non-cloudsuite ChampSim trace format, which is a prefix of the format with op classes
+using trace_instr_format = op_class_instr;
 
 // orginal instruction types from CVP-1 traces
 
@@ -209,6 +210,31 @@ struct trace {
 
 bool is_branch(InstClass t) { return (t == uncondIndirectBranchInstClass || t == uncondDirectBranchInstClass || t == condBranchInstClass); }
 
+champsim::op_class op_class_of(InstClass t)
+{
+  switch (t) {
+  case aluInstClass:
+    return champsim::op_class::alu;
+  case loadInstClass:
+    return champsim::op_class::load;
+  case storeInstClass:
+    return champsim::op_class::store;
+  case condBranchInstClass:
+  case uncondDirectBranchInstClass:
+  case uncondIndirectBranchInstClass:
+    return champsim::op_class::branch;
+  case fpInstClass:
+    return champsim::op_class::fp;
+  case slowAluInstClass:
+    return champsim::op_class::slow_alu;
+  default:
+    return champsim::op_class::unknown;
+  }
+}
+
+// write a record in the chosen format
+void write_record(const trace_instr_format& ct) { fwrite(&ct, write_op_class ? sizeof(op_class_instr) : sizeof(input_instr), 1, stdout); }
+
 std::map<UINT64, bool> code_pages, data_pages;
 std::map<UINT64, UINT64> remapped_pages;
 UINT64 bump_page = 0x1000;
@@ -364,6 +390,8 @@ int main(int argc, char** argv)
   for (int i = 1; i < argc; i++) {
     if (!strcmp(argv[i], "-v"))
       verbose = true;
+    else if (!strcmp(argv[i], "-o"))
+      write_op_class = true;
     else
       strcpy(tracefilename, argv[i]);
   }
@@ -410,8 +438,9 @@ int main(int argc, char** argv)
 
     if (!good)
       break;
-    trace_instr_format ct;
+    trace_instr_format ct{};
     ct.ip = t.PC;
+    ct.op_class = static_cast<unsigned char>(op_class_of(t.type));
     ct.is_branch = false;
     // we are going to figure out the op type
 
@@ -518,7 +547,7 @@ int main(int argc, char** argv)
       default:
         assert(0);
       }
-      fwrite(&ct, sizeof(ct), 1, stdout); // write a branch trace
+      write_record(ct); // write a branch trace
     } else {
       memset(ct.destination_registers, 0, sizeof(ct.destination_registers));
       memset(ct.source_registers, 0, sizeof(ct.source_registers));
@@ -572,7 +601,7 @@ int main(int argc, char** argv)
         case undefInstClass:
           assert(0);
         }
-        fwrite(&ct, sizeof(ct), 1, stdout); // write a non-branch trace
+        write_record(ct); // write a non-branch trace
       }
     }
 
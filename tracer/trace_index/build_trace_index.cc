@@ -0,0 +1,55 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <CLI/CLI.hpp>
+#include <fmt/core.h>
+
+#include "trace_index.h"
+#include "trace_instruction.h"
+
+int main(int argc, char** argv)
+{
+  CLI::App app{"Build the indices that let ChampSim begin partway through a compressed trace"};
+
+  bool knob_cloudsuite{false};
+  uint64_t interval = 1000000;
+  std::vector<std::string> trace_names;
+
+  app.add_flag("-c,--cloudsuite", knob_cloudsuite, "The traces are in the cloudsuite format");
+  app.add_option("--interval", interval, "The minimum number of instructions between restart points in gzip traces")->check(CLI::PositiveNumber);
+  app.add_option("traces", trace_names, "The paths to the traces")->required()->check(CLI::ExistingFile);
+
+  CLI11_PARSE(app, argc, argv);
+
+  const auto record_size = knob_cloudsuite ? sizeof(cloudsuite_instr) : sizeof(input_instr);
+  for (const auto& name : trace_names) {
+    try {
+      auto index = champsim::build_trace_index(name, interval * record_size);
+      std::ofstream index_file{champsim::trace_index_name(name)};
+      champsim::write_trace_index(index_file, index);
+      fmt::print("{}: {} restart points\n", champsim::trace_index_name(name), std::size(index.entries));
+    } catch (const std::runtime_error& err) {
+      fmt::print(stderr, "{}\n", err.what());
+      return 1;
+    }
+  }
+
+  return 0;
+}